@@ -2,6 +2,7 @@
 ARCH=$1
 rm -rf build/testDyn
 rm -rf build/testStat
+rm -rf build/benchmark
 mkdir -p build
 mkdir -p build/linux_$ARCH
 mkdir -p build/linux_$ARCH/logs
@@ -9,6 +10,7 @@ make arch=$ARCH dbg=1 clean -f makefile_test
 make arch=$ARCH dbg=1 -f makefile_test
 /bin/cp -rf build/testDyn build/linux_$ARCH/testDyn
 /bin/cp -rf build/testStat build/linux_$ARCH/testStat
+/bin/cp -rf build/benchmark build/linux_$ARCH/benchmark
 /bin/cp -rf settings.xml build/linux_$ARCH/settings.xml
 make arch=$ARCH dbg=1 clean -f makefile_test
 
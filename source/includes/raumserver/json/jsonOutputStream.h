@@ -0,0 +1,81 @@
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 by ChriD
+//
+// Permission is hereby granted, free of charge,  to any person obtaining a copy of
+// this software and  associated documentation  files  (the "Software"), to deal in
+// the  Software  without  restriction,  including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software,  and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this  permission notice  shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE  SOFTWARE  IS  PROVIDED  "AS IS",  WITHOUT  WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE  AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE  LIABLE FOR ANY CLAIM,  DAMAGES OR OTHER LIABILITY, WHETHER
+// IN  AN  ACTION  OF  CONTRACT,  TORT  OR  OTHERWISE,  ARISING  FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef RAUMSERVER_JSONOUTPUTSTREAM_H
+#define RAUMSERVER_JSONOUTPUTSTREAM_H
+
+#include <vector>
+#include <functional>
+
+namespace Raumserver
+{
+    typedef std::function<bool(const char* _data, std::size_t _length)> JsonOutputStreamSink;
+
+    /**
+    * A rapidjson output stream which collects the json in a buffer with a fixed size and passes the buffer to a sink (eg. a chunk of 
+    * a http response) each time it is full. So the memory which is needed for the json will not grow with its size.
+    * If the sink fails once, all further data will be dropped.
+    */
+    class JsonOutputStream
+    {
+        public:
+            typedef char Ch;
+
+            JsonOutputStream(JsonOutputStreamSink _sink, std::size_t _bufferSize = 16384)
+            {
+                sink = _sink;
+                buffer.resize(_bufferSize ? _bufferSize : 1);
+                bufferPos = 0;
+                failed = false;
+            }
+
+            void Put(Ch _c)
+            {
+                buffer[bufferPos++] = _c;
+                if (bufferPos == buffer.size())
+                    Flush();
+            }
+
+            void Flush()
+            {
+                if (bufferPos && !failed)
+                    failed = !sink(buffer.data(), bufferPos);
+                bufferPos = 0;
+            }
+
+            bool hasFailed()
+            {
+                return failed;
+            }
+
+        protected:
+            JsonOutputStreamSink sink;
+            std::vector<char> buffer;
+            std::size_t bufferPos;
+            bool failed;
+    };
+}
+
+
+#endif
@@ -32,11 +32,15 @@
 
 namespace Raumserver
 {
+    /**
+    * Adds the values of media items to a json writer. The writer may write to a string buffer or directly to an output stream
+    */
     class MediaItemJsonCreator
     {
         public:
 
-            static void addJson(std::shared_ptr<Raumkernel::Media::Item::MediaItem> _mediaItem, rapidjson::Writer<rapidjson::StringBuffer> &_jsonWriter)
+            template <typename JsonWriter>
+            static void addJson(std::shared_ptr<Raumkernel::Media::Item::MediaItem> _mediaItem, JsonWriter &_jsonWriter)
             {
                 addJsonForMediaItem(_mediaItem, _jsonWriter);                
                 if (std::dynamic_pointer_cast<Raumkernel::Media::Item::MediaItem_Container>(_mediaItem)) addJsonForMediaItem_Container(std::dynamic_pointer_cast<Raumkernel::Media::Item::MediaItem_Container>(_mediaItem), _jsonWriter);
@@ -49,28 +53,32 @@ namespace Raumserver
                 // we have to add more
             }
 
-            static void addJsonForMediaItem(std::shared_ptr<Raumkernel::Media::Item::MediaItem> _mediaItem, rapidjson::Writer<rapidjson::StringBuffer> &_jsonWriter)
+            template <typename JsonWriter>
+            static void addJsonForMediaItem(std::shared_ptr<Raumkernel::Media::Item::MediaItem> _mediaItem, JsonWriter &_jsonWriter)
             {
                 _jsonWriter.Key("id"); _jsonWriter.String(_mediaItem->id.c_str());
                 _jsonWriter.Key("parentId"); _jsonWriter.String(_mediaItem->parentId.c_str());                
                 _jsonWriter.Key("type"); _jsonWriter.String(Raumkernel::Media::Item::MediaItem::mediaItemTypeToString(_mediaItem->type).c_str());
             }
 
-            static void addJsonForMediaItem_Container(std::shared_ptr<Raumkernel::Media::Item::MediaItem_Container> _mediaItem, rapidjson::Writer<rapidjson::StringBuffer> &_jsonWriter)
+            template <typename JsonWriter>
+            static void addJsonForMediaItem_Container(std::shared_ptr<Raumkernel::Media::Item::MediaItem_Container> _mediaItem, JsonWriter &_jsonWriter)
             {                
                 _jsonWriter.Key("title"); _jsonWriter.String(_mediaItem->title.c_str());
                 _jsonWriter.Key("description"); _jsonWriter.String(_mediaItem->description.c_str());
             }
 
 
-            static void addJsonForMediaItem_Artist(std::shared_ptr<Raumkernel::Media::Item::MediaItem_Artist> _mediaItem, rapidjson::Writer<rapidjson::StringBuffer> &_jsonWriter)
+            template <typename JsonWriter>
+            static void addJsonForMediaItem_Artist(std::shared_ptr<Raumkernel::Media::Item::MediaItem_Artist> _mediaItem, JsonWriter &_jsonWriter)
             {
                 _jsonWriter.Key("artist"); _jsonWriter.String(_mediaItem->artist.c_str());
                 _jsonWriter.Key("artistArtUri"); _jsonWriter.String(_mediaItem->artistArtUri.c_str());                
             }
 
 
-            static void addJsonForMediaItem_Album(std::shared_ptr<Raumkernel::Media::Item::MediaItem_Album> _mediaItem, rapidjson::Writer<rapidjson::StringBuffer> &_jsonWriter)
+            template <typename JsonWriter>
+            static void addJsonForMediaItem_Album(std::shared_ptr<Raumkernel::Media::Item::MediaItem_Album> _mediaItem, JsonWriter &_jsonWriter)
             {
                 //addJsonForMediaItem_Artist(std::dynamic_pointer_cast<Raumkernel::Media::Item::MediaItem_Artist>(_mediaItem), _jsonWriter);
                 _jsonWriter.Key("album"); _jsonWriter.String(_mediaItem->album.c_str());
@@ -81,14 +89,16 @@ namespace Raumserver
             }
 
 
-            static void addJsonForMediaItem_Track(std::shared_ptr<Raumkernel::Media::Item::MediaItem_Track> _mediaItem, rapidjson::Writer<rapidjson::StringBuffer> &_jsonWriter)
+            template <typename JsonWriter>
+            static void addJsonForMediaItem_Track(std::shared_ptr<Raumkernel::Media::Item::MediaItem_Track> _mediaItem, JsonWriter &_jsonWriter)
             {
                 //addJsonForMediaItem_Album(std::dynamic_pointer_cast<Raumkernel::Media::Item::MediaItem_Album>(_mediaItem), _jsonWriter);
                 _jsonWriter.Key("title"); _jsonWriter.String(_mediaItem->title.c_str());                
             }
 
 
-            static void addJsonForMediaItem_Radio(std::shared_ptr<Raumkernel::Media::Item::MediaItem_Radio> _mediaItem, rapidjson::Writer<rapidjson::StringBuffer> &_jsonWriter)
+            template <typename JsonWriter>
+            static void addJsonForMediaItem_Radio(std::shared_ptr<Raumkernel::Media::Item::MediaItem_Radio> _mediaItem, JsonWriter &_jsonWriter)
             {       
                 _jsonWriter.Key("title"); _jsonWriter.String(_mediaItem->title.c_str());
                 _jsonWriter.Key("description"); _jsonWriter.String(_mediaItem->description.c_str());
@@ -100,13 +110,15 @@ namespace Raumserver
             }
 
 
-            static void addJsonForMediaItem_Radio_RadioTime(std::shared_ptr<Raumkernel::Media::Item::MediaItem_Radio_RadioTime> _mediaItem, rapidjson::Writer<rapidjson::StringBuffer> &_jsonWriter)
+            template <typename JsonWriter>
+            static void addJsonForMediaItem_Radio_RadioTime(std::shared_ptr<Raumkernel::Media::Item::MediaItem_Radio_RadioTime> _mediaItem, JsonWriter &_jsonWriter)
             {                
                 //addJsonForMediaItem_Radio(std::dynamic_pointer_cast<Raumkernel::Media::Item::MediaItem_Radio>(_mediaItem), _jsonWriter);                
             }
 
 
-            static void addJsonForMediaItem_Radio_Rhapsody(std::shared_ptr<Raumkernel::Media::Item::MediaItem_Radio_Rhapsody> _mediaItem, rapidjson::Writer<rapidjson::StringBuffer> &_jsonWriter)
+            template <typename JsonWriter>
+            static void addJsonForMediaItem_Radio_Rhapsody(std::shared_ptr<Raumkernel::Media::Item::MediaItem_Radio_Rhapsody> _mediaItem, JsonWriter &_jsonWriter)
             {
                 //addJsonForMediaItem_Radio(std::dynamic_pointer_cast<Raumkernel::Media::Item::MediaItem_Radio>(_mediaItem), _jsonWriter);
             }
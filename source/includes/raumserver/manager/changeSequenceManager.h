@@ -0,0 +1,131 @@
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 by ChriD
+//
+// Permission is hereby granted, free of charge,  to any person obtaining a copy of
+// this software and  associated documentation  files  (the "Software"), to deal in
+// the  Software  without  restriction,  including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software,  and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this  permission notice  shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE  SOFTWARE  IS  PROVIDED  "AS IS",  WITHOUT  WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE  AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE  LIABLE FOR ANY CLAIM,  DAMAGES OR OTHER LIABILITY, WHETHER
+// IN  AN  ACTION  OF  CONTRACT,  TORT  OR  OTHERWISE,  ARISING  FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef RAUMSERVER_CHANGESEQUENCEMANAGER_H
+#define RAUMSERVER_CHANGESEQUENCEMANAGER_H
+
+#include <array>
+#include <algorithm>
+#include <vector>
+#include <unordered_set>
+#include <unordered_map>
+#include <raumserver/manager/managerBaseServer.h>
+
+
+namespace Raumserver
+{
+    namespace Manager
+    {
+        enum class ChangeEntityType { CET_RENDERERSTATE, CET_ZONEMEDIALIST, CET_MEDIALIST, CET_ZONECONFIG, CET_COUNT };
+
+
+        /**
+        * An entry of the change journal. An entry without an entity id is a change of the whole entity type (eg. the zone configuration has changed)
+        */
+        struct ChangeJournalEntry
+        {
+            std::uint64_t sequence;
+            ChangeEntityType entityType;
+            std::string entityId;
+        };
+
+
+        /**
+        * The ChangeSequenceManager holds a 64 bit global change sequence and a version for each entity (eg. a renderer state or a media list)
+        * Each change of an entity will increase the global sequence and the new sequence value will be the version of the entity and of
+        * its entity type. So a version is exact and unique and a long polling request can check for a change by comparing one value.
+        * The sequence starts with the current time in microseconds so the versions will not repeat after a restart of the server.
+        * The last changes are stored in a bounded journal so requests are able to return only the entities which have changed since a given version
+        */
+        class ChangeSequenceManager : public ManagerBaseServer
+        {
+            public:
+                EXPORT ChangeSequenceManager();
+                EXPORT virtual ~ChangeSequenceManager();
+                /**
+                * connects to the change signals of the kernel
+                */
+                EXPORT virtual void init();
+                /**
+                * sets the count of changes which are stored in the journal. Older changes will be overwritten
+                */
+                EXPORT virtual void setJournalSize(std::uint32_t _journalSize);
+                /**
+                * returns the current value of the global change sequence
+                */
+                EXPORT virtual std::uint64_t getSequence();
+                /**
+                * returns the version of the entity with the given id. If the id is empty the version of the entity type will be returned
+                * which will change on every change of an entity of that type
+                */
+                EXPORT virtual std::uint64_t getVersion(ChangeEntityType _entityType, const std::string &_entityId = "");
+                /**
+                * marks the entity as changed and returns its new version
+                */
+                EXPORT virtual std::uint64_t bumpVersion(ChangeEntityType _entityType, const std::string &_entityId = "");
+                /**
+                * fills '_entityIds' with the ids of the entities of the given type which have changed after the version '_sinceVersion'
+                * returns false if the changes can't be determined because the version is not in the journal anymore (or was never in it)
+                * or because the whole entity type has changed. In this case the caller has to return all entities
+                */
+                EXPORT virtual bool getChangedEntities(ChangeEntityType _entityType, std::uint64_t _sinceVersion, std::unordered_set<std::string> &_entityIds);
+                /**
+                * compares the update ids of the kernel for the renderer states and the zone configuration with the ones from the last 
+                * check and bumps the versions of the changed entities. The kernel does not signal renderer state changes, so this will be
+                * called by the watcher of the long poll manager once for each check interval instead of once for each polling request
+                */
+                EXPORT virtual void checkKernelUpdateIds();
+
+            protected:
+                /**
+                * will be called by the kernel when a media list has changed
+                */
+                void onMediaListDataChanged(std::string _listId);
+                /**
+                * bumps the version of the entity and its type without locking
+                */
+                std::uint64_t bumpVersionUnlocked(ChangeEntityType _entityType, const std::string &_entityId);
+
+                std::atomic<std::uint64_t> sequence;
+                std::uint64_t startSequence;
+                std::array<std::atomic<std::uint64_t>, (std::size_t)ChangeEntityType::CET_COUNT> typeVersions;
+
+                std::mutex mutexVersions;
+                std::array<std::unordered_map<std::string, std::uint64_t>, (std::size_t)ChangeEntityType::CET_COUNT> entityVersions;
+                // the journal is a ring buffer indexed by the sequence of the change. It is protected by the versions mutex
+                std::vector<ChangeJournalEntry> journal;
+
+                // the update ids of the kernel we got on the last check
+                std::mutex mutexKernelUpdateIds;
+                std::unordered_map<std::string, std::string> rendererStateUpdateIds;
+                std::string zoneConfigUpdateId;
+                bool kernelUpdateIdsChecked;
+
+                sigs::connections connections;
+        };
+    }
+}
+
+
+#endif
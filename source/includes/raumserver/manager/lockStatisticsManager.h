@@ -0,0 +1,158 @@
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 by ChriD
+//
+// Permission is hereby granted, free of charge,  to any person obtaining a copy of
+// this software and  associated documentation  files  (the "Software"), to deal in
+// the  Software  without  restriction,  including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software,  and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this  permission notice  shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE  SOFTWARE  IS  PROVIDED  "AS IS",  WITHOUT  WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE  AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE  LIABLE FOR ANY CLAIM,  DAMAGES OR OTHER LIABILITY, WHETHER
+// IN  AN  ACTION  OF  CONTRACT,  TORT  OR  OTHERWISE,  ARISING  FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef RAUMSERVER_LOCKSTATISTICSMANAGER_H
+#define RAUMSERVER_LOCKSTATISTICSMANAGER_H
+
+#include <atomic>
+#include <array>
+#include <chrono>
+#include <raumserver/manager/managerBaseServer.h>
+#include <raumserver/request/requestAction.h>
+
+
+namespace Raumserver
+{
+    namespace Manager
+    {
+        // the count of request action types the statistics can hold
+        const std::size_t LOCKSTATISTICS_MAX_REQUESTACTIONTYPES = 64;
+        // a wait for the locks which takes longer will be counted as contended even if no owner held the locks (eg. the kernel did)
+        const std::uint64_t LOCKSTATISTICS_CONTENDED_WAIT_US = 100;
+
+        /**
+        * The owners of the locks which are not a request action. Their statistics are stored after the ones of the request action types
+        * LO_BATCH: a batch which shares the locks for its items
+        * LO_KERNELPOLLER: the ChangeSequenceManager which reads the update ids of the kernel
+        */
+        enum class LockOwner { LO_BATCH, LO_KERNELPOLLER };
+        const std::size_t LOCKSTATISTICS_MAX_LOCKOWNERS = 2;
+
+        /**
+        * The statistics of the device and zone manager locks for one request action type or owner. All values are only changed with atomic operations
+        */
+        struct ManagerLockStatistics
+        {
+            std::atomic<std::uint64_t> acquiredCount;
+            std::atomic<std::uint64_t> contendedCount;
+            std::atomic<std::uint64_t> waitTimeSumUS;
+            std::atomic<std::uint64_t> waitTimeMaxUS;
+            std::atomic<std::uint64_t> holdTimeSumUS;
+            std::atomic<std::uint64_t> holdTimeMaxUS;
+            // how often and how long others had to wait while a request action of this type (or the owner) held the locks
+            std::atomic<std::uint64_t> blockingCount;
+            std::atomic<std::uint64_t> blockingWaitTimeSumUS;
+        };
+
+
+        /**
+        * The LockStatisticsManager collects how long the request actions (and the other owners) wait for the device and zone manager locks 
+        * of the kernel, how long they hold them and which request action type or owner held the locks while the others had to wait. 
+        * Adding a value does not lock
+        */
+        class LockStatisticsManager : public ManagerBaseServer
+        {
+            public:
+                EXPORT LockStatisticsManager();
+                EXPORT virtual ~LockStatisticsManager();
+                /**
+                * has to be called before a request action waits for the locks. Returns the current owner of the locks (-1 if nobody tracked owns them)
+                */
+                EXPORT virtual std::int32_t beginLockWait();
+                /**
+                * has to be called when the request action got the locks. The request action will be the owner until 'addLockReleased' is called
+                */
+                EXPORT virtual void addLockAcquired(Request::RequestActionType _type, std::uint64_t _waitTimeUS, std::int32_t _ownerOnWait);
+                EXPORT virtual void addLockAcquired(LockOwner _owner, std::uint64_t _waitTimeUS, std::int32_t _ownerOnWait);
+                /**
+                * has to be called before the request action releases the locks
+                */
+                EXPORT virtual void addLockReleased(Request::RequestActionType _type, std::uint64_t _holdTimeUS);
+                EXPORT virtual void addLockReleased(LockOwner _owner, std::uint64_t _holdTimeUS);
+                /**
+                * returns the statistics of all request action types and owners which took the locks as json (sorted by the wait time)
+                */
+                EXPORT virtual std::string getStatisticsJson();
+                /**
+                * sets all values to 0
+                */
+                EXPORT virtual void reset();
+
+            protected:
+                /**
+                * sets the value to the given one if it's higher
+                */
+                static void updateMax(std::atomic<std::uint64_t> &_max, std::uint64_t _value);
+                /**
+                * adds the values to the statistics at the index (the request action type or the index of the owner)
+                */
+                void addLockAcquired(std::size_t _index, std::uint64_t _waitTimeUS, std::int32_t _ownerOnWait);
+                void addLockReleased(std::size_t _index, std::uint64_t _holdTimeUS);
+                /**
+                * returns the name of the request action type or of the owner at the index
+                */
+                static std::string getOwnerName(std::size_t _index);
+
+                // the statistics of the request action types followed by the ones of the owners
+                std::array<ManagerLockStatistics, LOCKSTATISTICS_MAX_REQUESTACTIONTYPES + LOCKSTATISTICS_MAX_LOCKOWNERS> lockStatistics;
+
+                /**
+                * the index of the request action type or owner which holds the locks right now (-1 for none)
+                */
+                std::atomic<std::int32_t> owner;
+                /**
+                * contended waits while no tracked owner held the locks (the kernel itself)
+                */
+                std::atomic<std::uint64_t> otherBlockingCount;
+                std::atomic<std::uint64_t> otherBlockingWaitTimeSumUS;
+        };
+
+
+        /**
+        * locks the device and the zone manager of the kernel for an owner which is not a request action and adds the wait and hold times 
+        * to its statistics. The locks are released on 'unlock' or when the guard is destroyed
+        */
+        class ManagerLockOwnerGuard
+        {
+            public:
+                EXPORT ManagerLockOwnerGuard(std::shared_ptr<Raumkernel::Manager::ManagerEngineer> _managerEngineer, std::shared_ptr<LockStatisticsManager> _lockStatisticsManager, LockOwner _owner, bool _lock = true);
+                ManagerLockOwnerGuard(const ManagerLockOwnerGuard&) = delete;
+                ManagerLockOwnerGuard& operator=(const ManagerLockOwnerGuard&) = delete;
+                EXPORT ~ManagerLockOwnerGuard();
+                EXPORT void lock();
+                EXPORT void unlock();
+                EXPORT bool isLocked();
+
+            protected:
+                std::shared_ptr<Raumkernel::Manager::ManagerEngineer> managerEngineer;
+                std::shared_ptr<LockStatisticsManager> lockStatisticsManager;
+                LockOwner owner;
+                bool locked;
+                std::chrono::steady_clock::time_point acquiredTime;
+        };
+    }
+}
+
+
+#endif
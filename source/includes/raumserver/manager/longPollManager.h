@@ -0,0 +1,189 @@
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2015 by ChriD
+//
+// Permission is hereby granted, free of charge,  to any person obtaining a copy of
+// this software and  associated documentation  files  (the "Software"), to deal in
+// the  Software  without  restriction,  including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software,  and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this  permission notice  shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE  SOFTWARE  IS  PROVIDED  "AS IS",  WITHOUT  WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE  AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE  LIABLE FOR ANY CLAIM,  DAMAGES OR OTHER LIABILITY, WHETHER
+// IN  AN  ACTION  OF  CONTRACT,  TORT  OR  OTHERWISE,  ARISING  FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef RAUMSERVER_LONGPOLLMANAGER_H
+#define RAUMSERVER_LONGPOLLMANAGER_H
+
+#include <list>
+#include <thread>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <condition_variable>
+#include <raumserver/manager/managerBaseServer.h>
+
+
+namespace Raumserver
+{
+    namespace Request
+    {
+        class RequestActionReturnableLongPolling;
+    }
+
+    namespace Manager
+    {
+        enum class LongPollWaiterState { LPWS_PARKED, LPWS_CHANGED, LPWS_ABORTED, LPWS_REJECTED };
+
+        /**
+        * A long polling request which is parked in the waiter registry of the LongPollManager
+        */
+        struct LongPollWaiter
+        {
+            Request::RequestActionReturnableLongPolling* requestAction;
+            // the key identifies all waiters which will get the same update id (action type and options without 'updateId' and 'sessionId')
+            std::string key;
+            // the channel on which the changes are signaled, empty if the update id depends on the kernel
+            std::string channel;
+            // the update id the client already knows
+            std::string updateId;
+            std::string sessionId;
+            // the update id the watcher found when it resumed the waiter
+            std::string lastUpdateId;
+            LongPollWaiterState state;
+            // subscriptions are waiters without a parked thread. They stay in the registry and the callback will be called on each change
+            std::uint64_t subscriptionId;
+            std::shared_ptr<Request::RequestActionReturnableLongPolling> subscriptionAction;
+            std::function<void(const std::string &_lastUpdateId)> subscriptionCallback;
+        };
+
+
+        /**
+        * The LongPollManager holds all the long polling requests which are waiting for an update id change.
+        * Instead of each request polling the kernel every 200ms on its own, the waiters are parked in a registry and one watcher thread 
+        * resolves the update id once for each distinct request key and resumes the waiters whose id has changed
+        * This only saves the polling of the kernel, not the threads. The webserver (civetweb 1.8) can't detach a connection from
+        * its thread, so a parked long polling request still holds its webserver thread till it is resumed. The webserver gets
+        * 'LongPollThreads' threads in addition to 'Threads' for them, and the count of parked requests is limited to this reserve.
+        * So the controller calls will always find a free thread, while further long polls are rejected. Clients which need many
+        * open channels should use the websocket ('/raumserver/ws') or the event stream ('/raumserver/data/events') which are subscriptions
+        */
+        class LongPollManager : public ManagerBaseServer
+        {
+            public:
+                EXPORT LongPollManager();
+                EXPORT virtual ~LongPollManager();
+                /**
+                * starts the watcher thread
+                */
+                EXPORT virtual void init();
+                /**
+                * parks the long polling request until its update id differs from '_updateId' or until the session is aborted
+                * The calling thread is blocked while the request is parked
+                * returns LPWS_CHANGED if the update id has changed. The new update id is stored in '_lastUpdateId'
+                * returns LPWS_REJECTED without blocking if the maximum of parked requests is reached
+                */
+                EXPORT virtual LongPollWaiterState waitForUpdate(Request::RequestActionReturnableLongPolling* _requestAction, const std::string &_updateId, const std::string &_sessionId, std::string &_lastUpdateId);
+                /**
+                * subscribes to the changes of the update id of the request action. The callback will be called by the watcher thread 
+                * each time the update id differs from the last one. The manager will keep the request action alive till 'unsubscribe' is called
+                * returns the id of the subscription
+                */
+                EXPORT virtual std::uint64_t subscribe(std::shared_ptr<Request::RequestActionReturnableLongPolling> _requestAction, const std::string &_updateId, std::function<void(const std::string &_lastUpdateId)> _callback);
+                /**
+                * removes the subscription. After this method returns the callback of the subscription will not be called anymore
+                * This method must not be called from within a subscription callback
+                */
+                EXPORT virtual void unsubscribe(std::uint64_t _subscriptionId);
+                /**
+                * wakes up the watcher thread so it checks the parked waiters right now (eg. when the kernel signals a change)
+                */
+                EXPORT virtual void notifyChange();
+                /**
+                * wakes up the watcher thread so it checks the waiters of the given channel right now. The other waiters and the kernel
+                * update ids will not be checked. Does nothing if there is no waiter on the channel
+                */
+                EXPORT virtual void notifyChannelChange(const std::string &_channel);
+                /**
+                * sets the time in ms the watcher will wait for a change notification before it checks the waiters anyway
+                */
+                EXPORT virtual void setCheckInterval(std::uint32_t _checkIntervalMS);
+                /**
+                * sets the maximum of parked long polling requests (the threads the webserver reserves for them). 0 means unlimited
+                * Subscriptions do not hold a thread and are not counted
+                */
+                EXPORT virtual void setMaxParkedCount(std::uint32_t _maxParkedCount);
+                /**
+                * returns the number of currently parked long polling requests
+                */
+                EXPORT virtual std::uint32_t getParkedCount();
+                /**
+                * returns the number of subscriptions (eg. of websocket clients)
+                */
+                EXPORT virtual std::uint32_t getSubscriptionCount();
+                /**
+                * returns the number of distinct sessions of the parked long polling requests
+                */
+                EXPORT virtual std::uint32_t getSessionCount();
+
+            protected:
+                /**
+                * the watcher thread which will check the update ids of the parked waiters
+                */
+                void changeWatcherThread();
+                /**
+                * checks the parked waiters and resumes those whose update id has changed or whose session was aborted
+                * if channels are given only the waiters of those channels will be checked
+                */
+                void checkWaiters(const std::unordered_set<std::string> *_channels = nullptr);
+                /**
+                * adds the waiter to the registry or removes it. Has to be called with the registry locked
+                */
+                void addWaiter(std::shared_ptr<LongPollWaiter> _waiter);
+                void removeWaiter(std::shared_ptr<LongPollWaiter> _waiter);
+                /**
+                * will be called by the kernel when a media list has changed
+                */
+                void onMediaListDataChanged(std::string _listId);
+
+                std::thread changeWatcherThreadObject;
+                std::atomic_bool stopThreads;
+                std::uint32_t checkIntervalMS;
+                std::uint32_t maxParkedCount;
+
+                // a mutex and a condition for the waiter registry. The condition is used to resume the parked waiters
+                std::mutex mutexWaiters;
+                std::condition_variable condWaiterResumed;
+                std::list<std::shared_ptr<LongPollWaiter>> waiters;
+                // the count of the waiters which are no subscriptions and hold a webserver thread
+                std::uint32_t parkedRequestCount;
+                // the count of waiters on each channel, so a change of a channel without waiters does not wake the watcher
+                std::unordered_map<std::string, std::uint32_t> channelWaiterCounts;
+
+                // a mutex which will be locked while the watcher is checking the waiters and calling the subscription callbacks
+                std::mutex mutexSubscriptions;
+                std::uint64_t lastSubscriptionId;
+
+                // a mutex and a condition used to wake up the watcher thread on changes
+                std::mutex mutexChange;
+                std::condition_variable condChange;
+                bool changePending;
+                std::unordered_set<std::string> changedChannels;
+
+                sigs::connections connections;
+        };
+    }
+}
+
+
+#endif
@@ -28,6 +28,14 @@
 #include <raumserver/raumserverBase.h>
 #include <raumserver/manager/requestActionManager.h>
 #include <raumserver/manager/sessionManager.h>
+#include <raumserver/manager/changeSequenceManager.h>
+#include <raumserver/manager/longPollManager.h>
+#include <raumserver/manager/responseCacheManager.h>
+#include <raumserver/manager/timerManager.h>
+#include <raumserver/manager/metricsManager.h>
+#include <raumserver/manager/traceManager.h>
+#include <raumserver/manager/lockStatisticsManager.h>
+#include <raumserver/manager/simulationManager.h>
 
 namespace Raumserver
 {
@@ -50,10 +58,29 @@ namespace Raumserver
 
                 EXPORT std::shared_ptr<Manager::RequestActionManager> getRequestActionManager();              
                 EXPORT std::shared_ptr<Manager::SessionManager> getSessionManager();
+                EXPORT std::shared_ptr<Manager::ChangeSequenceManager> getChangeSequenceManager();
+                EXPORT std::shared_ptr<Manager::LongPollManager> getLongPollManager();
+                EXPORT std::shared_ptr<Manager::ResponseCacheManager> getResponseCacheManager();
+                EXPORT std::shared_ptr<Manager::TimerManager> getTimerManager();
+                EXPORT std::shared_ptr<Manager::MetricsManager> getMetricsManager();
+                EXPORT std::shared_ptr<Manager::TraceManager> getTraceManager();
+                EXPORT std::shared_ptr<Manager::LockStatisticsManager> getLockStatisticsManager();
+                EXPORT std::shared_ptr<Manager::SimulationManager> getSimulationManager();
 
             protected:
                 std::shared_ptr<Manager::RequestActionManager> requestActionManager;
                 std::shared_ptr<Manager::SessionManager> sessionManager;
+                // the long poll manager uses the change sequence manager in its watcher thread, so it has to be destroyed before
+                std::shared_ptr<Manager::ChangeSequenceManager> changeSequenceManager;
+                std::shared_ptr<Manager::LongPollManager> longPollManager;
+                std::shared_ptr<Manager::ResponseCacheManager> responseCacheManager;
+                std::shared_ptr<Manager::MetricsManager> metricsManager;
+                std::shared_ptr<Manager::TraceManager> traceManager;
+                std::shared_ptr<Manager::LockStatisticsManager> lockStatisticsManager;
+                // the change storm thread of the simulation uses the change sequence and the long poll manager, so it has to be destroyed before
+                std::shared_ptr<Manager::SimulationManager> simulationManager;
+                // the request workers and the timer thread are stopped by the destructor before the managers are destroyed
+                std::shared_ptr<Manager::TimerManager> timerManager;
                 bool systemReady;
                
         };
@@ -0,0 +1,122 @@
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 by ChriD
+//
+// Permission is hereby granted, free of charge,  to any person obtaining a copy of
+// this software and  associated documentation  files  (the "Software"), to deal in
+// the  Software  without  restriction,  including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software,  and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this  permission notice  shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE  SOFTWARE  IS  PROVIDED  "AS IS",  WITHOUT  WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE  AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE  LIABLE FOR ANY CLAIM,  DAMAGES OR OTHER LIABILITY, WHETHER
+// IN  AN  ACTION  OF  CONTRACT,  TORT  OR  OTHERWISE,  ARISING  FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef RAUMSERVER_METRICSMANAGER_H
+#define RAUMSERVER_METRICSMANAGER_H
+
+#include <atomic>
+#include <array>
+#include <raumserver/manager/managerBaseServer.h>
+#include <raumserver/request/requestAction.h>
+
+
+namespace Raumserver
+{
+    namespace Manager
+    {
+        // the upper bounds in microseconds of the buckets of the latency histograms (the last bucket is '+Inf')
+        const std::array<std::uint64_t, 13> METRICS_LATENCY_BUCKETS_US = { { 1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000, 500000, 1000000, 2500000, 5000000, 10000000 } };
+        // the count of request action types the metrics can hold
+        const std::size_t METRICS_MAX_REQUESTACTIONTYPES = 64;
+
+        /**
+        * The counters and the latency histogram of one request action type. All values are only added with atomic operations
+        */
+        struct RequestActionMetrics
+        {
+            std::atomic<std::uint64_t> latencyBuckets[METRICS_LATENCY_BUCKETS_US.size() + 1];
+            std::atomic<std::uint64_t> latencySumUS;
+            std::atomic<std::uint64_t> executedCount;
+            std::atomic<std::uint64_t> errorCount;
+        };
+
+
+        /**
+        * The MetricsManager collects the metrics of the server (latency of the request actions, http requests, webserver threads)
+        * and provides them together with the values of the other managers (queue, long polling, response cache) in the
+        * Prometheus text format. Adding a value does not lock, so it can be done on each request
+        */
+        class MetricsManager : public ManagerBaseServer
+        {
+            public:
+                EXPORT MetricsManager();
+                EXPORT virtual ~MetricsManager();
+                /**
+                * adds the duration of an executed request action. '_success' is the return value of the execution
+                */
+                EXPORT virtual void addRequestActionExecution(Request::RequestActionType _type, std::uint64_t _durationUS, bool _success);
+                /**
+                * counts a request action which could not be executed (eg. invalid options)
+                */
+                EXPORT virtual void addRequestActionError(Request::RequestActionType _type);
+                /**
+                * has to be called when a webserver thread starts and ends handling a http request
+                */
+                EXPORT virtual void beginHttpRequest();
+                EXPORT virtual void endHttpRequest();
+                /**
+                * counts a http request which got an error response
+                */
+                EXPORT virtual void addHttpRequestError();
+                /**
+                * sets the count of the threads of the webserver
+                */
+                EXPORT virtual void setWebserverThreadCount(std::uint32_t _threadCount);
+                /**
+                * returns all metrics in the Prometheus text format
+                */
+                EXPORT virtual std::string getMetricsText();
+
+            protected:
+                void writeRequestActionMetrics(std::string &_text);
+                void writeQueueMetrics(std::string &_text);
+                void writeLongPollMetrics(std::string &_text);
+                void writeWebserverMetrics(std::string &_text);
+
+                /**
+                * writes the 'HELP' and 'TYPE' lines of a metric
+                */
+                static void writeMetricHeader(std::string &_text, const std::string &_name, const std::string &_type, const std::string &_help);
+                /**
+                * writes a sample line with an optional label (eg. 'name{action="play"} 1')
+                */
+                static void writeMetricValue(std::string &_text, const std::string &_name, const std::string &_labels, const std::string &_value);
+
+                /**
+                * returns the seconds for the microseconds as string
+                */
+                static std::string microsecondsToSeconds(std::uint64_t _microseconds);
+
+                std::array<RequestActionMetrics, METRICS_MAX_REQUESTACTIONTYPES> requestActionMetrics;
+
+                std::atomic<std::uint64_t> httpRequestCount;
+                std::atomic<std::uint64_t> httpRequestErrorCount;
+                std::atomic<std::int32_t> busyWebserverThreadCount;
+                std::atomic<std::uint32_t> webserverThreadCount;
+        };
+    }
+}
+
+
+#endif
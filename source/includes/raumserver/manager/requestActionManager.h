@@ -25,8 +25,16 @@
 #ifndef RAUMSERVER_REQUESTACTIONMANAGER_H
 #define RAUMSERVER_REQUESTACTIONMANAGER_H
 
-#include <queue>
+#include <deque>
+#include <vector>
+#include <unordered_set>
+#include <unordered_map>
+#include <map>
+#include <chrono>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
 #include <raumkernel/versionInfo.h>
 #include <raumserver/manager/managerBaseServer.h>
 #include <raumserver/request/requestActions.h>
@@ -36,21 +44,125 @@ namespace Raumserver
 {
     namespace Manager
     {        
+        // a job which runs in a lane of the queue instead of a request action (eg. the request actions of a batch for one zone)
+        // it will be called with false if it was dropped without being executed. It returns the time in ms its lane has to wait
+        // till the job is called again to continue (eg. a wait time of a batch item), 0 if the job is done
+        typedef std::function<std::uint32_t(bool _execute)> RequestActionLaneJob;
+
+        struct RequestActionQueueItem
+        {
+            // a nullptr if the item is a job
+            std::shared_ptr<Request::RequestAction> requestAction;
+            RequestActionLaneJob job;
+            // the lane is resolved when the request action is added, so the worker threads don't have to query the kernel
+            std::string laneId;
+            std::chrono::steady_clock::time_point enqueueTime;
+            // the time in ms the request action may wait in the queue, 0 if it has no deadline
+            std::uint32_t deadline;
+            // the timer which will drop the request action when its deadline has passed, 0 if there is none
+            std::uint64_t deadlineTimerId;
+            // identifies the deadline the timer was added for. A merge replaces the deadline, so a timer which was already called will not drop the request action
+            std::uint64_t deadlineId;
+            // the priority class the request action had when it was started
+            Request::RequestActionPriority priority;
+            // the id of the request the status will be reported for (a merged request action will keep the id of the first request)
+            // jobs have no id and no status
+            std::uint64_t requestId;
+        };
+
+
+        enum class RequestActionState { RAS_UNKNOWN, RAS_DELAYED, RAS_QUEUED, RAS_RUNNING, RAS_DONE, RAS_ERROR, RAS_DROPPED, RAS_MERGED };
+
+        /**
+        * The status of a request action which was added to the request action manager
+        */
+        struct RequestActionStatus
+        {
+            std::uint64_t requestId;
+            std::string requestInfo;
+            RequestActionState state;
+            std::string error;
+            // if the request was merged into another request (eg. volume changes) this is the id of the request which will do the job
+            std::uint64_t mergedIntoRequestId;
+            // times in ms since epoch
+            std::uint64_t addTime;
+            std::uint64_t startTime;
+            std::uint64_t endTime;
+            // will be raised on each change of the status, so it can be used as update id for long polling
+            std::uint64_t version;
+        };
+
+
+        struct RequestActionWaitStatistics
+        {
+            std::uint64_t count;
+            std::uint64_t droppedCount;
+            std::uint64_t waitTimeSumUS;
+            std::uint64_t waitTimeMaxUS;
+        };
+
+
         class RequestActionManager : public ManagerBaseServer
         {
             public:
                 EXPORT RequestActionManager();
                 EXPORT virtual ~RequestActionManager(); 
                 /**
-                * starting the thread for processing requests
+                * starting the threads for processing requests
                 */
                 EXPORT virtual void init();
                 /**
+                * stops and joins the worker threads. The jobs which were not executed yet or are waiting for a timer will be called with false
+                * Has to be called before the managers the workers use (eg. the timer manager) are destroyed
+                */
+                EXPORT virtual void stop();
+                /**
+                * sets the count of worker threads which will execute the requests of different lanes in parallel
+                * has to be called before 'init'
+                */
+                EXPORT virtual void setWorkerCount(std::uint32_t _workerCount);
+                /**
+                * returns the count of request actions which were merged into a request action waiting in the queue (eg. volume changes of a slider)
+                */
+                EXPORT virtual std::uint64_t getMergedRequestActionCount();
+                /**
+                * returns the wait time statistics (time from adding to starting a request action) for each priority class
+                */
+                EXPORT virtual std::map<Request::RequestActionPriority, RequestActionWaitStatistics> getWaitStatistics();
+                /**
+                * returns the count of request actions which are waiting in the queue
+                */
+                EXPORT virtual std::uint32_t getQueueDepth();
+                /**
+                * returns the count of request actions which are running right now
+                */
+                EXPORT virtual std::uint32_t getRunningCount();
+                /**
+                * sets the count of request status entries which will be kept. Has to be called before 'init'
+                */
+                EXPORT virtual void setStatusBufferSize(std::uint32_t _statusBufferSize);
+                /**
+                * returns the status of the request with the given id. Returns false if the request is unknown or its status was already overwritten
+                */
+                EXPORT virtual bool getRequestStatus(std::uint64_t _requestId, RequestActionStatus &_status);
+                /**
+                * returns a string identification for the state of a request
+                */
+                EXPORT static std::string requestActionStateToString(RequestActionState _state);
+                /**
                 * add a requestAction to the queue which will be processed by the thread method
+                * if the request action has a start delay ('delay' or 'at' option) it will be added to the queue when the delay has passed
                 */
                 EXPORT virtual void addRequestAction(std::shared_ptr<Request::RequestAction> _requestAction);
                 /**
-                * The thread method which will process the queue
+                * adds a job to the queue which will run on a worker in the given lane. It will run after the request actions of the lane 
+                * which were added before and the following request actions of the lane will wait till it is done. A job with an empty lane 
+                * is a barrier like a request action without a lane. If the job returns a wait time its lane stays blocked and the job will be 
+                * called again when the time has passed, the worker is free meanwhile. If the manager is stopped before the job has run it will be called with false
+                */
+                EXPORT virtual void addLaneJob(const std::string &_laneId, RequestActionLaneJob _job);
+                /**
+                * The thread method which will process the queue. There are 'workerCount' threads running this method
                 */
                 EXPORT virtual void requestProcessingWorkerThread();
                 /**
@@ -77,14 +189,77 @@ namespace Raumserver
                 * if so it will perform the requests in a FIFO order
                 */
                 void doRequests();
-                std::thread doRequestsThreadObject;
+                /**
+                * takes the request action with the highest priority out of the queue which may run now. Has to be called with the queue locked
+                * A request action may run if there is no request of its lane running or waiting before it and if there is no barrier (a request 
+                * without a lane) running or waiting before it. A barrier may only run if it is the first one in the queue and no other request is running.
+                * One worker is always kept free for high priority request actions. The deadline timer of the taken request action will be cancelled.
+                */
+                bool takeNextRequestAction(RequestActionQueueItem &_item);
+                /**
+                * removes the request action from the queue if it is still waiting. Will be called by the deadline timer of the request action
+                * so it is dropped when its deadline has passed, even if all workers are busy. Does nothing if the deadline was replaced by a merge
+                */
+                void dropExpiredRequestAction(std::uint64_t _requestId, std::uint64_t _deadlineId);
+                /**
+                * executes the request action of the item on the current worker and sets its status. Returns the wait time of the request action
+                * after which its lane will be idle
+                */
+                std::uint32_t executeQueuedRequestAction(const RequestActionQueueItem &_item);
+                /**
+                * returns the priority of a waiting item. A merged request action may have changed the priority of the item
+                */
+                Request::RequestActionPriority getQueuedPriority(const RequestActionQueueItem &_item);
+                /**
+                * marks the lane of the given item as idle again. Has to be called with the queue locked
+                */
+                void finishRequestAction(const RequestActionQueueItem &_item);
+                /**
+                * puts the request action into the queue (or merges it) and wakes up a worker
+                */
+                void queueRequestAction(std::shared_ptr<Request::RequestAction> _requestAction);
+                /**
+                * updates the status of the request in the status ring buffer and wakes up long polling status requests
+                */
+                void setRequestStatus(std::uint64_t _requestId, RequestActionState _state, const std::string &_error = "", std::uint64_t _mergedIntoRequestId = 0, const std::string &_requestInfo = "");
+                /**
+                * tries to merge the request action into the last waiting request action of its lane. A barrier is only merged into a barrier 
+                * at the end of the queue. The merged request action gets the deadline of the newer one. Has to be called with the queue locked
+                */
+                bool mergeRequestAction(const RequestActionQueueItem &_item);
+
+                std::vector<std::thread> workerThreadObjects;
+                std::uint32_t workerCount;
                 std::atomic_bool stopThreads;
 
-                // a mutex that will secure our request action list 
-                std::mutex mutexRequestActionQueue;              
+                // a mutex that will secure our request action list. It is only locked for pushing and popping, never while executing
+                std::mutex mutexRequestActionQueue;
+                // the worker thread waits on this until a request action was added or the manager is stopping
+                std::condition_variable condRequestActionQueue;
 
                 // a list which contains all request Actions whch are not already processed                    
-                std::queue<std::shared_ptr<Request::RequestAction>> requestActionQueue;
+                std::deque<RequestActionQueueItem> requestActionQueue;
+                // the lanes which have a request running
+                std::unordered_set<std::string> runningLanes;
+                std::uint32_t runningCount;
+                bool barrierRunning;
+                std::atomic<std::uint64_t> mergedRequestActionCount;
+                // the count of running request actions which do not have a high priority and which are using a worker
+                // (request actions which are waiting for their 'wait' time to pass do not use a worker)
+                std::uint32_t runningNotHighCount;
+                std::map<Request::RequestActionPriority, RequestActionWaitStatistics> waitStatistics;
+                // the id of the last deadline timer, only changed with the queue locked
+                std::uint64_t lastDeadlineId;
+                // the jobs which are waiting for a timer before they continue
+                std::unordered_map<std::uint64_t, RequestActionLaneJob> waitingJobs;
+                std::uint64_t lastWaitingJobId;
+
+                std::atomic<std::uint64_t> lastRequestId;
+                // a mutex which will secure the status buffer
+                std::mutex mutexRequestStatus;
+                // the status of the last requests. The status of a request is stored at index 'requestId % size' so memory will stay flat
+                std::vector<RequestActionStatus> requestStatusBuffer;
+                std::uint64_t lastStatusVersion;
 
                 // Version info only for returning om request responses)
                 VersionInfo::VersionInfo versionInfoKernel;
@@ -0,0 +1,113 @@
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 by ChriD
+//
+// Permission is hereby granted, free of charge,  to any person obtaining a copy of
+// this software and  associated documentation  files  (the "Software"), to deal in
+// the  Software  without  restriction,  including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software,  and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this  permission notice  shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE  SOFTWARE  IS  PROVIDED  "AS IS",  WITHOUT  WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE  AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE  LIABLE FOR ANY CLAIM,  DAMAGES OR OTHER LIABILITY, WHETHER
+// IN  AN  ACTION  OF  CONTRACT,  TORT  OR  OTHERWISE,  ARISING  FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef RAUMSERVER_RESPONSECACHEMANAGER_H
+#define RAUMSERVER_RESPONSECACHEMANAGER_H
+
+#include <map>
+#include <unordered_map>
+#include <condition_variable>
+#include <raumserver/manager/managerBaseServer.h>
+
+
+namespace Raumserver
+{
+    namespace Manager
+    {
+        /**
+        * A serialized response of a request which is shared by all requests with the same key and update id
+        */
+        struct ResponseCacheEntry
+        {
+            std::string updateId;
+            std::shared_ptr<const std::string> data;
+            std::map<std::string, std::string> header;
+            bool success;
+            // the entry is being built by a request. Other requests for the same update id will wait for it
+            bool building;
+            std::uint64_t lastAccess;
+            // the encoded (eg. compressed) versions of the data. An empty pointer means that the encoded data is being built
+            std::map<std::string, std::shared_ptr<const std::string>> encodedData;
+        };
+
+
+        /**
+        * The ResponseCacheManager holds the last serialized response for each request key (action type and normalized options).
+        * When an update id changes, the first request builds the response and all other requests for the same key and update id
+        * will wait for it and get the same immutable buffer instead of locking the kernel and building the same json again
+        */
+        class ResponseCacheManager : public ManagerBaseServer
+        {
+            public:
+                EXPORT ResponseCacheManager();
+                EXPORT virtual ~ResponseCacheManager();
+                /**
+                * sets the maximum count of request keys which are cached. The least recently used entries will be removed
+                */
+                EXPORT virtual void setMaxEntries(std::uint32_t _maxEntries);
+                /**
+                * returns true if the caller has to build the response for the key and the update id. In this case it has to call
+                * 'releaseResponse' when it is done. Otherwise the response of another request is stored in '_entry'.
+                * If another request is building the response right now this method will wait until it is finished
+                */
+                EXPORT virtual bool acquireResponse(const std::string &_key, const std::string &_updateId, ResponseCacheEntry &_entry);
+                /**
+                * stores the response which was built after 'acquireResponse' returned true and resumes the waiting requests
+                * if the response could not be built the data has to be a nullptr, then one of the waiting requests will build it
+                */
+                EXPORT virtual void releaseResponse(const std::string &_key, const std::string &_updateId, std::shared_ptr<const std::string> _data, const std::map<std::string, std::string> &_header, bool _success);
+                /**
+                * returns true if the caller has to encode the response data. In this case it has to call 'releaseEncodedResponse' when it is done.
+                * Otherwise the encoded data of another request is stored in '_encodedData'. Only the data which is stored in the cache for 
+                * the key will have its encoded data cached, for other data this method will always return true
+                */
+                EXPORT virtual bool acquireEncodedResponse(const std::string &_key, const std::shared_ptr<const std::string> &_data, const std::string &_encoding, std::shared_ptr<const std::string> &_encodedData);
+                /**
+                * stores the encoded data which was built after 'acquireEncodedResponse' returned true. If the encoding failed the
+                * encoded data has to be a nullptr
+                */
+                EXPORT virtual void releaseEncodedResponse(const std::string &_key, const std::shared_ptr<const std::string> &_data, const std::string &_encoding, std::shared_ptr<const std::string> _encodedData);
+                /**
+                * returns the count of responses which were taken from the cache
+                */
+                EXPORT virtual std::uint64_t getHitCount();
+
+            protected:
+                /**
+                * removes the least recently used entries which are not being built if there are more entries than allowed
+                */
+                void removeOldEntries();
+
+                std::mutex mutexCache;
+                std::condition_variable condResponseBuilt;
+                std::unordered_map<std::string, ResponseCacheEntry> cache;
+                std::uint32_t maxEntries;
+                std::uint64_t accessCounter;
+                std::uint64_t hitCount;
+        };
+    }
+}
+
+
+#endif
@@ -0,0 +1,238 @@
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 by ChriD
+//
+// Permission is hereby granted, free of charge,  to any person obtaining a copy of
+// this software and  associated documentation  files  (the "Software"), to deal in
+// the  Software  without  restriction,  including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software,  and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this  permission notice  shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE  SOFTWARE  IS  PROVIDED  "AS IS",  WITHOUT  WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE  AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE  LIABLE FOR ANY CLAIM,  DAMAGES OR OTHER LIABILITY, WHETHER
+// IN  AN  ACTION  OF  CONTRACT,  TORT  OR  OTHERWISE,  ARISING  FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef RAUMSERVER_SIMULATIONMANAGER_H
+#define RAUMSERVER_SIMULATIONMANAGER_H
+
+#include <atomic>
+#include <random>
+#include <thread>
+#include <condition_variable>
+#include <unordered_set>
+#include <raumserver/manager/managerBaseServer.h>
+#include <raumserver/request/requestAction.h>
+
+
+namespace Raumserver
+{
+    namespace Manager
+    {
+        // the time in ms between two checks of the change storm thread. The changes for the elapsed time will be made at once
+        const std::uint32_t SIMULATION_CHANGESTORM_TICK_MS = 10;
+        // the seed of the random changes, so two runs with the same settings will make the same changes in the same order
+        const std::uint32_t SIMULATION_RANDOM_SEED = 1;
+        // the count of tracks of a simulated album (used for the album names of the media items)
+        const std::uint32_t SIMULATION_ALBUM_TRACKCOUNT = 12;
+
+        /**
+        * A room of the simulated system. A room without a zone UDN is not in a zone
+        */
+        struct SimulatedRoom
+        {
+            std::string UDN;
+            std::string name;
+            std::string color;
+            std::string rendererUDN;
+            std::string zoneUDN;
+            std::uint32_t volume;
+            bool mute;
+            bool standby;
+        };
+
+
+        /**
+        * A zone of the simulated system with the state of its virtual renderer
+        */
+        struct SimulatedZone
+        {
+            std::string UDN;
+            std::string rendererUDN;
+            std::vector<std::size_t> roomIndexes;
+            std::uint32_t volume;
+            std::string transportState;
+            std::string playMode;
+            std::string containerId;
+            std::uint32_t numberOfTracks;
+            std::uint32_t currentTrack;
+            std::int32_t positionMS;
+        };
+
+
+        /**
+        * The options of a request action the simulation needs to execute it
+        */
+        struct SimulatedRequest
+        {
+            Request::RequestActionType type;
+            std::vector<std::string> ids;
+            std::string zoneId;
+            bool zoneScope;
+            bool relative;
+            std::int32_t value;
+            // the mode of 'setPlayMode', the seek type of 'seek' or the container or uri of the load actions
+            std::string text;
+            // the track index of 'seekToTrack' and the load actions (-1 if not given)
+            std::int32_t trackIndex;
+        };
+
+
+        /**
+        * The SimulationManager simulates a Raumfeld system with a given count of zones and rooms, so the server (webserver, queue,
+        * long polling) can be load tested without any Raumfeld device. If it's enabled the request actions will be executed on the
+        * simulated renderers instead of the kernel. Each call to a renderer takes the configured latency and each change of the simulated
+        * system will bump the versions of the change sequence manager, so the long polling requests get the changes like from the kernel.
+        * A change storm thread may change random renderers with a given rate to simulate other clients (eg. the Raumfeld app)
+        */
+        class SimulationManager : public ManagerBaseServer
+        {
+            public:
+                EXPORT SimulationManager();
+                EXPORT virtual ~SimulationManager();
+                /**
+                * creates the rooms and zones and starts the change storm thread if a change rate is set
+                */
+                EXPORT virtual void init();
+                EXPORT virtual void setEnabled(bool _enabled);
+                EXPORT virtual bool isEnabled();
+                EXPORT virtual void setZoneCount(std::uint32_t _zoneCount);
+                EXPORT virtual void setRoomCount(std::uint32_t _roomCount);
+                /**
+                * sets the time in ms each call to a simulated renderer will take
+                */
+                EXPORT virtual void setLatency(std::uint32_t _latencyMS);
+                /**
+                * sets the count of items of the simulated media lists (and of the zone playlists after a load action)
+                */
+                EXPORT virtual void setMediaListSize(std::uint32_t _mediaListSize);
+                /**
+                * sets the count of random renderer changes per second. 0 disables the change storm
+                */
+                EXPORT virtual void setChangeRate(std::uint32_t _changeRate);
+                /**
+                * returns true if the request action type calls the kernel and will be executed by the simulation
+                */
+                EXPORT virtual bool isRequestActionTypeSimulated(Request::RequestActionType _type);
+                /**
+                * executes the request on the simulated system. Returns false if the room or zone was not found
+                */
+                EXPORT virtual bool executeRequest(const SimulatedRequest &_request);
+                /**
+                * returns the UDN of the zone renderer for a zone UDN, a renderer UDN, a room name or a room UDN (empty if not found)
+                */
+                EXPORT virtual std::string getRendererUDN(const std::string &_id);
+                /**
+                * returns the execution lane of the id like the request actions do for the kernel (the zone UDN of a room)
+                */
+                EXPORT virtual std::string getExecutionLaneId(const std::string &_id);
+                /**
+                * returns the zone configuration as json like 'getZoneConfig'
+                */
+                EXPORT virtual std::string getZoneConfigJson();
+                /**
+                * writes the renderer states as json like 'getRendererState' to '_json'. If '_changedRendererUDNs' is given only those renderers
+                * will be written. Returns false if the id was not found
+                */
+                EXPORT virtual bool getRendererStateJson(const std::string &_id, bool _listAll, const std::unordered_set<std::string> *_changedRendererUDNs, std::string &_json);
+                /**
+                * writes the zone playlists as json like 'getZoneMediaList' to '_json'. Returns false if the id was not found
+                */
+                EXPORT virtual bool getZoneMediaListJson(const std::string &_id, std::string &_json);
+                /**
+                * loads the media list like the media server would do (takes the latency and signals a change of the list)
+                */
+                EXPORT virtual void loadMediaList(const std::string &_listId);
+                /**
+                * returns the media list as json like 'getMediaList'
+                */
+                EXPORT virtual std::string getMediaListJson(const std::string &_listId);
+
+            protected:
+                /**
+                * the thread which changes random renderers with the change rate
+                */
+                void changeStormThread();
+                /**
+                * makes one random change on a renderer. The mutex of the simulation has to be locked
+                */
+                void makeRandomChange();
+                /**
+                * executes a request on a zone. The mutex of the simulation has to be locked. Returns false if the request can't be executed
+                */
+                bool executeZoneRequest(const SimulatedRequest &_request, SimulatedZone &_zone, const std::string &_id);
+                /**
+                * moves the rooms to the zone (a new zone is created if the zone UDN is empty) and removes the zones which got empty
+                */
+                void moveRoomsToZone(const std::vector<std::size_t> &_roomIndexes, const std::string &_zoneUDN);
+                void removeRoomsFromZones(const std::vector<std::size_t> &_roomIndexes);
+                /**
+                * returns the index of the room with the name, the UDN or the renderer UDN (-1 if not found)
+                */
+                std::int32_t findRoom(const std::string &_id);
+                /**
+                * returns the zone for a zone UDN, a zone renderer UDN or a room which is in a zone (nullptr if not found)
+                */
+                SimulatedZone* findZone(const std::string &_id);
+                std::string getZoneName(const SimulatedZone &_zone);
+                std::string getMuteState(const SimulatedZone &_zone);
+                /**
+                * signals a change of the renderer (and of the zone configuration) to the change sequence manager and the long poll manager
+                */
+                void signalRendererChange(const std::string &_rendererUDN);
+                void signalZoneConfigChange();
+                /**
+                * sleeps for the latency of a call to a renderer
+                */
+                void simulateLatency();
+
+                template <typename JsonWriter>
+                void addRendererStateToJson(const SimulatedZone &_zone, JsonWriter &_jsonWriter);
+                template <typename JsonWriter>
+                void addRoomRendererStateToJson(const SimulatedRoom &_room, JsonWriter &_jsonWriter);
+                template <typename JsonWriter>
+                void addMediaItemToJson(const std::string &_containerId, std::uint32_t _index, JsonWriter &_jsonWriter);
+
+                std::atomic_bool enabled;
+                std::uint32_t zoneCount;
+                std::uint32_t roomCount;
+                std::uint32_t latencyMS;
+                std::uint32_t mediaListSize;
+                std::uint32_t changeRate;
+
+                // the mutex protects the rooms, the zones and the random generator
+                std::mutex mutexSimulation;
+                std::vector<SimulatedRoom> rooms;
+                std::vector<SimulatedZone> zones;
+                std::uint32_t lastZoneNumber;
+                std::mt19937 randomGenerator;
+
+                std::thread changeStormThreadObject;
+                std::atomic_bool stopThreads;
+                std::mutex mutexStop;
+                std::condition_variable condStop;
+        };
+    }
+}
+
+
+#endif
@@ -0,0 +1,128 @@
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2015 by ChriD
+//
+// Permission is hereby granted, free of charge,  to any person obtaining a copy of
+// this software and  associated documentation  files  (the "Software"), to deal in
+// the  Software  without  restriction,  including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software,  and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this  permission notice  shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE  SOFTWARE  IS  PROVIDED  "AS IS",  WITHOUT  WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE  AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE  LIABLE FOR ANY CLAIM,  DAMAGES OR OTHER LIABILITY, WHETHER
+// IN  AN  ACTION  OF  CONTRACT,  TORT  OR  OTHERWISE,  ARISING  FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef RAUMSERVER_TIMERMANAGER_H
+#define RAUMSERVER_TIMERMANAGER_H
+
+#include <list>
+#include <array>
+#include <thread>
+#include <functional>
+#include <unordered_map>
+#include <condition_variable>
+#include <raumserver/manager/managerBaseServer.h>
+
+
+namespace Raumserver
+{
+    namespace Manager
+    {
+        const std::uint32_t TIMERWHEEL_TICKMS = 10;
+        const std::uint32_t TIMERWHEEL_LEVELS = 4;
+        // the first level has 256 slots of one tick (2.56s), each higher level has 64 slots which each cover a whole turn of the level below
+        const std::uint32_t TIMERWHEEL_LEVEL0_BITS = 8;
+        const std::uint32_t TIMERWHEEL_LEVELN_BITS = 6;
+
+        typedef std::function<void()> TimerCallback;
+
+        struct TimerEntry
+        {
+            std::uint64_t id;
+            // the tick on which the timer will expire
+            std::uint64_t expireTick;
+            TimerCallback callback;
+        };
+
+
+        /**
+        * A hierarchical timer wheel which calls callbacks after a given time without having a sleeping thread for each of them
+        * Timers which expire far in the future are stored in the higher levels and will be moved down to the lower levels
+        * when the lower level has finished a turn. The callbacks will be called on the timer thread and should return quickly.
+        */
+        class TimerManager : public ManagerBaseServer
+        {
+            public:
+                EXPORT TimerManager();
+                EXPORT virtual ~TimerManager();
+                /**
+                * starts the timer thread
+                */
+                EXPORT virtual void init();
+                /**
+                * stops and joins the timer thread. The timers which did not expire yet will not be called anymore
+                */
+                EXPORT virtual void stop();
+                /**
+                * adds a timer which will call the callback after the given time. Returns the id of the timer which can be used for cancelling
+                * the precision of the timer is one tick (10ms)
+                */
+                EXPORT virtual std::uint64_t addTimer(std::uint32_t _delayMS, TimerCallback _callback);
+                /**
+                * cancels a timer. Returns false if the timer was already called or if it does not exist
+                */
+                EXPORT virtual bool cancelTimer(std::uint64_t _timerId);
+                /**
+                * returns the count of timers which are waiting
+                */
+                EXPORT virtual std::uint32_t getTimerCount();
+
+            protected:
+                /**
+                * the thread method which advances the wheels each tick
+                */
+                void timerThread();
+                /**
+                * returns the tick for the current time
+                */
+                std::uint64_t getCurrentTick();
+                /**
+                * puts the timer into the slot of the level which fits the remaining time. Has to be called with the wheels locked
+                */
+                void insertTimer(std::shared_ptr<TimerEntry> _timerEntry);
+                /**
+                * advances the wheels by one tick and moves the expired timers to the given list. Has to be called with the wheels locked
+                */
+                void advanceTick(std::list<std::shared_ptr<TimerEntry>> &_expiredTimers);
+
+                std::thread timerThreadObject;
+                std::atomic_bool stopThreads;
+
+                // a mutex which will secure the wheels and the timer map
+                std::mutex mutexWheels;
+                std::condition_variable condTimer;
+
+                std::array<std::vector<std::list<std::shared_ptr<TimerEntry>>>, TIMERWHEEL_LEVELS> wheels;
+                // all waiting timers by their id, used for cancelling
+                std::unordered_map<std::uint64_t, std::shared_ptr<TimerEntry>> timers;
+
+                std::chrono::steady_clock::time_point startTime;
+                // the last tick which was processed
+                std::uint64_t currentTick;
+                std::uint64_t lastTimerId;
+        };
+    }
+}
+
+
+#endif
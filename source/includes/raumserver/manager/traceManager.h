@@ -0,0 +1,155 @@
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 by ChriD
+//
+// Permission is hereby granted, free of charge,  to any person obtaining a copy of
+// this software and  associated documentation  files  (the "Software"), to deal in
+// the  Software  without  restriction,  including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software,  and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this  permission notice  shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE  SOFTWARE  IS  PROVIDED  "AS IS",  WITHOUT  WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE  AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE  LIABLE FOR ANY CLAIM,  DAMAGES OR OTHER LIABILITY, WHETHER
+// IN  AN  ACTION  OF  CONTRACT,  TORT  OR  OTHERWISE,  ARISING  FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef RAUMSERVER_TRACEMANAGER_H
+#define RAUMSERVER_TRACEMANAGER_H
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <raumserver/manager/managerBaseServer.h>
+
+
+namespace Raumserver
+{
+    namespace Request
+    {
+        enum class RequestActionType;
+    }
+
+    namespace Manager
+    {
+        // the count of spans each thread keeps. Older spans of a thread will be overwritten
+        const std::uint32_t TRACE_BUFFER_SIZE = 2048;
+
+        /**
+        * A span in the ring buffer of a thread. The values are atomic, so the buffer can be read while the thread is writing to it.
+        * The sequence is odd while the span is written and tells the reader which span of the ring is stored in the slot
+        */
+        struct TraceEvent
+        {
+            std::atomic<std::uint64_t> sequence;
+            std::atomic<const char*> name;
+            std::atomic<const char*> category;
+            std::atomic<std::uint64_t> startUS;
+            std::atomic<std::uint64_t> durationUS;
+            std::atomic<std::uint64_t> requestId;
+            std::atomic<std::int32_t> actionType;
+            // a buffer is given to the next thread when its thread ends, so each span keeps the id of the thread which wrote it
+            std::atomic<std::uint32_t> threadId;
+        };
+
+
+        /**
+        * The ring buffer of spans of one thread. Only its thread is writing to it, so it needs no lock
+        */
+        struct TraceBuffer
+        {
+            std::uint32_t threadId;
+            std::atomic<std::uint64_t> writeCount;
+            std::unique_ptr<TraceEvent[]> events;
+        };
+
+
+        /**
+        * The TraceManager records the spans of the request phases (parse, validate, queue, lock, execute, write, ...) in a ring buffer
+        * of each thread and exports them as Chrome trace event json (can be viewed with Perfetto or chrome://tracing).
+        * Tracing is disabled by default, then a span only costs the check if tracing is enabled
+        */
+        class TraceManager : public ManagerBaseServer
+        {
+            public:
+                EXPORT TraceManager();
+                EXPORT virtual ~TraceManager();
+                /**
+                * returns true if spans are recorded
+                */
+                static bool isEnabled()
+                {
+                    return enabled.load(std::memory_order_relaxed);
+                }
+                /**
+                * enables or disables the recording of spans
+                */
+                EXPORT static void setEnabled(bool _enabled);
+                /**
+                * adds a span to the buffer of the calling thread. The name and the category have to be static strings
+                */
+                EXPORT static void addSpan(const char* _name, const char* _category, std::chrono::steady_clock::time_point _startTime, std::chrono::steady_clock::time_point _endTime, std::uint64_t _requestId, Request::RequestActionType _actionType);
+                /**
+                * returns the spans of all threads which ended in the last '_seconds' as Chrome trace event json
+                */
+                EXPORT virtual std::string getTraceJson(std::uint32_t _seconds);
+
+            protected:
+                /**
+                * returns the buffer of the calling thread. A thread which has ended will give its buffer to the next new thread,
+                * which will get a new thread id
+                */
+                static TraceBuffer* getThreadBuffer();
+
+                static std::atomic<bool> enabled;
+        };
+
+
+        /**
+        * Records a span from its creation to its destruction if tracing is enabled
+        */
+        class TraceSpan
+        {
+            public:
+                TraceSpan(const char* _name, const char* _category, std::uint64_t _requestId = 0, Request::RequestActionType _actionType = Request::RequestActionType())
+                {
+                    active = TraceManager::isEnabled();
+                    if (!active)
+                        return;
+                    name = _name;
+                    category = _category;
+                    requestId = _requestId;
+                    actionType = _actionType;
+                    startTime = std::chrono::steady_clock::now();
+                }
+
+                ~TraceSpan()
+                {
+                    if (active)
+                        TraceManager::addSpan(name, category, startTime, std::chrono::steady_clock::now(), requestId, actionType);
+                }
+
+                TraceSpan(const TraceSpan&) = delete;
+                TraceSpan& operator=(const TraceSpan&) = delete;
+
+            protected:
+                bool active;
+                const char* name;
+                const char* category;
+                std::uint64_t requestId;
+                Request::RequestActionType actionType;
+                std::chrono::steady_clock::time_point startTime;
+        };
+    }
+}
+
+
+#endif
@@ -38,6 +38,40 @@ namespace Raumserver
     const std::string SETTINGS_RAUMSERVER_PORT = ".//Raumserver//Port";
     const std::string SETTINGS_RAUMSERVER_DOCROOT = ".//Raumserver//Docroot";
     const std::string SETTINGS_RAUMSERVER_DOCROOT_DEFAULT = "docroot";
+    const std::string SETTINGS_RAUMSERVER_THREADS = ".//Raumserver//Threads";
+    const std::string SETTINGS_RAUMSERVER_THREADS_DEFAULT = "50";
+    const std::string SETTINGS_RAUMSERVER_LONGPOLLTHREADS = ".//Raumserver//LongPollThreads";
+    const std::string SETTINGS_RAUMSERVER_LONGPOLLTHREADS_DEFAULT = "200";
+    const std::string SETTINGS_RAUMSERVER_LONGPOLLCHECKINTERVAL = ".//Raumserver//LongPollCheckInterval";
+    const std::string SETTINGS_RAUMSERVER_LONGPOLLCHECKINTERVAL_DEFAULT = "200";
+    const std::string SETTINGS_RAUMSERVER_REQUESTWORKERS = ".//Raumserver//RequestWorkers";
+    const std::string SETTINGS_RAUMSERVER_REQUESTWORKERS_DEFAULT = "4";
+    const std::string SETTINGS_RAUMSERVER_REQUESTSTATUSBUFFERSIZE = ".//Raumserver//RequestStatusBufferSize";
+    const std::string SETTINGS_RAUMSERVER_REQUESTSTATUSBUFFERSIZE_DEFAULT = "1000";
+    const std::string SETTINGS_RAUMSERVER_CHANGEJOURNALSIZE = ".//Raumserver//ChangeJournalSize";
+    const std::string SETTINGS_RAUMSERVER_CHANGEJOURNALSIZE_DEFAULT = "1000";
+    const std::string SETTINGS_RAUMSERVER_RESPONSECACHESIZE = ".//Raumserver//ResponseCacheSize";
+    const std::string SETTINGS_RAUMSERVER_RESPONSECACHESIZE_DEFAULT = "256";
+    const std::string SETTINGS_RAUMSERVER_KEEPALIVE = ".//Raumserver//KeepAlive";
+    const std::string SETTINGS_RAUMSERVER_KEEPALIVE_DEFAULT = "true";
+    const std::string SETTINGS_RAUMSERVER_COMPRESSIONLEVEL = ".//Raumserver//CompressionLevel";
+    const std::string SETTINGS_RAUMSERVER_COMPRESSIONLEVEL_DEFAULT = "6";
+    const std::string SETTINGS_RAUMSERVER_COMPRESSIONMINSIZE = ".//Raumserver//CompressionMinSize";
+    const std::string SETTINGS_RAUMSERVER_COMPRESSIONMINSIZE_DEFAULT = "1024";
+    const std::string SETTINGS_RAUMSERVER_TRACING = ".//Raumserver//Tracing";
+    const std::string SETTINGS_RAUMSERVER_TRACING_DEFAULT = "false";
+    const std::string SETTINGS_RAUMSERVER_SIMULATION = ".//Raumserver//Simulation//Enabled";
+    const std::string SETTINGS_RAUMSERVER_SIMULATION_DEFAULT = "false";
+    const std::string SETTINGS_RAUMSERVER_SIMULATIONZONES = ".//Raumserver//Simulation//Zones";
+    const std::string SETTINGS_RAUMSERVER_SIMULATIONZONES_DEFAULT = "4";
+    const std::string SETTINGS_RAUMSERVER_SIMULATIONROOMS = ".//Raumserver//Simulation//Rooms";
+    const std::string SETTINGS_RAUMSERVER_SIMULATIONROOMS_DEFAULT = "8";
+    const std::string SETTINGS_RAUMSERVER_SIMULATIONLATENCY = ".//Raumserver//Simulation//Latency";
+    const std::string SETTINGS_RAUMSERVER_SIMULATIONLATENCY_DEFAULT = "20";
+    const std::string SETTINGS_RAUMSERVER_SIMULATIONMEDIALISTSIZE = ".//Raumserver//Simulation//MediaListSize";
+    const std::string SETTINGS_RAUMSERVER_SIMULATIONMEDIALISTSIZE_DEFAULT = "100";
+    const std::string SETTINGS_RAUMSERVER_SIMULATIONCHANGERATE = ".//Raumserver//Simulation//ChangeRate";
+    const std::string SETTINGS_RAUMSERVER_SIMULATIONCHANGERATE_DEFAULT = "0";
 
     class Raumserver : public Raumkernel::RaumkernelBase
     {
@@ -94,6 +128,15 @@ namespace Raumserver
             void onRaumfeldSystemOnline();
             void onRaumfeldSystemOffline();
             void onLog(Raumkernel::Log::LogData _logData);
+            /**
+            * returns true if the server is running on the simulated Raumfeld system
+            */
+            bool isSimulationEnabled();
+            /**
+            * returns the number of a setting. If the value is no number or is not within the range a warning will be logged
+            * and the default is used, so a wrong setting will not stop the server
+            */
+            std::uint32_t getNumericSettingValue(const std::string &_key, const std::string &_default, std::uint32_t _min, std::uint32_t _max);
 
             std::shared_ptr<Raumkernel::Raumkernel> raumkernel;
             std::shared_ptr<Raumkernel::Manager::ManagerEngineer> managerEngineerKernel;
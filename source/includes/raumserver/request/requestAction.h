@@ -30,6 +30,12 @@
 #include <raumkernel/manager/managerEngineer.h>
 #include <raumkernel/manager/zoneManager.h>
 #include <raumkernel/manager/deviceManager.h>
+#include <raumserver/json/rapidjson/rapidjson.h>
+#include <raumserver/json/rapidjson/writer.h>
+#include <raumserver/json/rapidjson/stringbuffer.h>
+#include <raumserver/json/rapidjson/document.h>
+#include <raumserver/request/requestOptionTable.h>
+#include <raumserver/request/requestActionArena.h>
 
 namespace Raumserver
 {
@@ -39,16 +45,20 @@ namespace Raumserver
                                        RAA_CREATEZONE, RAA_ADDTOZONE, RAA_DROPFROMZONE, RAA_MUTE, RAA_UNMUTE, RAA_SETPLAYMODE, RAA_LOADPLAYLIST, RAA_LOADCONTAINER, RAA_LOADURI, RAA_SEEK, RAA_SEEKTOTRACK,
                                        RAA_FADETOVOLUME, RAA_SLEEPTIMER, RAA_TOGGLEMUTE, RAA_LOADSHUFFLE, RAA_KILLSESSION,
                                        // returnable requests (requests which return data)
-                                       RAA_GETVERSION, RAA_GETZONECONFIG, RAA_GETMEDIALIST, RAA_GETZONEMEDIALIST, RAA_GETRENDERERSTATE, RAA_GETRENDERERTRANSPORTSTATE,
+                                       RAA_GETVERSION, RAA_GETZONECONFIG, RAA_GETMEDIALIST, RAA_GETZONEMEDIALIST, RAA_GETRENDERERSTATE, RAA_GETRENDERERTRANSPORTSTATE, RAA_GETREQUESTSTATUS,
                                        RAA_ENTERAUTOMATICSTANDBY, RAA_ENTERMANUALSTANDBY, RAA_LEAVESTANDBY, RAA_CRASH
                                       };
         enum class RequestReceiver { RR_ROOM, RR_ZONE, RR_JSON };
+        // the priority class of a request action. The request action manager will start waiting requests with a higher priority first
+        enum class RequestActionPriority { RAP_HIGH, RAP_NORMAL, RAP_LOW };
+        // the options of a request action are kept in the arena of the request action
+        typedef BasicRequestOptionTable<RequestActionArenaAllocator<char>> RequestActionOptionTable;
      
         class RequestAction : public RaumserverBaseMgr
         {
             public:
-                EXPORT RequestAction(std::string _url);
-                EXPORT RequestAction(std::string _path, std::string _query);
+                EXPORT RequestAction(const std::string &_url);
+                EXPORT RequestAction(const std::string &_path, const std::string &_query);
                 EXPORT virtual ~RequestAction();
 
                 /**
@@ -93,7 +103,7 @@ namespace Raumserver
                 /**
                 *  craeted an requestAction object from an path
                 */
-                EXPORT static std::shared_ptr<RequestAction> createFromPath(std::string _path, std::string _queryString);
+                EXPORT static std::shared_ptr<RequestAction> createFromPath(const std::string &_path, const std::string &_queryString);
                 /**
                 * returns a room UDN for a room UDN or a room name
                 */
@@ -106,8 +116,110 @@ namespace Raumserver
                 * returns the action type of the request
                 */
                 EXPORT RequestActionType getActionType();
+                /**
+                * returns the priority class of the request action
+                */
+                EXPORT RequestActionPriority getPriority();
+                /**
+                * returns a string identification for the priority class
+                */
+                EXPORT static std::string requestActionPriorityToString(RequestActionPriority _priority);
+                /**
+                * returns the time in ms the request action may wait in the queue before it will be dropped ('deadline' option)
+                * 0 means the request action has no deadline
+                */
+                EXPORT virtual std::uint32_t getDeadline();
+                /**
+                * returns the time in ms to wait after the execution before the next request for the same zone may be executed
+                * The time is given by the 'wait' option or defined by the request action itself
+                */
+                EXPORT virtual std::uint32_t getWaitTimeAfterExecution();
+                /**
+                * if set to false 'execute' will not wait after the execution. The caller has to take care of the wait time
+                * (eg. the request action manager will keep the lane blocked with a timer instead of sleeping on the worker)
+                */
+                EXPORT void setWaitAfterExecution(bool _waitAfterExecution);
+                /**
+                * returns the time in ms the request action should be delayed before it's queued. The time is given by the 
+                * 'delay' option (in ms) or the 'at' option (unix time in seconds, eg. play?at=1735689600)
+                */
+                EXPORT virtual std::uint32_t getStartDelay();
+                /**
+                * returns the id which was given to the request action when it was added to the queue (0 if it was not queued)
+                */
+                EXPORT std::uint64_t getRequestId();
+                /**
+                * sets the request id. This will be done by the request action manager
+                */
+                EXPORT void setRequestId(std::uint64_t _requestId);
+                /**
+                * returns the id of the lane the request action will be executed in (the zone of the 'id' option)
+                * Request actions with the same lane id will be executed in FIFO order, lanes may run in parallel.
+                * An empty lane id means the request action is a barrier and will be executed when all lanes are idle
+                */
+                EXPORT virtual std::string getExecutionLaneId();
+                /**
+                * returns a request action which does the same as this request action followed by the given one (which was queued after this one)
+                * or a nullptr if they can't be merged. The returned request action will replace both request actions in the queue.
+                * The base implementation merges the volume changes (setVolume, volumeUp, volumeDown) for the same id and scope
+                */
+                EXPORT virtual std::shared_ptr<RequestAction> createMergedRequestAction(std::shared_ptr<RequestAction> _requestAction);
+                /**
+                * returns true if the request action changes the volume. Relative changes will be returned as signed value
+                */
+                EXPORT virtual bool getVolumeChange(bool &_relative, std::int32_t &_value);
+                /**
+                * returns true if the request action may be executed while the caller holds the device and zone manager locks for it
+                * (eg. a batch which executes several request actions with one lock). Request actions which have to wait for the kernel
+                * to apply their changes (eg. zone changes) have to return false, because the kernel can't update while the locks are held
+                */
+                EXPORT virtual bool isManagerLockSharable();
+                /**
+                * tells the request action that the caller holds the device and zone manager locks while it is executed
+                */
+                EXPORT void setManagerLocksHeld(bool _managerLocksHeld);
+                /**
+                * sets the options of the request from a json object like {"id":"Kitchen","value":30,"id":["Kitchen","Bath"]} (eg. the body of a POST request)
+                * The json options will be taken additionally to the query options and will overwrite query options with the same key.
+                * The json will be parsed in place, so the values do not have to be escaped. Returns false if the json is not a valid object
+                */
+                EXPORT virtual bool setOptionsFromJson(std::string _json);
+                /**
+                * sets the options of the request from the members of an already parsed json object
+                */
+                EXPORT virtual void setOptionsFromJson(const rapidjson::Value &_options);
+                /**
+                * returns the string value of a json value. Numbers and bools will be returned as they are written in the json
+                */
+                EXPORT static std::string jsonValueToString(const rapidjson::Value &_value);
      
             protected:                
+                /**
+                * locks the device and the zone manager of the kernel if the caller does not already hold the locks for the request action
+                */
+                virtual void lockDeviceAndZoneManager();
+                virtual void unlockDeviceAndZoneManager();
+                /**
+                * locks the device and the zone manager for the request action until 'unlock' is called or the guard is destroyed,
+                * so a return or an exception while the locks are held will not leave them locked
+                */
+                class ManagerLockGuard
+                {
+                    public:
+                        ManagerLockGuard(RequestAction *_requestAction);
+                        ManagerLockGuard(const ManagerLockGuard&) = delete;
+                        ManagerLockGuard& operator=(const ManagerLockGuard&) = delete;
+                        ~ManagerLockGuard();
+                        void unlock();
+
+                    protected:
+                        RequestAction *requestAction;
+                        bool locked;
+                };
+                /**
+                * adds the duration of the execution to the metrics of the server
+                */
+                virtual void addExecutionMetrics(std::uint64_t _durationUS, bool _success);
                 /**
                 * parses the query options to a map
                 */
@@ -127,38 +239,65 @@ namespace Raumserver
                 */
                 virtual Raumkernel::Devices::MediaRenderer_RaumfeldVirtual* getVirtualMediaRendererFromUDN(std::string _udn);
                 /**
-                * 
+                * returns a copy of the value of the option (the key is case insensitive) or the default if the option is not existent
                 */
-                virtual std::string getOptionValue(std::string _key, std::string _default = "");
+                virtual std::string getOptionValue(const std::string &_key, const std::string &_default = "");
+                /**
+                * returns a view on the value of the option without copying it. The view is empty if the option is not existent 
+                * and is valid as long as the request action exists
+                */
+                virtual RequestOptionValue getOptionValueView(const std::string &_key);
+                /**
+                * returns true for 'true' or '1' and false for 'false' or '0'. Returns the default if the option is not existent or has another value
+                */
+                virtual bool getOptionValueBool(const std::string &_key, bool _default = false);
                 /**
                 * 
                 */
-                virtual std::vector<std::string> getOptionValueMultiple(std::string _key, std::string _delimiter = ",");
+                virtual std::vector<std::string> getOptionValueMultiple(const std::string &_key, const std::string &_delimiter = ",");
                 /**
                 * the execute action itself
                 */
                 EXPORT virtual bool executeAction();
                 /**
+                * executes the action on the simulated Raumfeld system instead of the kernel
+                */
+                EXPORT virtual bool executeActionSimulated();
+                /**
+                * returns true if the request action is executed on the simulated Raumfeld system
+                */
+                EXPORT bool isSimulated();
+                /**
                 * returns if the scope is a zone scope
                 */
                 EXPORT virtual bool isZoneScope(const std::string &_scope);
+                EXPORT virtual bool isZoneScope(const RequestOptionValue &_scope);
            
                 virtual void logError(const std::string &_log, const std::string &_location) override;
                 virtual void logCritical(const std::string &_log, const std::string &_location) override;
 
+                /**
+                * the memory for the url, the query and the options of the request. It has to be declared before them
+                */
+                RequestActionArena arena;
                 /**
                 * the whole url of the request
                 */
-                std::string url;
+                RequestActionArenaString url;
                 /**
                 * the query of the request
                 */
-                std::string query;
+                RequestActionArenaString query;
                 /**
                 * the action we have to perform
                 */
                 RequestActionType action;
                 /**
+                * the priority class of the request action. Transport critical request actions (eg. stop, pause) have a high priority,
+                * long running request actions (eg. loading playlists) have a low priority
+                */
+                RequestActionPriority priority;
+                /**
                 * the receiver of the request (may be a zone or a room or.....)
                 */
                 RequestReceiver receiver;
@@ -169,7 +308,17 @@ namespace Raumserver
                 /**
                 * query values as request options
                 */
-                std::unordered_map<std::string, std::string> requestOptions;   
+                RequestActionOptionTable requestOptions;   
+                /**
+                * true if the query (and the json options) were parsed into the request options
+                */
+                bool optionsParsed;
+                /**
+                * the options which were given as json object (the receiver will be RR_JSON then). Arrays are kept as multiple values, so
+                * they don't have to be joined and exploded again
+                */
+                std::unordered_map<std::string, std::string> jsonOptions;
+                std::unordered_map<std::string, std::vector<std::string>> jsonOptionsMultiple;
                 /**
                 * contains some error if the request may not be executed. This error may be written back to the user
                 */
@@ -180,6 +329,14 @@ namespace Raumserver
                 */
                 std::uint16_t waitTimeAfterExecution;
                 /**
+                * if false the wait time after the execution will be handled by the caller
+                */
+                bool waitAfterExecution;
+                /**
+                * the id of the request which is returned to the client for getting the status of a queued request
+                */
+                std::uint64_t requestId;
+                /**
                 * timout for processing the whole request
                 */
                 std::uint16_t timeout;
@@ -187,6 +344,14 @@ namespace Raumserver
                 * wait time to check the kernel for updates
                 */
                 std::uint16_t waitTimeForRequestActionKernelResponse;
+                /**
+                * true if the caller holds the device and zone manager locks while the request action is executed
+                */
+                bool managerLocksHeld;
+                /**
+                * the time the request action got the device and zone manager locks (for the lock statistics)
+                */
+                std::chrono::steady_clock::time_point managerLocksAcquiredTime;
         };
     }
 }
@@ -0,0 +1,144 @@
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 by ChriD
+//
+// Permission is hereby granted, free of charge,  to any person obtaining a copy of
+// this software and  associated documentation  files  (the "Software"), to deal in
+// the  Software  without  restriction,  including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software,  and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this  permission notice  shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE  SOFTWARE  IS  PROVIDED  "AS IS",  WITHOUT  WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE  AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE  LIABLE FOR ANY CLAIM,  DAMAGES OR OTHER LIABILITY, WHETHER
+// IN  AN  ACTION  OF  CONTRACT,  TORT  OR  OTHERWISE,  ARISING  FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef RAUMSERVER_REQUESTACTIONARENA_H
+#define RAUMSERVER_REQUESTACTIONARENA_H
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+// the size of the buffer each request action has for its strings and options. A request with longer values will still work,
+// the values which do not fit will be allocated on the heap
+#ifndef RAUMSERVER_REQUESTACTION_ARENASIZE
+#define RAUMSERVER_REQUESTACTION_ARENASIZE 1024
+#endif
+
+namespace Raumserver
+{
+    namespace Request
+    {
+        /**
+        * A monotonic arena which is embedded in a request action. The url, the query and the options of the request are allocated
+        * from it, so they live in the memory of the request action itself and do not need any heap allocation.
+        * The memory is only given back when the arena is destroyed (except the last allocation, so growing buffers do not waste it)
+        */
+        class RequestActionArena
+        {
+            public:
+                RequestActionArena()
+                {
+                    used = 0;
+                    heapAllocationCount = 0;
+                }
+
+                RequestActionArena(const RequestActionArena&) = delete;
+                RequestActionArena& operator=(const RequestActionArena&) = delete;
+
+                void* allocate(std::size_t _size)
+                {
+                    auto alignedSize = getAlignedSize(_size);
+                    if (alignedSize <= sizeof(buffer) - used)
+                    {
+                        void *memory = buffer + used;
+                        used += alignedSize;
+                        return memory;
+                    }
+                    heapAllocationCount++;
+                    return ::operator new(_size);
+                }
+
+                void deallocate(void *_memory, std::size_t _size)
+                {
+                    auto memory = static_cast<char*>(_memory);
+                    if (memory >= buffer && memory < buffer + sizeof(buffer))
+                    {
+                        if (memory + getAlignedSize(_size) == buffer + used)
+                            used -= getAlignedSize(_size);
+                        return;
+                    }
+                    ::operator delete(_memory);
+                }
+
+                /**
+                * returns the count of allocations which did not fit into the arena
+                */
+                std::uint32_t getHeapAllocationCount() const
+                {
+                    return heapAllocationCount;
+                }
+
+            protected:
+                static std::size_t getAlignedSize(std::size_t _size)
+                {
+                    return (_size + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+                }
+
+                alignas(std::max_align_t) char buffer[RAUMSERVER_REQUESTACTION_ARENASIZE];
+                std::size_t used;
+                std::uint32_t heapAllocationCount;
+        };
+
+
+        /**
+        * An allocator for the standard containers which allocates from the arena of a request action
+        */
+        template <typename T> class RequestActionArenaAllocator
+        {
+            public:
+                typedef T value_type;
+
+                RequestActionArenaAllocator(RequestActionArena *_arena) : arena(_arena) {}
+                template <typename U> RequestActionArenaAllocator(const RequestActionArenaAllocator<U> &_other) : arena(_other.arena) {}
+
+                T* allocate(std::size_t _count)
+                {
+                    return static_cast<T*>(arena->allocate(_count * sizeof(T)));
+                }
+
+                void deallocate(T *_memory, std::size_t _count)
+                {
+                    arena->deallocate(_memory, _count * sizeof(T));
+                }
+
+                template <typename U> bool operator==(const RequestActionArenaAllocator<U> &_other) const
+                {
+                    return arena == _other.arena;
+                }
+
+                template <typename U> bool operator!=(const RequestActionArenaAllocator<U> &_other) const
+                {
+                    return arena != _other.arena;
+                }
+
+                RequestActionArena *arena;
+        };
+
+        typedef std::basic_string<char, std::char_traits<char>, RequestActionArenaAllocator<char>> RequestActionArenaString;
+    }
+}
+
+
+#endif
@@ -0,0 +1,158 @@
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 by ChriD
+//
+// Permission is hereby granted, free of charge,  to any person obtaining a copy of
+// this software and  associated documentation  files  (the "Software"), to deal in
+// the  Software  without  restriction,  including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software,  and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this  permission notice  shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE  SOFTWARE  IS  PROVIDED  "AS IS",  WITHOUT  WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE  AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE  LIABLE FOR ANY CLAIM,  DAMAGES OR OTHER LIABILITY, WHETHER
+// IN  AN  ACTION  OF  CONTRACT,  TORT  OR  OTHERWISE,  ARISING  FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+
+#pragma once
+#ifndef RAUMSERVER_REQUESTACTIONBATCH_H
+#define RAUMSERVER_REQUESTACTIONBATCH_H
+
+#include <thread>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <raumserver/request/requestAction.h>
+#include <raumserver/json/rapidjson/rapidjson.h>
+#include <raumserver/json/rapidjson/writer.h>
+#include <raumserver/json/rapidjson/stringbuffer.h>
+#include <raumserver/json/rapidjson/document.h>
+
+namespace Raumserver
+{
+    namespace Request
+    {
+        enum class RequestActionBatchMode { RABM_ORDERED, RABM_PARALLEL };
+        enum class RequestActionBatchItemState { RABS_WAITING, RABS_INVALID, RABS_DONE, RABS_ERROR, RABS_SKIPPED };
+
+        struct RequestActionBatchItem
+        {
+            // the action name as given by the client (eg. 'setVolume')
+            std::string action;
+            // a nullptr if the action is unknown
+            std::shared_ptr<RequestAction> requestAction;
+            RequestActionBatchItemState state;
+            std::string error;
+            // set when the start delay of the item ('delay' or 'at' option) has passed
+            bool delayed;
+        };
+
+        /**
+        * A batch executes several controller request actions in one round trip (eg. all the actions of a scene button)
+        * The request actions are created with the same factory as the single requests ('createFromPath')
+        * In ordered mode the request actions are executed one after the other and following request actions which allow it will share
+        * one lock of the device and zone manager. In parallel mode the request actions of different lanes (zones) are executed in parallel,
+        * the request actions of one lane stay in order. Request actions without a lane are executed when all other request actions before are done.
+        * The request actions are executed by the workers of the request action manager in the lanes of their zones, so they stay in order 
+        * with the queued requests of the same zones. In ordered mode the batch runs in the lane of its zone or as a barrier if it has several zones.
+        * The start delay ('delay' or 'at') and the wait time ('wait') of an item are done on timers of the request action manager, the lane of the
+        * item waits but the worker is free meanwhile
+        */
+        class RequestActionBatch : public RaumserverBaseMgr
+        {
+            public:
+                EXPORT RequestActionBatch();
+                EXPORT virtual ~RequestActionBatch();
+                /**
+                * sets the execution mode of the batch
+                */
+                EXPORT void setMode(RequestActionBatchMode _mode);
+                /**
+                * if set no further request action will be started after a request action of the batch has failed
+                * Invalid request actions will stop the whole batch before anything was executed
+                */
+                EXPORT void setStopOnError(bool _stopOnError);
+                /**
+                * adds a controller request action to the batch. The query has the same format as the query of a single request
+                */
+                EXPORT void addItem(const std::string &_action, const std::string &_query);
+                /**
+                * adds the request actions of a json array like [{"action":"setVolume","options":{"id":"Kitchen","value":30}},{"action":"play"}]
+                * Returns false if the json is invalid
+                */
+                EXPORT bool addItemsFromJson(const std::string &_json);
+                /**
+                * validates and executes the request actions of the batch. Returns true if all request actions were executed without an error
+                */
+                EXPORT bool execute();
+                /**
+                * returns the results of the items as json string
+                */
+                EXPORT std::string getResultJson();
+                /**
+                * returns the items of the batch
+                */
+                EXPORT const std::vector<RequestActionBatchItem>& getItems();
+                /**
+                * returns a string identification for the state of a batch item
+                */
+                EXPORT static std::string itemStateToString(RequestActionBatchItemState _state);
+                /**
+                * returns the mode for a string identification ('ordered' or 'parallel')
+                */
+                EXPORT static RequestActionBatchMode stringToMode(const std::string &_mode);
+
+            protected:
+                /**
+                * executes the given items in order, starting at '_position'. If '_shareManagerLocks' is set following items which allow it 
+                * will share one lock of the device and zone manager. If an item has a start delay or a wait time the method returns the time 
+                * to wait and '_position' is the item to continue with. Returns 0 if all items are done
+                */
+                std::uint32_t executeOrdered(const std::vector<std::size_t> &_itemIndexes, std::size_t &_position, bool _shareManagerLocks);
+                /**
+                * executes the items of different lanes in parallel, items without a lane will wait for all items before
+                */
+                void executeParallel();
+                /**
+                * executes one item and sets its state
+                */
+                void executeItem(RequestActionBatchItem &_item);
+                /**
+                * lets the request action manager run the job on a worker in the given lane (an empty lane is a barrier)
+                * The job returns the time its lane has to wait till it is called again, 0 if it's done
+                */
+                void addLaneJob(const std::string &_laneId, std::function<std::uint32_t()> _job);
+                /**
+                * waits till all jobs of the batch are done. Exceptions which were not handled by the request actions (eg. an app crash) 
+                * will be thrown again in the calling thread
+                */
+                void waitForLaneJobs();
+
+                std::vector<RequestActionBatchItem> items;
+                RequestActionBatchMode mode;
+                bool stopOnError;
+                // will be set when an item has failed and the batch should stop
+                std::atomic_bool stopped;
+
+                // a mutex and a condition for waiting on the jobs of the batch which are running on the request workers
+                std::mutex mutexLaneJobs;
+                std::condition_variable condLaneJobs;
+                std::uint32_t runningLaneJobs;
+                std::exception_ptr laneJobException;
+        };
+    }
+}
+
+
+#endif
@@ -0,0 +1,151 @@
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 by ChriD
+//
+// Permission is hereby granted, free of charge,  to any person obtaining a copy of
+// this software and  associated documentation  files  (the "Software"), to deal in
+// the  Software  without  restriction,  including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software,  and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this  permission notice  shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE  SOFTWARE  IS  PROVIDED  "AS IS",  WITHOUT  WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE  AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE  LIABLE FOR ANY CLAIM,  DAMAGES OR OTHER LIABILITY, WHETHER
+// IN  AN  ACTION  OF  CONTRACT,  TORT  OR  OTHERWISE,  ARISING  FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+
+#pragma once
+#ifndef RAUMSERVER_REQUESTACTIONNAMETABLE_H
+#define RAUMSERVER_REQUESTACTIONNAMETABLE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace Raumserver
+{
+    namespace Request
+    {
+        /**
+        * A case insensitive hash table for the names of the request actions. It uses open addressing with a size of at least twice 
+        * the count of names, so a lookup is mostly one hash and one compare. The lookup does not allocate, so a segment of a path
+        * can be looked up without copying or converting it
+        */
+        template <typename TValue> class RequestActionNameTable
+        {
+            public:
+                RequestActionNameTable()
+                {
+                    slots.resize(16);
+                    count = 0;
+                }
+
+                /**
+                * inserts or replaces the value for the name
+                */
+                void insert(const std::string &_name, const TValue &_value)
+                {
+                    if ((count + 1) * 2 > slots.size())
+                        rehash(slots.size() * 2);
+
+                    auto &slot = slots[findSlotIndex(_name.c_str(), _name.length())];
+                    if (!slot.used)
+                        count++;
+                    slot.used = true;
+                    slot.name = _name;
+                    slot.value = _value;
+                }
+
+                /**
+                * returns the value for the name or a nullptr if the name is unknown
+                */
+                const TValue* find(const char* _name, std::size_t _length) const
+                {
+                    auto &slot = slots[findSlotIndex(_name, _length)];
+                    return slot.used ? &slot.value : nullptr;
+                }
+
+                std::size_t size() const
+                {
+                    return count;
+                }
+
+            protected:
+                struct Slot
+                {
+                    Slot() : used(false) {}
+                    bool used;
+                    std::string name;
+                    TValue value;
+                };
+
+                static char toLower(char _char)
+                {
+                    return (_char >= 'A' && _char <= 'Z') ? (char)(_char + ('a' - 'A')) : _char;
+                }
+
+                // FNV-1a on the lower case characters
+                static std::uint32_t hash(const char* _name, std::size_t _length)
+                {
+                    std::uint32_t value = 2166136261u;
+                    for (std::size_t i = 0; i < _length; i++)
+                    {
+                        value ^= (std::uint8_t)toLower(_name[i]);
+                        value *= 16777619u;
+                    }
+                    return value;
+                }
+
+                static bool equals(const std::string &_name, const char* _otherName, std::size_t _otherLength)
+                {
+                    if (_name.length() != _otherLength)
+                        return false;
+                    for (std::size_t i = 0; i < _otherLength; i++)
+                    {
+                        if (toLower(_name[i]) != toLower(_otherName[i]))
+                            return false;
+                    }
+                    return true;
+                }
+
+                /**
+                * returns the index of the slot of the name or of the empty slot where it would be inserted
+                */
+                std::size_t findSlotIndex(const char* _name, std::size_t _length) const
+                {
+                    std::size_t mask = slots.size() - 1;
+                    std::size_t index = hash(_name, _length) & mask;
+                    while (slots[index].used && !equals(slots[index].name, _name, _length))
+                        index = (index + 1) & mask;
+                    return index;
+                }
+
+                void rehash(std::size_t _size)
+                {
+                    std::vector<Slot> oldSlots(_size);
+                    oldSlots.swap(slots);
+                    count = 0;
+                    for (auto &slot : oldSlots)
+                    {
+                        if (slot.used)
+                            insert(slot.name, slot.value);
+                    }
+                }
+
+                // the size is always a power of two
+                std::vector<Slot> slots;
+                std::size_t count;
+        };
+    }
+}
+
+
+#endif
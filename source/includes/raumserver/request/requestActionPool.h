@@ -0,0 +1,180 @@
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 by ChriD
+//
+// Permission is hereby granted, free of charge,  to any person obtaining a copy of
+// this software and  associated documentation  files  (the "Software"), to deal in
+// the  Software  without  restriction,  including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software,  and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this  permission notice  shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE  SOFTWARE  IS  PROVIDED  "AS IS",  WITHOUT  WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE  AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE  LIABLE FOR ANY CLAIM,  DAMAGES OR OTHER LIABILITY, WHETHER
+// IN  AN  ACTION  OF  CONTRACT,  TORT  OR  OTHERWISE,  ARISING  FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef RAUMSERVER_REQUESTACTIONPOOL_H
+#define RAUMSERVER_REQUESTACTIONPOOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <atomic>
+#include <new>
+
+namespace Raumserver
+{
+    namespace Request
+    {
+        /**
+        * A pool of memory blocks for the request actions. Each request creates a request action which is destroyed when the request
+        * is done, so the blocks are given back to the pool and are used again by the next request instead of allocating them from the heap.
+        * The blocks are sorted in size classes, so all request action types share the pool and each type will get a block of its size class
+        */
+        class RequestActionPool
+        {
+            public:
+                /**
+                * returns the pool for all request actions. The pool is never destroyed, so request actions which are destroyed at
+                * the exit of the application (eg. in a static object) can still give back their memory
+                */
+                static RequestActionPool& getInstance()
+                {
+                    static RequestActionPool *pool = new RequestActionPool();
+                    return *pool;
+                }
+
+                void* allocate(std::size_t _size)
+                {
+                    auto sizeClass = getSizeClass(_size);
+                    if (sizeClass < SIZECLASSCOUNT)
+                    {
+                        std::lock_guard<std::mutex> lock(mutexFreeBlocks);
+                        auto block = freeBlocks[sizeClass];
+                        if (block)
+                        {
+                            freeBlocks[sizeClass] = block->next;
+                            freeBlockCount[sizeClass]--;
+                            reuseCount++;
+                            return block;
+                        }
+                    }
+                    allocationCount++;
+                    return ::operator new(sizeClass < SIZECLASSCOUNT ? (sizeClass + 1) * SIZECLASSGRANULARITY : _size);
+                }
+
+                void deallocate(void *_memory, std::size_t _size)
+                {
+                    auto sizeClass = getSizeClass(_size);
+                    if (sizeClass < SIZECLASSCOUNT)
+                    {
+                        std::lock_guard<std::mutex> lock(mutexFreeBlocks);
+                        // the pool only keeps as many blocks as there were parallel requests, a burst of requests will not stay in memory
+                        if (freeBlockCount[sizeClass] < MAXFREEBLOCKS)
+                        {
+                            auto block = static_cast<FreeBlock*>(_memory);
+                            block->next = freeBlocks[sizeClass];
+                            freeBlocks[sizeClass] = block;
+                            freeBlockCount[sizeClass]++;
+                            return;
+                        }
+                    }
+                    ::operator delete(_memory);
+                }
+
+                /**
+                * returns the count of blocks which had to be allocated from the heap
+                */
+                std::uint64_t getAllocationCount() const
+                {
+                    return allocationCount;
+                }
+
+                /**
+                * returns the count of blocks which were taken from the pool
+                */
+                std::uint64_t getReuseCount() const
+                {
+                    return reuseCount;
+                }
+
+            protected:
+                static const std::size_t SIZECLASSGRANULARITY = 256;
+                static const std::size_t SIZECLASSCOUNT = 32;
+                static const std::uint32_t MAXFREEBLOCKS = 64;
+
+                struct FreeBlock
+                {
+                    FreeBlock *next;
+                };
+
+                RequestActionPool()
+                {
+                    for (std::size_t i = 0; i < SIZECLASSCOUNT; i++)
+                    {
+                        freeBlocks[i] = nullptr;
+                        freeBlockCount[i] = 0;
+                    }
+                    allocationCount = 0;
+                    reuseCount = 0;
+                }
+
+                static std::size_t getSizeClass(std::size_t _size)
+                {
+                    return _size ? (_size - 1) / SIZECLASSGRANULARITY : 0;
+                }
+
+                std::mutex mutexFreeBlocks;
+                FreeBlock* freeBlocks[SIZECLASSCOUNT];
+                std::uint32_t freeBlockCount[SIZECLASSCOUNT];
+                std::atomic<std::uint64_t> allocationCount;
+                std::atomic<std::uint64_t> reuseCount;
+        };
+
+
+        /**
+        * An allocator which takes its memory from the request action pool. It's used with 'std::allocate_shared', so the request action
+        * and the control block of the shared pointer are one block of the pool
+        */
+        template <typename T> class RequestActionPoolAllocator
+        {
+            public:
+                typedef T value_type;
+
+                RequestActionPoolAllocator() {}
+                template <typename U> RequestActionPoolAllocator(const RequestActionPoolAllocator<U>&) {}
+
+                T* allocate(std::size_t _count)
+                {
+                    return static_cast<T*>(RequestActionPool::getInstance().allocate(_count * sizeof(T)));
+                }
+
+                void deallocate(T *_memory, std::size_t _count)
+                {
+                    RequestActionPool::getInstance().deallocate(_memory, _count * sizeof(T));
+                }
+
+                template <typename U> bool operator==(const RequestActionPoolAllocator<U>&) const
+                {
+                    return true;
+                }
+
+                template <typename U> bool operator!=(const RequestActionPoolAllocator<U>&) const
+                {
+                    return false;
+                }
+        };
+    }
+}
+
+
+#endif
@@ -0,0 +1,94 @@
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 by ChriD
+//
+// Permission is hereby granted, free of charge,  to any person obtaining a copy of
+// this software and  associated documentation  files  (the "Software"), to deal in
+// the  Software  without  restriction,  including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software,  and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this  permission notice  shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE  SOFTWARE  IS  PROVIDED  "AS IS",  WITHOUT  WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE  AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE  LIABLE FOR ANY CLAIM,  DAMAGES OR OTHER LIABILITY, WHETHER
+// IN  AN  ACTION  OF  CONTRACT,  TORT  OR  OTHERWISE,  ARISING  FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+
+#pragma once
+#ifndef RAUMSERVER_REQUESTACTIONREGISTRY_H
+#define RAUMSERVER_REQUESTACTIONREGISTRY_H
+
+#include <raumserver/request/requestAction.h>
+#include <raumserver/request/requestActionNameTable.h>
+#include <raumserver/request/requestActionPool.h>
+
+namespace Raumserver
+{
+    namespace Request
+    {
+        typedef std::shared_ptr<RequestAction>(*RequestActionFactory)(const std::string &_path, const std::string &_query);
+
+        /**
+        * the factory method for a request action class which can be registered in the request action registry
+        * The request action and the control block of the shared pointer are allocated as one block from the request action pool
+        */
+        template <typename TRequestAction> std::shared_ptr<RequestAction> createRequestAction(const std::string &_path, const std::string &_query)
+        {
+            return std::allocate_shared<TRequestAction>(RequestActionPoolAllocator<TRequestAction>(), _path, _query);
+        }
+
+        struct RequestActionRegistryEntry
+        {
+            RequestActionType type;
+            // the name of the action in upper case (the path segment of the request is compared case insensitive)
+            std::string name;
+            // a nullptr if the action type can't be requested
+            RequestActionFactory factory;
+        };
+
+        /**
+        * The registry maps the names of the request actions to their types and factories and the types back to the names
+        * Both lookups are done in constant time, the name lookup does not allocate
+        */
+        class RequestActionRegistry
+        {
+            public:
+                /**
+                * returns the registry which already contains all request actions of the library
+                */
+                EXPORT static RequestActionRegistry& getInstance();
+                /**
+                * registers a request action for a name. An already registered name will be replaced, so an application may replace
+                * a request action by a derived one or add further names. Has to be called before the webserver is started, the lookups 
+                * are not locked
+                */
+                EXPORT void registerRequestAction(RequestActionType _type, const std::string &_name, RequestActionFactory _factory);
+                /**
+                * returns the entry for a name (case insensitive) or a nullptr if the name is unknown
+                */
+                EXPORT const RequestActionRegistryEntry* findByName(const char* _name, std::size_t _length);
+                /**
+                * returns the entry for a type or a nullptr if the type is not registered
+                */
+                EXPORT const RequestActionRegistryEntry* findByType(RequestActionType _type);
+
+            protected:
+                RequestActionRegistry();
+
+                RequestActionNameTable<RequestActionRegistryEntry> entriesByName;
+                // the entries indexed by their type
+                std::vector<RequestActionRegistryEntry> entriesByType;
+        };
+    }
+}
+
+
+#endif
@@ -29,6 +29,7 @@
 #include <raumserver/json/rapidjson/rapidjson.h>
 #include <raumserver/json/rapidjson/writer.h>
 #include <raumserver/json/rapidjson/stringbuffer.h>
+#include <raumserver/json/jsonOutputStream.h>
 
 namespace Raumserver
 {
@@ -41,20 +42,44 @@ namespace Raumserver
         class RequestActionReturnable : public RequestAction
         {
             public:
-                EXPORT RequestActionReturnable(std::string _url);
-                EXPORT RequestActionReturnable(std::string _path, std::string _query);
+                EXPORT RequestActionReturnable(const std::string &_url);
+                EXPORT RequestActionReturnable(const std::string &_path, const std::string &_query);
                 EXPORT virtual ~RequestActionReturnable();
                 EXPORT virtual bool isStackable();       
                 EXPORT virtual bool isAsyncExecutionAllowed(); 
                 EXPORT std::string getResponseData();
+                /**
+                * returns the immutable buffer of the response data which may be shared with other requests
+                */
+                EXPORT std::shared_ptr<const std::string> getResponseDataBuffer();
                 EXPORT std::map<std::string, std::string> getResponseHeader();
+                /**
+                * returns true if the request is able to write its response to a stream sink while it is building it
+                */
+                EXPORT virtual bool isResponseStreamable();
+                /**
+                * sets a sink where a streamable request will write its response to instead of storing it in the response data
+                * The response header is complete when the first data is written to the sink
+                */
+                EXPORT void setResponseStreamSink(JsonOutputStreamSink _sink);
+                /**
+                * returns true if the response was written to the stream sink
+                */
+                EXPORT bool isResponseStreamed();
 
             protected:
+                /**
+                * the returnable request actions read the simulated system on their own, so they are executed as they are
+                */
+                virtual bool executeActionSimulated() override;
                 void setResponseData(const std::string &_data);
+                void setResponseDataBuffer(std::shared_ptr<const std::string> _data);
                 void addResponseHeader(const std::string &_key, const std::string &_value);
 
-                std::string responseData;
+                std::shared_ptr<const std::string> responseData;
                 std::map<std::string, std::string> responseHeader;
+                JsonOutputStreamSink responseStreamSink;
+                bool responseStreamed;
         };
     }
 }
@@ -34,16 +34,43 @@ namespace Raumserver
         class RequestActionReturnableLongPolling : public RequestActionReturnable
         {
             public:
-                EXPORT RequestActionReturnableLongPolling(std::string _url);
-                EXPORT RequestActionReturnableLongPolling(std::string _path, std::string _query);
+                EXPORT RequestActionReturnableLongPolling(const std::string &_url);
+                EXPORT RequestActionReturnableLongPolling(const std::string &_path, const std::string &_query);
                 EXPORT virtual bool isValid() override;
                 EXPORT virtual bool executeAction() override;
                 EXPORT virtual bool executeActionLongPolling();
                 EXPORT virtual ~RequestActionReturnableLongPolling();
+                /**
+                * returns the current update id of the data the request is returning
+                * This method has to be overwritten
+                */
+                EXPORT virtual std::string getLastUpdateId();
+                /**
+                * returns a key which is the same for all requests which will get the same update id 
+                * (action type and the options without 'updateId' and 'sessionId')
+                */
+                EXPORT virtual std::string getLongPollingKey();
+                /**
+                * returns the channel on which the changes of the update id will be signaled (see 'LongPollManager::notifyChannelChange')
+                * An empty channel means that the update id depends on the kernel and it will be checked on each check of the long poll manager
+                */
+                EXPORT virtual std::string getLongPollingChannel();
+                /**
+                * returns the key of the response in the response cache. All requests with the same key and update id will get the same response
+                * If the key is empty the response will not be cached
+                */
+                EXPORT virtual std::string getResponseCacheKey();
+                /**
+                * returns true if the client has provided an update id and the request will wait for a change
+                */
+                EXPORT virtual bool isLongPolling();
 
             protected:
-                virtual std::string getLastUpdateId();
                 virtual bool hasLastUpdateIdChanged();
+                /**
+                * returns the response for the current update id from the response cache or builds it with 'executeActionLongPolling'
+                */
+                bool executeActionLongPollingCached();
 
                 std::string lastUpdateId;
         };
@@ -34,16 +34,18 @@ namespace Raumserver
         class RequestActionReturnableLongPolling_GetMediaList : public RequestActionReturnableLongPolling
         {
             public:
-                EXPORT RequestActionReturnableLongPolling_GetMediaList(std::string _url);
-                EXPORT RequestActionReturnableLongPolling_GetMediaList(std::string _path, std::string _query);
+                EXPORT RequestActionReturnableLongPolling_GetMediaList(const std::string &_url);
+                EXPORT RequestActionReturnableLongPolling_GetMediaList(const std::string &_path, const std::string &_query);
                 EXPORT virtual ~RequestActionReturnableLongPolling_GetMediaList();
                 EXPORT virtual bool isValid() override;
-                EXPORT virtual bool executeActionLongPolling() override;                 
+                EXPORT virtual bool executeActionLongPolling() override;
+                EXPORT virtual std::string getLastUpdateId() override;
+                EXPORT virtual bool isResponseStreamable() override;
 
             protected:
-                virtual std::string getLastUpdateId() override;
                 virtual void onMediaListDataChanged(std::string _listId);
-                void addMediaListToJson(const std::string &_id, std::vector<std::shared_ptr<Raumkernel::Media::Item::MediaItem>> &_mediaList, rapidjson::Writer<rapidjson::StringBuffer> &_jsonWriter);
+                template <typename JsonWriter>
+                void addMediaListToJson(const std::string &_id, std::vector<std::shared_ptr<Raumkernel::Media::Item::MediaItem>> &_mediaList, JsonWriter &_jsonWriter);
 
                 std::string formatedContainerId;
                 std::atomic_bool listRetrieved;
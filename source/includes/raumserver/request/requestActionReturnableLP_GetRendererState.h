@@ -34,14 +34,15 @@ namespace Raumserver
         class RequestActionReturnableLongPolling_GetRendererState : public RequestActionReturnableLongPolling
         {
             public:
-                EXPORT RequestActionReturnableLongPolling_GetRendererState(std::string _url);
-                EXPORT RequestActionReturnableLongPolling_GetRendererState(std::string _path, std::string _query);
+                EXPORT RequestActionReturnableLongPolling_GetRendererState(const std::string &_url);
+                EXPORT RequestActionReturnableLongPolling_GetRendererState(const std::string &_path, const std::string &_query);
                 EXPORT virtual ~RequestActionReturnableLongPolling_GetRendererState();
                 EXPORT virtual bool isValid() override;
-                EXPORT virtual bool executeActionLongPolling() override;                  
+                EXPORT virtual bool executeActionLongPolling() override;
+                EXPORT virtual std::string getLastUpdateId() override;
+                EXPORT virtual std::string getResponseCacheKey() override;
 
             protected:
-                virtual std::string getLastUpdateId() override;                       
                 void addRendererStateToJson(const std::string &_zoneUDN, Raumkernel::Devices::MediaRendererState &_rendererState, Raumkernel::Devices::MediaRenderer* _mediaRenderer, rapidjson::Writer<rapidjson::StringBuffer> &_jsonWriter);                                
         };
     }
@@ -34,14 +34,14 @@ namespace Raumserver
         class RequestActionReturnableLongPolling_GetRendererTransportState : public RequestActionReturnableLongPolling
         {
             public:
-                EXPORT RequestActionReturnableLongPolling_GetRendererTransportState(std::string _url);
-                EXPORT RequestActionReturnableLongPolling_GetRendererTransportState(std::string _path, std::string _query);
+                EXPORT RequestActionReturnableLongPolling_GetRendererTransportState(const std::string &_url);
+                EXPORT RequestActionReturnableLongPolling_GetRendererTransportState(const std::string &_path, const std::string &_query);
                 EXPORT virtual ~RequestActionReturnableLongPolling_GetRendererTransportState();
                 EXPORT virtual bool isValid() override;
-                EXPORT virtual bool executeActionLongPolling() override;                 
+                EXPORT virtual bool executeActionLongPolling() override;
+                EXPORT virtual std::string getLastUpdateId() override;
 
             protected:
-                virtual std::string getLastUpdateId() override;
 
                 std::map<std::string, std::string> mapLastUpdateId;
         };
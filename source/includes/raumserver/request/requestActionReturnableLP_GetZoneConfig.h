@@ -34,14 +34,12 @@ namespace Raumserver
         class RequestActionReturnableLongPolling_GetZoneConfig : public RequestActionReturnableLongPolling
         {
             public:
-                EXPORT RequestActionReturnableLongPolling_GetZoneConfig(std::string _url);
-                EXPORT RequestActionReturnableLongPolling_GetZoneConfig(std::string _path, std::string _query);
+                EXPORT RequestActionReturnableLongPolling_GetZoneConfig(const std::string &_url);
+                EXPORT RequestActionReturnableLongPolling_GetZoneConfig(const std::string &_path, const std::string &_query);
                 EXPORT virtual bool isValid() override;
                 EXPORT virtual bool executeActionLongPolling() override;
+                EXPORT virtual std::string getLastUpdateId() override;
                 EXPORT virtual ~RequestActionReturnableLongPolling_GetZoneConfig();
-
-            protected:
-                virtual std::string getLastUpdateId() override;
         };
     }
 }
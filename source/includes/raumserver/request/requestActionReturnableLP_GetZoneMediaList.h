@@ -34,14 +34,14 @@ namespace Raumserver
         class RequestActionReturnableLongPolling_GetZoneMediaList : public RequestActionReturnableLongPolling
         {
             public:
-                EXPORT RequestActionReturnableLongPolling_GetZoneMediaList(std::string _url);
-                EXPORT RequestActionReturnableLongPolling_GetZoneMediaList(std::string _path, std::string _query);
+                EXPORT RequestActionReturnableLongPolling_GetZoneMediaList(const std::string &_url);
+                EXPORT RequestActionReturnableLongPolling_GetZoneMediaList(const std::string &_path, const std::string &_query);
                 EXPORT virtual ~RequestActionReturnableLongPolling_GetZoneMediaList();
                 EXPORT virtual bool isValid() override;
-                EXPORT virtual bool executeActionLongPolling() override;                 
+                EXPORT virtual bool executeActionLongPolling() override;
+                EXPORT virtual std::string getLastUpdateId() override;
 
             protected:
-                virtual std::string getLastUpdateId() override;
                 void addMediaListToJson(const std::string &_zoneUDN, std::vector<std::shared_ptr<Raumkernel::Media::Item::MediaItem>> &_mediaList, rapidjson::Writer<rapidjson::StringBuffer> &_jsonWriter);                
 
                 std::atomic_bool listRetrieved;
@@ -34,8 +34,8 @@ namespace Raumserver
         class RequestActionReturnable_GetVersion : public RequestActionReturnable
         {
             public:
-                EXPORT RequestActionReturnable_GetVersion(std::string _url);
-                EXPORT RequestActionReturnable_GetVersion(std::string _path, std::string _query);
+                EXPORT RequestActionReturnable_GetVersion(const std::string &_url);
+                EXPORT RequestActionReturnable_GetVersion(const std::string &_path, const std::string &_query);
                 EXPORT virtual bool isValid() override;
                 EXPORT virtual bool executeAction() override;
                 EXPORT virtual ~RequestActionReturnable_GetVersion();          
@@ -34,8 +34,8 @@ namespace Raumserver
         class RequestAction_Crash : public RequestAction
         {
             public:                
-                EXPORT RequestAction_Crash(std::string _url);
-                EXPORT RequestAction_Crash(std::string _path, std::string _query);
+                EXPORT RequestAction_Crash(const std::string &_url);
+                EXPORT RequestAction_Crash(const std::string &_path, const std::string &_query);
                 EXPORT virtual ~RequestAction_Crash();
                 EXPORT virtual bool executeAction() override;
                 EXPORT virtual bool isValid() override;
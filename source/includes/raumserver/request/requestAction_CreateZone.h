@@ -34,11 +34,19 @@ namespace Raumserver
         class RequestAction_CreateZone : public RequestAction
         {
             public:
-                EXPORT RequestAction_CreateZone(std::string _url);
-                EXPORT RequestAction_CreateZone(std::string _path, std::string _query);
+                EXPORT RequestAction_CreateZone(const std::string &_url);
+                EXPORT RequestAction_CreateZone(const std::string &_path, const std::string &_query);
                 EXPORT virtual ~RequestAction_CreateZone();
                 EXPORT virtual bool executeAction() override;
                 EXPORT virtual bool isValid() override;
+                /**
+                * changing the zones will affect more than one lane, so the request has to be executed when all lanes are idle
+                */
+                EXPORT virtual std::string getExecutionLaneId() override;
+                /**
+                * the request waits till the kernel has applied the new zones, so it can't run while someone else holds the manager locks
+                */
+                EXPORT virtual bool isManagerLockSharable() override;
      
             protected:                           
         };
@@ -34,8 +34,8 @@ namespace Raumserver
         class RequestAction_EnterAutomaticStandby : public RequestAction
         {
             public:
-                EXPORT RequestAction_EnterAutomaticStandby(std::string _url);
-                EXPORT RequestAction_EnterAutomaticStandby(std::string _path, std::string _query);
+                EXPORT RequestAction_EnterAutomaticStandby(const std::string &_url);
+                EXPORT RequestAction_EnterAutomaticStandby(const std::string &_path, const std::string &_query);
                 EXPORT virtual ~RequestAction_EnterAutomaticStandby();
                 EXPORT virtual bool executeAction() override;
                 EXPORT virtual bool isValid() override;
@@ -34,8 +34,8 @@ namespace Raumserver
         class RequestAction_EnterManualStandby : public RequestAction
         {
             public:
-                EXPORT RequestAction_EnterManualStandby(std::string _url);
-                EXPORT RequestAction_EnterManualStandby(std::string _path, std::string _query);
+                EXPORT RequestAction_EnterManualStandby(const std::string &_url);
+                EXPORT RequestAction_EnterManualStandby(const std::string &_path, const std::string &_query);
                 EXPORT virtual ~RequestAction_EnterManualStandby();
                 EXPORT virtual bool executeAction() override;
                 EXPORT virtual bool isValid() override;
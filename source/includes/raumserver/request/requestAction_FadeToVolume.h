@@ -34,8 +34,8 @@ namespace Raumserver
         class RequestAction_FadeToVolume : public RequestAction
         {
             public:                
-                EXPORT RequestAction_FadeToVolume(std::string _url);
-                EXPORT RequestAction_FadeToVolume(std::string _path, std::string _query);
+                EXPORT RequestAction_FadeToVolume(const std::string &_url);
+                EXPORT RequestAction_FadeToVolume(const std::string &_path, const std::string &_query);
                 EXPORT virtual ~RequestAction_FadeToVolume();
                 EXPORT virtual bool executeAction() override;
                 EXPORT virtual bool isValid() override;
@@ -34,8 +34,8 @@ namespace Raumserver
         class RequestAction_KillSession : public RequestAction
         {
             public:
-                EXPORT RequestAction_KillSession(std::string _url);
-                EXPORT RequestAction_KillSession(std::string _path, std::string _query);
+                EXPORT RequestAction_KillSession(const std::string &_url);
+                EXPORT RequestAction_KillSession(const std::string &_path, const std::string &_query);
                 EXPORT virtual ~RequestAction_KillSession();
                 EXPORT virtual bool executeAction() override;
                 EXPORT virtual bool isValid() override;
@@ -34,8 +34,8 @@ namespace Raumserver
         class RequestAction_LeaveStandby : public RequestAction
         {
             public:
-                EXPORT RequestAction_LeaveStandby(std::string _url);
-                EXPORT RequestAction_LeaveStandby(std::string _path, std::string _query);
+                EXPORT RequestAction_LeaveStandby(const std::string &_url);
+                EXPORT RequestAction_LeaveStandby(const std::string &_path, const std::string &_query);
                 EXPORT virtual ~RequestAction_LeaveStandby();
                 EXPORT virtual bool executeAction() override;
                 EXPORT virtual bool isValid() override;
@@ -34,8 +34,8 @@ namespace Raumserver
         class RequestAction_LoadContainer : public RequestAction
         {
             public:                
-                EXPORT RequestAction_LoadContainer(std::string _url);
-                EXPORT RequestAction_LoadContainer(std::string _path, std::string _query);
+                EXPORT RequestAction_LoadContainer(const std::string &_url);
+                EXPORT RequestAction_LoadContainer(const std::string &_path, const std::string &_query);
                 EXPORT virtual ~RequestAction_LoadContainer();
                 EXPORT virtual bool executeAction() override;
                 EXPORT virtual bool isValid() override;
@@ -34,8 +34,8 @@ namespace Raumserver
         class RequestAction_LoadPlaylist : public RequestAction
         {
             public:                
-                EXPORT RequestAction_LoadPlaylist(std::string _url);
-                EXPORT RequestAction_LoadPlaylist(std::string _path, std::string _query);
+                EXPORT RequestAction_LoadPlaylist(const std::string &_url);
+                EXPORT RequestAction_LoadPlaylist(const std::string &_path, const std::string &_query);
                 EXPORT virtual ~RequestAction_LoadPlaylist();
                 EXPORT virtual bool executeAction() override;
                 EXPORT virtual bool isValid() override;
@@ -34,8 +34,8 @@ namespace Raumserver
         class RequestAction_LoadShuffle : public RequestAction
         {
             public:                
-                EXPORT RequestAction_LoadShuffle(std::string _url);
-                EXPORT RequestAction_LoadShuffle(std::string _path, std::string _query);
+                EXPORT RequestAction_LoadShuffle(const std::string &_url);
+                EXPORT RequestAction_LoadShuffle(const std::string &_path, const std::string &_query);
                 EXPORT virtual ~RequestAction_LoadShuffle();
                 EXPORT virtual bool executeAction() override;
                 EXPORT virtual bool isValid() override;
@@ -34,8 +34,8 @@ namespace Raumserver
         class RequestAction_LoadUri : public RequestAction
         {
             public:                
-                EXPORT RequestAction_LoadUri(std::string _url);
-                EXPORT RequestAction_LoadUri(std::string _path, std::string _query);
+                EXPORT RequestAction_LoadUri(const std::string &_url);
+                EXPORT RequestAction_LoadUri(const std::string &_path, const std::string &_query);
                 EXPORT virtual ~RequestAction_LoadUri();
                 EXPORT virtual bool executeAction() override;
                 EXPORT virtual bool isValid() override;
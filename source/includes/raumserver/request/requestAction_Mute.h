@@ -34,8 +34,8 @@ namespace Raumserver
         class RequestAction_Mute : public RequestAction
         {
             public:                
-                EXPORT RequestAction_Mute(std::string _url);
-                EXPORT RequestAction_Mute(std::string _path, std::string _query);
+                EXPORT RequestAction_Mute(const std::string &_url);
+                EXPORT RequestAction_Mute(const std::string &_path, const std::string &_query);
                 EXPORT virtual ~RequestAction_Mute();
                 EXPORT virtual bool executeAction() override;
                 EXPORT virtual bool isValid() override;
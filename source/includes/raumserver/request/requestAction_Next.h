@@ -34,8 +34,8 @@ namespace Raumserver
         class RequestAction_Next : public RequestAction
         {
             public:                
-                EXPORT RequestAction_Next(std::string _url);
-                EXPORT RequestAction_Next(std::string _path, std::string _query);
+                EXPORT RequestAction_Next(const std::string &_url);
+                EXPORT RequestAction_Next(const std::string &_path, const std::string &_query);
                 EXPORT virtual ~RequestAction_Next();
                 EXPORT virtual bool executeAction() override;
                 EXPORT virtual bool isValid() override;
@@ -34,8 +34,8 @@ namespace Raumserver
         class RequestAction_Pause : public RequestAction
         {
             public:
-                EXPORT RequestAction_Pause(std::string _url);
-                EXPORT RequestAction_Pause(std::string _path, std::string _query);
+                EXPORT RequestAction_Pause(const std::string &_url);
+                EXPORT RequestAction_Pause(const std::string &_path, const std::string &_query);
                 EXPORT virtual ~RequestAction_Pause();
                 EXPORT virtual bool executeAction() override;
                 EXPORT virtual bool isValid() override;
@@ -34,8 +34,8 @@ namespace Raumserver
         class RequestAction_Play : public RequestAction
         {
             public:                
-                EXPORT RequestAction_Play(std::string _url);
-                EXPORT RequestAction_Play(std::string _path, std::string _query);
+                EXPORT RequestAction_Play(const std::string &_url);
+                EXPORT RequestAction_Play(const std::string &_path, const std::string &_query);
                 EXPORT virtual ~RequestAction_Play();
                 EXPORT virtual bool executeAction() override;
                 EXPORT virtual bool isValid() override;
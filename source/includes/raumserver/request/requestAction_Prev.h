@@ -34,8 +34,8 @@ namespace Raumserver
         class RequestAction_Prev : public RequestAction
         {
             public:                
-                EXPORT RequestAction_Prev(std::string _url);
-                EXPORT RequestAction_Prev(std::string _path, std::string _query);
+                EXPORT RequestAction_Prev(const std::string &_url);
+                EXPORT RequestAction_Prev(const std::string &_path, const std::string &_query);
                 EXPORT virtual ~RequestAction_Prev();
                 EXPORT virtual bool executeAction() override;
                 EXPORT virtual bool isValid() override;
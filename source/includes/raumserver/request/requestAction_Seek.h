@@ -34,13 +34,18 @@ namespace Raumserver
         class RequestAction_Seek : public RequestAction
         {
             public:                
-                EXPORT RequestAction_Seek(std::string _url);
-                EXPORT RequestAction_Seek(std::string _path, std::string _query);
+                EXPORT RequestAction_Seek(const std::string &_url);
+                EXPORT RequestAction_Seek(const std::string &_path, const std::string &_query);
                 EXPORT virtual ~RequestAction_Seek();
                 EXPORT virtual bool executeAction() override;
                 EXPORT virtual bool isValid() override;
+                /**
+                * the latest absolute or track seek wins, relative seeks will be summed up
+                */
+                EXPORT virtual std::shared_ptr<RequestAction> createMergedRequestAction(std::shared_ptr<RequestAction> _requestAction) override;
 
             protected:
+                bool isRelativeSeek();
         };
     }
 }
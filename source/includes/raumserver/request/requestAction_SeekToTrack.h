@@ -34,8 +34,8 @@ namespace Raumserver
         class RequestAction_SeekToTrack : public RequestAction
         {
             public:                
-                EXPORT RequestAction_SeekToTrack(std::string _url);
-                EXPORT RequestAction_SeekToTrack(std::string _path, std::string _query);
+                EXPORT RequestAction_SeekToTrack(const std::string &_url);
+                EXPORT RequestAction_SeekToTrack(const std::string &_path, const std::string &_query);
                 EXPORT virtual ~RequestAction_SeekToTrack();
                 EXPORT virtual bool executeAction() override;
                 EXPORT virtual bool isValid() override;
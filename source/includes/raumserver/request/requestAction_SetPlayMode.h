@@ -34,8 +34,8 @@ namespace Raumserver
         class RequestAction_SetPlayMode : public RequestAction
         {
             public:                
-                EXPORT RequestAction_SetPlayMode(std::string _url);
-                EXPORT RequestAction_SetPlayMode(std::string _path, std::string _query);
+                EXPORT RequestAction_SetPlayMode(const std::string &_url);
+                EXPORT RequestAction_SetPlayMode(const std::string &_path, const std::string &_query);
                 EXPORT virtual ~RequestAction_SetPlayMode();
                 EXPORT virtual bool executeAction() override;
                 EXPORT virtual bool isValid() override;
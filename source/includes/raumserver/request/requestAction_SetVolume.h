@@ -34,11 +34,12 @@ namespace Raumserver
         class RequestAction_SetVolume : public RequestAction
         {
             public:                
-                EXPORT RequestAction_SetVolume(std::string _url);
-                EXPORT RequestAction_SetVolume(std::string _path, std::string _query);
+                EXPORT RequestAction_SetVolume(const std::string &_url);
+                EXPORT RequestAction_SetVolume(const std::string &_path, const std::string &_query);
                 EXPORT virtual ~RequestAction_SetVolume();
                 EXPORT virtual bool executeAction() override;
                 EXPORT virtual bool isValid() override;
+                EXPORT virtual bool getVolumeChange(bool &_relative, std::int32_t &_value) override;
 
             protected:
         };
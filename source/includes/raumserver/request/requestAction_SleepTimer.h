@@ -34,8 +34,8 @@ namespace Raumserver
         class RequestAction_SleepTimer : public RequestAction
         {
             public:                
-                EXPORT RequestAction_SleepTimer(std::string _url);
-                EXPORT RequestAction_SleepTimer(std::string _path, std::string _query);
+                EXPORT RequestAction_SleepTimer(const std::string &_url);
+                EXPORT RequestAction_SleepTimer(const std::string &_path, const std::string &_query);
                 EXPORT virtual ~RequestAction_SleepTimer();
                 EXPORT virtual bool executeAction() override;
                 EXPORT virtual bool isValid() override;
@@ -34,8 +34,8 @@ namespace Raumserver
         class RequestAction_ToggleMute : public RequestAction
         {
             public:                
-                EXPORT RequestAction_ToggleMute(std::string _url);
-                EXPORT RequestAction_ToggleMute(std::string _path, std::string _query);
+                EXPORT RequestAction_ToggleMute(const std::string &_url);
+                EXPORT RequestAction_ToggleMute(const std::string &_path, const std::string &_query);
                 EXPORT virtual ~RequestAction_ToggleMute();
                 EXPORT virtual bool executeAction() override;
                 EXPORT virtual bool isValid() override;
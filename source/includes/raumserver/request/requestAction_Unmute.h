@@ -34,8 +34,8 @@ namespace Raumserver
         class RequestAction_Unmute : public RequestAction
         {
             public:                
-                EXPORT RequestAction_Unmute(std::string _url);
-                EXPORT RequestAction_Unmute(std::string _path, std::string _query);
+                EXPORT RequestAction_Unmute(const std::string &_url);
+                EXPORT RequestAction_Unmute(const std::string &_path, const std::string &_query);
                 EXPORT virtual ~RequestAction_Unmute();
                 EXPORT virtual bool executeAction() override;
                 EXPORT virtual bool isValid() override;
@@ -34,11 +34,12 @@ namespace Raumserver
         class RequestAction_VolumeDown : public RequestAction
         {
             public:                
-                EXPORT RequestAction_VolumeDown(std::string _url);
-                EXPORT RequestAction_VolumeDown(std::string _path, std::string _query);
+                EXPORT RequestAction_VolumeDown(const std::string &_url);
+                EXPORT RequestAction_VolumeDown(const std::string &_path, const std::string &_query);
                 EXPORT virtual ~RequestAction_VolumeDown();
                 EXPORT virtual bool executeAction() override;
                 EXPORT virtual bool isValid() override;
+                EXPORT virtual bool getVolumeChange(bool &_relative, std::int32_t &_value) override;
 
             protected:
         };
@@ -34,11 +34,12 @@ namespace Raumserver
         class RequestAction_VolumeUp : public RequestAction
         {
             public:                
-                EXPORT RequestAction_VolumeUp(std::string _url);
-                EXPORT RequestAction_VolumeUp(std::string _path, std::string _query);
+                EXPORT RequestAction_VolumeUp(const std::string &_url);
+                EXPORT RequestAction_VolumeUp(const std::string &_path, const std::string &_query);
                 EXPORT virtual ~RequestAction_VolumeUp();
                 EXPORT virtual bool executeAction() override;
                 EXPORT virtual bool isValid() override;
+                EXPORT virtual bool getVolumeChange(bool &_relative, std::int32_t &_value) override;
 
             protected:
         };
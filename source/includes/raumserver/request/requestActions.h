@@ -61,5 +61,6 @@
 #include <raumserver/request/requestActionReturnableLP_GetZoneMediaList.h>
 #include <raumserver/request/requestActionReturnableLP_GetRendererState.h>
 #include <raumserver/request/requestActionReturnableLP_GetRendererTransportState.h>
+#include <raumserver/request/requestActionReturnableLP_GetRequestStatus.h>
 
 #endif
\ No newline at end of file
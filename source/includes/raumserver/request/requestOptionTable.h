@@ -0,0 +1,273 @@
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 by ChriD
+//
+// Permission is hereby granted, free of charge,  to any person obtaining a copy of
+// this software and  associated documentation  files  (the "Software"), to deal in
+// the  Software  without  restriction,  including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software,  and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this  permission notice  shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE  SOFTWARE  IS  PROVIDED  "AS IS",  WITHOUT  WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE  AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE  LIABLE FOR ANY CLAIM,  DAMAGES OR OTHER LIABILITY, WHETHER
+// IN  AN  ACTION  OF  CONTRACT,  TORT  OR  OTHERWISE,  ARISING  FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+
+#pragma once
+#ifndef RAUMSERVER_REQUESTOPTIONTABLE_H
+#define RAUMSERVER_REQUESTOPTIONTABLE_H
+
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include <memory>
+
+namespace Raumserver
+{
+    namespace Request
+    {
+        /**
+        * A view on a key or a value of the option table. It is only valid till the table is changed
+        */
+        struct RequestOptionValue
+        {
+            RequestOptionValue() : data(""), length(0) {}
+            RequestOptionValue(const char* _data, std::size_t _length) : data(_data), length(_length) {}
+
+            bool empty() const
+            {
+                return length == 0;
+            }
+
+            bool equals(const char* _other) const
+            {
+                return std::strlen(_other) == length && std::memcmp(data, _other, length) == 0;
+            }
+
+            bool equals(const RequestOptionValue &_other) const
+            {
+                return _other.length == length && std::memcmp(data, _other.data, length) == 0;
+            }
+
+            /**
+            * compares the value case insensitive with a lower case string
+            */
+            bool equalsLowerCase(const char* _other) const
+            {
+                if (std::strlen(_other) != length)
+                    return false;
+                for (std::size_t i = 0; i < length; i++)
+                {
+                    char valueChar = (data[i] >= 'A' && data[i] <= 'Z') ? (char)(data[i] + ('a' - 'A')) : data[i];
+                    if (valueChar != _other[i])
+                        return false;
+                }
+                return true;
+            }
+
+            /**
+            * returns the leading integer of the value (like 'atoi'), 0 if there is none
+            */
+            std::int32_t toInt32() const
+            {
+                std::size_t pos = 0;
+                while (pos < length && (data[pos] == ' ' || data[pos] == '\t'))
+                    pos++;
+                bool negative = pos < length && data[pos] == '-';
+                if (pos < length && (data[pos] == '-' || data[pos] == '+'))
+                    pos++;
+                std::int64_t value = 0;
+                for (; pos < length && data[pos] >= '0' && data[pos] <= '9' && value <= INT32_MAX; pos++)
+                    value = value * 10 + (data[pos] - '0');
+                if (value > INT32_MAX)
+                    value = INT32_MAX;
+                return (std::int32_t)(negative ? -value : value);
+            }
+
+            std::string toString() const
+            {
+                return std::string(data, length);
+            }
+
+            const char* data;
+            std::size_t length;
+        };
+
+
+        /**
+        * A small flat table for the options of a request. All keys and values are stored in one buffer which keeps its capacity when
+        * the options are parsed again, so parsing and looking up the options does not allocate after the first request.
+        * The keys are stored in lower case and the values unescaped, so this is only done once when the query is parsed.
+        * A request has only a few options, so a linear search is faster than any hashing.
+        * The allocator of the buffer may be given, so a request action can keep its options in its own arena
+        */
+        template <typename TAllocator = std::allocator<char>> class BasicRequestOptionTable
+        {
+            public:
+                BasicRequestOptionTable(const TAllocator &_allocator = TAllocator()) : buffer(_allocator), entries(EntryAllocator(_allocator))
+                {
+                    buffer.reserve(256);
+                    entries.reserve(8);
+                }
+
+                void clear()
+                {
+                    buffer.clear();
+                    entries.clear();
+                }
+
+                /**
+                * parses a query string like 'id=Kitchen&value=25' and adds the options. The keys are case insensitive, a key which was 
+                * already added will be replaced
+                */
+                void parseQuery(const char* _query, std::size_t _length)
+                {
+                    std::size_t pos = 0;
+                    while (pos < _length)
+                    {
+                        std::size_t end = pos;
+                        while (end < _length && _query[end] != '&')
+                            end++;
+                        std::size_t separator = pos;
+                        while (separator < end && _query[separator] != '=')
+                            separator++;
+
+                        if (separator > pos)
+                        {
+                            auto keyOffset = buffer.length();
+                            appendUnescaped(_query + pos, separator - pos, true);
+                            auto valueOffset = buffer.length();
+                            if (separator < end)
+                                appendUnescaped(_query + separator + 1, end - separator - 1, false);
+                            addEntry(keyOffset, valueOffset - keyOffset, valueOffset, buffer.length() - valueOffset);
+                        }
+                        pos = end + 1;
+                    }
+                }
+
+                /**
+                * adds an option. A key which was already added will be replaced
+                */
+                void setOption(const std::string &_key, const std::string &_value)
+                {
+                    auto keyOffset = buffer.length();
+                    for (auto keyChar : _key)
+                        buffer.push_back(toLower(keyChar));
+                    auto valueOffset = buffer.length();
+                    buffer.append(_value.c_str(), _value.length());
+                    addEntry(keyOffset, valueOffset - keyOffset, valueOffset, _value.length());
+                }
+
+                /**
+                * looks up the value for the key (case insensitive). Returns false if the option is not existent
+                */
+                bool find(const char* _key, std::size_t _length, RequestOptionValue &_value) const
+                {
+                    auto index = findIndex(_key, _length);
+                    if (index == entries.size())
+                        return false;
+                    _value = getValue(index);
+                    return true;
+                }
+
+                std::size_t size() const
+                {
+                    return entries.size();
+                }
+
+                RequestOptionValue getKey(std::size_t _index) const
+                {
+                    return RequestOptionValue(buffer.data() + entries[_index].keyOffset, entries[_index].keyLength);
+                }
+
+                RequestOptionValue getValue(std::size_t _index) const
+                {
+                    return RequestOptionValue(buffer.data() + entries[_index].valueOffset, entries[_index].valueLength);
+                }
+
+            protected:
+                struct Entry
+                {
+                    std::uint32_t keyOffset;
+                    std::uint32_t keyLength;
+                    std::uint32_t valueOffset;
+                    std::uint32_t valueLength;
+                };
+
+                static char toLower(char _char)
+                {
+                    return (_char >= 'A' && _char <= 'Z') ? (char)(_char + ('a' - 'A')) : _char;
+                }
+
+                static int hexValue(char _char)
+                {
+                    if (_char >= '0' && _char <= '9') return _char - '0';
+                    if (_char >= 'a' && _char <= 'f') return _char - 'a' + 10;
+                    if (_char >= 'A' && _char <= 'F') return _char - 'A' + 10;
+                    return -1;
+                }
+
+                void appendUnescaped(const char* _data, std::size_t _length, bool _lowerCase)
+                {
+                    for (std::size_t i = 0; i < _length; i++)
+                    {
+                        char decodedChar = _data[i];
+                        if (decodedChar == '%' && i + 2 < _length && hexValue(_data[i + 1]) >= 0 && hexValue(_data[i + 2]) >= 0)
+                        {
+                            decodedChar = (char)(hexValue(_data[i + 1]) * 16 + hexValue(_data[i + 2]));
+                            i += 2;
+                        }
+                        buffer.push_back(_lowerCase ? toLower(decodedChar) : decodedChar);
+                    }
+                }
+
+                std::size_t findIndex(const char* _key, std::size_t _length) const
+                {
+                    for (std::size_t index = 0; index < entries.size(); index++)
+                    {
+                        if (entries[index].keyLength != _length)
+                            continue;
+                        const char* key = buffer.data() + entries[index].keyOffset;
+                        std::size_t i = 0;
+                        while (i < _length && key[i] == toLower(_key[i]))
+                            i++;
+                        if (i == _length)
+                            return index;
+                    }
+                    return entries.size();
+                }
+
+                void addEntry(std::size_t _keyOffset, std::size_t _keyLength, std::size_t _valueOffset, std::size_t _valueLength)
+                {
+                    Entry entry = { (std::uint32_t)_keyOffset, (std::uint32_t)_keyLength, (std::uint32_t)_valueOffset, (std::uint32_t)_valueLength };
+                    // the key is already lower case in the buffer, the replaced data will stay in the buffer till the table is cleared
+                    auto index = findIndex(buffer.data() + _keyOffset, _keyLength);
+                    if (index == entries.size())
+                        entries.push_back(entry);
+                    else
+                        entries[index] = entry;
+                }
+
+                // the keys and values of all options
+                typedef typename std::allocator_traits<TAllocator>::template rebind_alloc<Entry> EntryAllocator;
+
+                std::basic_string<char, std::char_traits<char>, TAllocator> buffer;
+                std::vector<Entry, EntryAllocator> entries;
+        };
+
+        typedef BasicRequestOptionTable<> RequestOptionTable;
+    }
+}
+
+
+#endif
@@ -0,0 +1,101 @@
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2016 by ChriD
+//
+// Permission is hereby granted, free of charge,  to any person obtaining a copy of
+// this software and  associated documentation  files  (the "Software"), to deal in
+// the  Software  without  restriction,  including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software,  and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this  permission notice  shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE  SOFTWARE  IS  PROVIDED  "AS IS",  WITHOUT  WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE  AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE  LIABLE FOR ANY CLAIM,  DAMAGES OR OTHER LIABILITY, WHETHER
+// IN  AN  ACTION  OF  CONTRACT,  TORT  OR  OTHERWISE,  ARISING  FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef RAUMSERVER_RESPONSECOMPRESSION_H
+#define RAUMSERVER_RESPONSECOMPRESSION_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstring>
+#include <raumserver/raumserverBase.h>
+#include <raumserver/json/jsonOutputStream.h>
+
+#ifdef USE_ZLIB
+    #include <zlib.h>
+#endif
+
+
+namespace Raumserver
+{
+    namespace Server
+    {
+        enum class ContentEncoding { CE_NONE, CE_GZIP, CE_DEFLATE };
+
+
+        /**
+        * Compression of the responses with gzip or deflate. This is only available if the server is built with 'USE_ZLIB', 
+        * otherwise the responses will always be sent uncompressed
+        */
+        class ResponseCompression
+        {
+            public:
+                /**
+                * returns the best encoding the client accepts with its 'Accept-Encoding' header
+                */
+                EXPORT static ContentEncoding getAcceptedEncoding(const char* _acceptEncoding);
+                /**
+                * returns the value of the 'Content-Encoding' header for the encoding
+                */
+                EXPORT static std::string contentEncodingToString(ContentEncoding _encoding);
+                /**
+                * compresses the data with the given encoding and level (1-9). Returns false if the compression failed
+                */
+                EXPORT static bool compress(const std::string &_data, ContentEncoding _encoding, int _level, std::string &_compressedData);
+        };
+
+
+        /**
+        * Compresses the data which is written to it and passes the compressed data in blocks of a fixed size to a sink (eg. the chunks of a response)
+        * So data of any size can be compressed with a constant amount of memory.
+        */
+        class ResponseCompressionStream
+        {
+            public:
+                EXPORT ResponseCompressionStream(ContentEncoding _encoding, int _level, JsonOutputStreamSink _sink, std::size_t _bufferSize = 16384);
+                EXPORT virtual ~ResponseCompressionStream();
+                /**
+                * compresses the data. Returns false if the compression or the sink has failed
+                */
+                EXPORT bool write(const char* _data, std::size_t _length);
+                /**
+                * writes the remaining compressed data to the sink. No data may be written after this
+                */
+                EXPORT bool finish();
+
+            protected:
+                JsonOutputStreamSink sink;
+                std::vector<char> buffer;
+                bool initialized;
+                bool failed;
+                #ifdef USE_ZLIB
+                    z_stream stream;
+                    bool deflateData(int _flush);
+                #endif
+        };
+    }
+}
+
+
+#endif
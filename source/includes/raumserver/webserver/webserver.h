@@ -27,16 +27,28 @@
 
 #include <thread>
 #include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <unordered_map>
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <tuple>
 
 #include <raumkernel/raumkernel.h>
 #include <raumserver/request/requestAction.h>
+#include <raumserver/request/requestActionReturnableLP.h>
+#include <raumserver/request/requestActionBatch.h>
 #include <raumserver/raumserverBase.h>
 #include <raumserver/manager/managerEngineerServer.h>
 #include <raumserver/webserver/civetweb/civetServer.h>
+#include <raumserver/webserver/responseCompression.h>
 
 #include <raumserver/json/rapidjson/rapidjson.h>
 #include <raumserver/json/rapidjson/writer.h>
 #include <raumserver/json/rapidjson/stringbuffer.h>
+#include <raumserver/json/rapidjson/document.h>
 
 #define DOCUMENT_ROOT "docroot"
 
@@ -50,19 +62,96 @@ namespace Raumserver
         class RequestHandlerBase : public CivetHandler
         {
             public:
+                EXPORT RequestHandlerBase();
                 EXPORT void setManagerEngineerServer(std::shared_ptr<Manager::ManagerEngineerServer> _managerEngineer);
                 EXPORT void setManagerEngineerKernel(std::shared_ptr<Raumkernel::Manager::ManagerEngineer> _managerEngineer);
                 EXPORT void setLogObject(std::shared_ptr<Raumkernel::Log::Log> _logObject);               
+                /**
+                * if keep alive is enabled the responses will tell the client to keep the connection open for the next requests
+                */
+                EXPORT void setKeepAlive(bool _keepAlive);
+                /**
+                * sets the compression level (1-9, 0 disables compression) and the minimum size of the data responses which will be compressed
+                * when the client accepts it
+                */
+                EXPORT void setCompression(std::int32_t _level, std::uint32_t _minSize);
                 EXPORT std::shared_ptr<Manager::ManagerEngineerServer> getManagerEngineerServer();
                 EXPORT std::shared_ptr<Raumkernel::Manager::ManagerEngineer> getManagerEngineerKernel();
                 EXPORT std::shared_ptr<Raumkernel::Log::Log> getLogObject();
             protected:
                 virtual std::string buildCorsHeader(std::map<std::string, std::string>* _headerVars = nullptr);
                 virtual void sendResponse(struct mg_connection *_conn, std::string _string, bool _error = false, Request::RequestAction * _reqAction = nullptr);
-                virtual void sendDataResponse(struct mg_connection *_conn, std::string _string, std::map<std::string, std::string> _headerVars = std::map<std::string, std::string>(), bool _error = false, Request::RequestAction * _reqAction = nullptr);
+                virtual void sendDataResponse(struct mg_connection *_conn, const std::string &_string, std::map<std::string, std::string> _headerVars = std::map<std::string, std::string>(), bool _error = false, Request::RequestAction * _reqAction = nullptr, const std::string &_contentEncoding = "");
+                /**
+                * sends the data of the returnable request. The data will be compressed with the given encoding if it is big enough
+                */
+                virtual void sendReturnableDataResponse(struct mg_connection *_conn, std::shared_ptr<Request::RequestActionReturnable> _requestAction, ContentEncoding _encoding);
+                /**
+                * returns the encoding for the data responses to the client (depending on its 'Accept-Encoding' header)
+                */
+                virtual ContentEncoding getResponseEncoding(struct mg_connection *_conn);
+                /**
+                * returns the encoded data of the request. If the data is in the response cache the encoded data will be cached too, so
+                * all requests which will get the same data will get the same encoded data. Returns a nullptr if the encoding failed
+                */
+                virtual std::shared_ptr<const std::string> getEncodedResponseData(std::shared_ptr<Request::RequestActionReturnable> _requestAction, std::shared_ptr<const std::string> _data, ContentEncoding _encoding);
+                /**
+                * writes a http response with the given status and header lines. The 'Content-Length' and 'Connection' header will be added
+                */
+                virtual void sendHttpResponse(struct mg_connection *_conn, const std::string &_status, const std::string &_headers, const std::string &_body);
+                /**
+                * returns true if the connection will be kept open by the webserver after the response was sent
+                */
+                virtual bool isKeepAliveConnection(struct mg_connection *_conn);
+                /**
+                * returns the header lines for a data response (content type, cors, the header vars of the request, ETag and cache control)
+                */
+                virtual std::string buildDataResponseHeader(std::map<std::string, std::string> &_headerVars, bool _error, const std::string &_contentEncoding = "");
+                /**
+                * returns true if the client is able to receive a response with 'Transfer-Encoding: chunked'
+                */
+                virtual bool isChunkedResponseAllowed(struct mg_connection *_conn);
+                /**
+                * writes the header of a data response whose body will be sent in chunks with 'sendChunk' and ended with 'sendChunkedResponseEnd'
+                */
+                virtual void sendChunkedResponseBegin(struct mg_connection *_conn, std::map<std::string, std::string> _headerVars, const std::string &_contentEncoding = "");
+                virtual bool sendChunk(struct mg_connection *_conn, const char* _data, std::size_t _length);
+                virtual void sendChunkedResponseEnd(struct mg_connection *_conn);
+                /**
+                * sends a '304 Not Modified' response for the given ETag without any data
+                */
+                virtual void sendNotModifiedResponse(struct mg_connection *_conn, const std::string &_eTag);
+                /**
+                * returns the ETag for the update id of a data request
+                */
+                virtual std::string buildETag(const std::string &_updateId);
+                /**
+                * returns true if the 'If-None-Match' header of the request contains the given ETag
+                */
+                virtual bool isETagMatching(struct mg_connection *_conn, const std::string &_eTag);
+                /**
+                * sends the response for a cors preflight request (an OPTIONS request of a browser before it posts data)
+                */
+                virtual void sendPreflightResponse(struct mg_connection *_conn);
+                /**
+                * reads the body of a request (eg. a POST). Returns false if the body could not be read or is bigger than the given size
+                */
+                virtual bool readRequestBody(struct mg_connection *_conn, std::string &_body, std::size_t _maxSize = 1024 * 1024);
+                /**
+                * creates the long polling request action which will provide the data for a push topic
+                * (eg. 'rendererState:<zone>', 'zoneConfig' or 'zoneMediaList:<zone>')
+                */
+                virtual std::shared_ptr<Request::RequestActionReturnableLongPolling> createRequestActionForTopic(const std::string &_topic);
+                /**
+                * counts an error response in the metrics of the server
+                */
+                virtual void addErrorMetrics();
                 std::shared_ptr<Manager::ManagerEngineerServer> managerEngineerServer;
                 std::shared_ptr<Raumkernel::Manager::ManagerEngineer> managerEngineerKernel;
                 std::shared_ptr<Raumkernel::Log::Log> logObject;                
+                bool keepAlive;
+                std::int32_t compressionLevel;
+                std::uint32_t compressionMinSize;
         };
 
 
@@ -71,7 +160,17 @@ namespace Raumserver
         {
             public:
                 bool handleGet(CivetServer *_server, struct mg_connection *_conn) override;  
+                /**
+                * the options of the request may be posted as json object (eg. {"id":"Kitchen","value":"http://..."})
+                */
+                bool handlePost(CivetServer *_server, struct mg_connection *_conn) override;
                 bool handleOptions(CivetServer *_server, struct mg_connection *_conn) override;
+
+            protected:
+                /**
+                * creates the request action for the request and executes or queues it. The json options are empty for requests without a body
+                */
+                virtual bool handleRequest(CivetServer *_server, struct mg_connection *_conn, std::string _jsonOptions);
         };
 
 
@@ -79,10 +178,240 @@ namespace Raumserver
         {
             public:
                 bool handleGet(CivetServer *_server, struct mg_connection *_conn) override;   
+                bool handlePost(CivetServer *_server, struct mg_connection *_conn) override;
                 bool handleOptions(CivetServer *_server, struct mg_connection *_conn) override;
         };
 
 
+        /**
+        * The batch handler executes several controller actions which are posted as json array in one round trip
+        * eg. POST /raumserver/batch?mode=parallel&stopOnError=true with [{"action":"setVolume","options":{"id":"Kitchen","value":30}},{"action":"play","options":{"id":"Kitchen"}}]
+        */
+        class RequestHandlerBatch : public RequestHandlerBase
+        {
+            public:
+                bool handlePost(CivetServer *_server, struct mg_connection *_conn) override;
+                bool handleOptions(CivetServer *_server, struct mg_connection *_conn) override;
+        };
+
+
+        /**
+        * returns the recorded spans of the requests as Chrome trace event json ('/raumserver/data/trace?seconds=10')
+        */
+        class RequestHandlerTrace : public RequestHandlerBase
+        {
+            public:
+                bool handleGet(CivetServer *_server, struct mg_connection *_conn) override;
+        };
+
+
+        /**
+        * returns the wait and hold times of the device and zone manager locks for each request action type and for the batches and the kernel poller ('/raumserver/data/lockStatistics')
+        */
+        class RequestHandlerLockStatistics : public RequestHandlerBase
+        {
+            public:
+                bool handleGet(CivetServer *_server, struct mg_connection *_conn) override;
+        };
+
+
+        /**
+        * provides the metrics of the server in the Prometheus text format ('/raumserver/metrics')
+        */
+        class RequestHandlerMetrics : public RequestHandlerBase
+        {
+            public:
+                bool handleGet(CivetServer *_server, struct mg_connection *_conn) override;
+        };
+
+
+        // the count of threads which write the frames of all websocket clients
+        const std::uint32_t WEBSOCKET_SENDER_THREADS = 4;
+
+        class WebSocketSenderPool;
+
+        /**
+        * The send queue of one websocket client. The frames are written by the threads of the sender pool, so a client which does not read 
+        * its socket can't block the long poll manager and there is no thread for each client. A frame of a topic which was not sent yet 
+        * will be replaced by the newer frame of the topic
+        */
+        class WebSocketSender : public std::enable_shared_from_this<WebSocketSender>
+        {
+            public:
+                WebSocketSender(struct mg_connection *_conn, WebSocketSenderPool *_senderPool);
+                ~WebSocketSender();
+                /**
+                * adds the frame to the send queue of the client. Frames without a topic (eg. errors) will never be replaced
+                */
+                void queueFrame(const std::string &_topic, std::shared_ptr<const std::string> _frame);
+                /**
+                * stops the sender and waits till the frame which is being written is done. No frame will be written afterwards
+                */
+                void stop();
+                const struct mg_connection* getConnection();
+
+            protected:
+                friend class WebSocketSenderPool;
+                /**
+                * writes the next frame of the queue. Returns true if there are more frames, so the sender has to be scheduled again
+                * Will only be called by one thread of the pool at a time
+                */
+                bool writeNextFrame();
+
+                struct mg_connection *conn;
+                WebSocketSenderPool *senderPool;
+                std::mutex mutexFrames;
+                std::condition_variable condFrames;
+                std::deque<std::pair<std::string, std::shared_ptr<const std::string>>> frames;
+                bool stopSender;
+                // set while the sender is in the queue of the pool or a thread of the pool is writing its frame
+                bool scheduled;
+                bool writing;
+        };
+
+
+        /**
+        * A fixed count of threads which write the queued frames of the websocket clients. A sender with queued frames writes one frame
+        * and is scheduled again behind the other senders, so a client with many frames can't hold back the others
+        */
+        class WebSocketSenderPool
+        {
+            public:
+                WebSocketSenderPool();
+                ~WebSocketSenderPool();
+                /**
+                * starts the threads of the pool if they are not running yet
+                */
+                void start(std::uint32_t _threadCount);
+                /**
+                * stops and joins the threads. The senders which are still scheduled will not write anymore
+                */
+                void stop();
+                /**
+                * adds the sender to the queue of the senders which have frames to write
+                */
+                void schedule(std::shared_ptr<WebSocketSender> _sender);
+
+            protected:
+                void senderThread();
+
+                std::vector<std::thread> senderThreadObjects;
+                std::mutex mutexSenders;
+                std::condition_variable condSenders;
+                std::deque<std::shared_ptr<WebSocketSender>> scheduledSenders;
+                bool stopThreads;
+        };
+
+
+        /**
+        * A topic a websocket client may subscribe to (eg. 'rendererState:<zone>', 'zoneConfig' or 'zoneMediaList:<zone>')
+        * All clients which are subscribed to the same topic will share one request action and one subscription on the long poll manager
+        */
+        struct WebSocketTopic
+        {
+            std::shared_ptr<Request::RequestActionReturnableLongPolling> requestAction;
+            std::uint64_t subscriptionId;
+            // the last frame which was pushed to the clients. New clients will get it directly when subscribing
+            std::shared_ptr<const std::string> lastFrame;
+            std::vector<std::shared_ptr<WebSocketSender>> senders;
+        };
+
+
+        class RequestHandlerWebSocket : public RequestHandlerBase, public CivetWebSocketHandler
+        {
+            public:
+                RequestHandlerWebSocket();
+                bool handleConnection(CivetServer *_server, const struct mg_connection *_conn) override;
+                void handleReadyState(CivetServer *_server, struct mg_connection *_conn) override;
+                bool handleData(CivetServer *_server, struct mg_connection *_conn, int _bits, char *_data, size_t _dataLen) override;
+                void handleClose(CivetServer *_server, const struct mg_connection *_conn) override;
+                /**
+                * removes all subscriptions of all clients and stops their senders and the sender pool. Has to be called before the handler is destroyed
+                */
+                void unsubscribeAll();
+
+            protected:
+                virtual void subscribeTopic(struct mg_connection *_conn, const std::string &_topic);
+                virtual void unsubscribeTopic(const struct mg_connection *_conn, const std::string &_topic);
+                /**
+                * will be called by the long poll manager when the update id of a topic has changed
+                */
+                virtual void onTopicChanged(const std::string &_topic, const std::string &_lastUpdateId);
+                virtual std::shared_ptr<const std::string> buildTopicFrame(const std::string &_topic, const std::string &_updateId, const std::string &_data);
+                /**
+                * returns the sender of the client. It will be created if the client has none yet
+                */
+                virtual std::shared_ptr<WebSocketSender> getSender(struct mg_connection *_conn);
+                virtual void sendError(struct mg_connection *_conn, const std::string &_error);
+
+                // a mutex which will secure the topic map and the senders. It is never held while a request action is executed or a frame is written
+                std::mutex mutexTopics;
+                std::unordered_map<std::string, WebSocketTopic> topics;
+                std::unordered_map<const struct mg_connection*, std::shared_ptr<WebSocketSender>> senders;
+                // the threads which write the frames of all clients
+                WebSocketSenderPool senderPool;
+        };
+
+
+        /**
+        * A topic which is streamed to the event stream clients
+        * The event text will be created once for each change and all streams will write the same string
+        */
+        struct EventStreamTopic
+        {
+            std::shared_ptr<Request::RequestActionReturnableLongPolling> requestAction;
+            std::uint64_t subscriptionId;
+            std::string lastUpdateId;
+            std::shared_ptr<const std::string> lastEvent;
+            // will be raised with every new event so the streams can check if they have to write
+            std::uint64_t eventCounter;
+            std::uint32_t streamCount;
+        };
+
+
+        class RequestHandlerEvents : public RequestHandlerBase
+        {
+            public:
+                RequestHandlerEvents();
+                bool handleGet(CivetServer *_server, struct mg_connection *_conn) override;
+                /**
+                * stops all running event streams and removes the subscriptions. 
+                * Has to be called before the webserver is closed because the streams are blocking the webserver threads
+                */
+                void stop();
+
+            protected:
+                /**
+                * adds a stream to the topic and creates the topic if it is not existent
+                */
+                virtual bool acquireTopic(const std::string &_topic);
+                virtual void releaseTopic(const std::string &_topic);
+                /**
+                * will be called by the long poll manager when the update id of a topic has changed
+                */
+                virtual void onTopicChanged(const std::string &_topic, const std::string &_lastUpdateId);
+                /**
+                * returns the text of an event without its id. The id is written for each stream because it contains the update ids of all its topics
+                */
+                virtual std::shared_ptr<const std::string> buildEvent(const std::string &_topic, const std::string &_data);
+                /**
+                * returns the id of an event which contains the update ids of the topics (eg. 'rendererState:Wohnzimmer=12,zoneConfig=7')
+                */
+                virtual std::string buildEventId(const std::map<std::string, std::string> &_updateIds);
+                /**
+                * returns the update ids of the topics of an event id (eg. of the 'Last-Event-ID' header of a reconnecting client)
+                */
+                virtual std::map<std::string, std::string> parseEventId(const std::string &_eventId);
+                virtual bool writeStream(struct mg_connection *_conn, const std::string &_data);
+
+                std::mutex mutexEvents;
+                std::condition_variable condEvents;
+                std::unordered_map<std::string, EventStreamTopic> topics;
+                std::atomic_bool stopStreams;
+                std::uint32_t runningStreams;
+        };
+
+
         class Webserver : public RaumserverBaseMgr
         {
             public:
@@ -91,14 +420,40 @@ namespace Raumserver
                 EXPORT virtual void start(std::uint32_t _port);
                 EXPORT virtual void stop();
                 EXPORT virtual void setDocumentRoot(std::string _docroot);
+                EXPORT virtual void setThreadCount(std::uint32_t _threadCount);
+                /**
+                * sets the count of the threads which will be added to the thread count for the parked long polling requests
+                */
+                EXPORT virtual void setLongPollThreadCount(std::uint32_t _threadCount);
+                EXPORT virtual void setKeepAlive(bool _keepAlive);
+                EXPORT virtual void setCompression(std::int32_t _level, std::uint32_t _minSize);
 
             protected:                  
                 std::shared_ptr<CivetServer> serverObject;             
                 std::shared_ptr<RequestHandlerController> serverRequestHandlerController;
                 std::shared_ptr<RequestHandlerData> serverRequestHandlerData;           
+                std::shared_ptr<RequestHandlerBatch> serverRequestHandlerBatch;
+                std::shared_ptr<RequestHandlerWebSocket> serverRequestHandlerWebSocket;
+                std::shared_ptr<RequestHandlerEvents> serverRequestHandlerEvents;
+                std::shared_ptr<RequestHandlerTrace> serverRequestHandlerTrace;
+                std::shared_ptr<RequestHandlerLockStatistics> serverRequestHandlerLockStatistics;
+                std::shared_ptr<RequestHandlerMetrics> serverRequestHandlerMetrics;
+
+                /**
+                * the callbacks of the webserver for the begin and the end of each request. They count the busy threads for the metrics
+                */
+                static int onBeginRequest(struct mg_connection *_conn);
+                static void onEndRequest(const struct mg_connection *_conn, int _replyStatusCode);
+                // the callbacks of the webserver do not get any user data, so the metrics manager has to be static
+                static std::atomic<Manager::MetricsManager*> callbackMetricsManager;
 
                 bool isStarted;
                 std::string docroot;
+                std::uint32_t threadCount;
+                std::uint32_t longPollThreadCount;
+                bool keepAlive;
+                std::int32_t compressionLevel;
+                std::uint32_t compressionMinSize;
         };
   
 
@@ -0,0 +1,190 @@
+#include <raumserver/manager/changeSequenceManager.h>
+#include <raumserver/manager/managerEngineerServer.h>
+
+namespace Raumserver
+{
+    namespace Manager
+    {
+
+        ChangeSequenceManager::ChangeSequenceManager() : ManagerBaseServer()
+        {
+            startSequence = (std::uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+            sequence = startSequence;
+            for (auto &typeVersion : typeVersions)
+                typeVersion = startSequence;
+            zoneConfigUpdateId = "";
+            kernelUpdateIdsChecked = false;
+            setJournalSize(1000);
+        }
+
+
+        ChangeSequenceManager::~ChangeSequenceManager()
+        {
+            logDebug("Destroying ChangeSequence-Manager", CURRENT_POSITION);
+        }
+
+
+        void ChangeSequenceManager::init()
+        {
+            if (getManagerEngineer())
+                connections.connect(getManagerEngineer()->getMediaListManager()->sigMediaListDataChanged, this, &ChangeSequenceManager::onMediaListDataChanged);
+        }
+
+
+        void ChangeSequenceManager::setJournalSize(std::uint32_t _journalSize)
+        {
+            std::unique_lock<std::mutex> lock(mutexVersions);
+            // the journal will be invalidated by resizing it, so the requests will get a full snapshot next time
+            journal.assign(std::max(_journalSize, (std::uint32_t)1), ChangeJournalEntry{ 0, ChangeEntityType::CET_COUNT, "" });
+        }
+
+
+        std::uint64_t ChangeSequenceManager::getSequence()
+        {
+            return sequence;
+        }
+
+
+        std::uint64_t ChangeSequenceManager::getVersion(ChangeEntityType _entityType, const std::string &_entityId)
+        {
+            if (_entityId.empty())
+                return typeVersions[(std::size_t)_entityType];
+
+            std::unique_lock<std::mutex> lock(mutexVersions);
+            auto &versions = entityVersions[(std::size_t)_entityType];
+            auto it = versions.find(_entityId);
+            // an entity which has not changed since the start has the version of the start
+            if (it == versions.end())
+                return startSequence;
+            return it->second;
+        }
+
+
+        std::uint64_t ChangeSequenceManager::bumpVersion(ChangeEntityType _entityType, const std::string &_entityId)
+        {
+            std::unique_lock<std::mutex> lock(mutexVersions);
+            return bumpVersionUnlocked(_entityType, _entityId);
+        }
+
+
+        std::uint64_t ChangeSequenceManager::bumpVersionUnlocked(ChangeEntityType _entityType, const std::string &_entityId)
+        {
+            auto version = ++sequence;
+            if (!_entityId.empty())
+                entityVersions[(std::size_t)_entityType][_entityId] = version;
+            typeVersions[(std::size_t)_entityType] = version;
+
+            auto &journalEntry = journal[version % journal.size()];
+            journalEntry.sequence = version;
+            journalEntry.entityType = _entityType;
+            journalEntry.entityId = _entityId;
+
+            return version;
+        }
+
+
+        bool ChangeSequenceManager::getChangedEntities(ChangeEntityType _entityType, std::uint64_t _sinceVersion, std::unordered_set<std::string> &_entityIds)
+        {
+            std::unique_lock<std::mutex> lock(mutexVersions);
+            std::uint64_t currentSequence = sequence;
+
+            // a version which is in the future or from an earlier start of the server or which was already overwritten can't be used
+            if (_sinceVersion < startSequence || _sinceVersion > currentSequence || currentSequence - _sinceVersion >= journal.size())
+                return false;
+
+            for (auto changeSequence = _sinceVersion + 1; changeSequence <= currentSequence; changeSequence++)
+            {
+                auto &journalEntry = journal[changeSequence % journal.size()];
+                if (journalEntry.sequence != changeSequence)
+                    return false;
+                if (journalEntry.entityType != _entityType)
+                    continue;
+                if (journalEntry.entityId.empty())
+                    return false;
+                _entityIds.insert(journalEntry.entityId);
+            }
+
+            return true;
+        }
+
+
+        void ChangeSequenceManager::onMediaListDataChanged(std::string _listId)
+        {
+            // the lists of the zones are stored with the renderer udn of the zone, so the requests can find them directly
+            if (_listId.compare(0, Raumkernel::Manager::LISTID_ZONEIDENTIFIER.length(), Raumkernel::Manager::LISTID_ZONEIDENTIFIER) == 0)
+                bumpVersion(ChangeEntityType::CET_ZONEMEDIALIST, _listId.substr(Raumkernel::Manager::LISTID_ZONEIDENTIFIER.length()));
+            else
+                bumpVersion(ChangeEntityType::CET_MEDIALIST, _listId);
+        }
+
+
+        void ChangeSequenceManager::checkKernelUpdateIds()
+        {
+            std::unordered_map<std::string, std::string> currentRendererStateUpdateIds;
+            std::string currentZoneConfigUpdateId;
+            bool checkSucceeded = true;
+
+            // the simulated system signals its changes on its own, the devices the kernel may find on the network are ignored
+            if (!getManagerEngineer() || (getManagerEngineerServer() && getManagerEngineerServer()->getSimulationManager()->isEnabled()))
+                return;
+
+            // the poller is the owner of the locks, so its wait and hold times are visible in the lock statistics
+            ManagerLockOwnerGuard managerLockGuard(getManagerEngineer(), getManagerEngineerServer() ? getManagerEngineerServer()->getLockStatisticsManager() : nullptr, LockOwner::LO_KERNELPOLLER);
+
+            try
+            {
+                auto mediaRendererMap = getManagerEngineer()->getDeviceManager()->getMediaRenderers();
+                for (auto it : mediaRendererMap)
+                {
+                    if (it.second)
+                        currentRendererStateUpdateIds.insert(std::make_pair(it.second->getUDN(), it.second->getLastRendererStateUpdateId()));
+                }
+                currentZoneConfigUpdateId = getManagerEngineer()->getZoneManager()->getLastUpdateId();
+            }
+            catch (...)
+            {
+                logError("Unknown Exception!", CURRENT_POSITION);
+                checkSucceeded = false;
+            }
+
+            managerLockGuard.unlock();
+
+            if (!checkSucceeded)
+                return;
+
+            std::unique_lock<std::mutex> lockKernelUpdateIds(mutexKernelUpdateIds);
+            std::unique_lock<std::mutex> lock(mutexVersions);
+
+            // on the first check we only have to remember the update ids. Nobody can know a newer version than the start version
+            if (!kernelUpdateIdsChecked)
+            {
+                rendererStateUpdateIds = currentRendererStateUpdateIds;
+                zoneConfigUpdateId = currentZoneConfigUpdateId;
+                kernelUpdateIdsChecked = true;
+                return;
+            }
+
+            bool zoneConfigChanged = currentZoneConfigUpdateId != zoneConfigUpdateId;
+            if (zoneConfigChanged)
+                bumpVersionUnlocked(ChangeEntityType::CET_ZONECONFIG, "");
+
+            for (auto it : currentRendererStateUpdateIds)
+            {
+                auto lastIt = rendererStateUpdateIds.find(it.first);
+                if (lastIt == rendererStateUpdateIds.end() || lastIt->second != it.second)
+                    bumpVersionUnlocked(ChangeEntityType::CET_RENDERERSTATE, it.first);
+            }
+
+            // the state of all renderers and the list of all zones depend on the zone configuration and on the available renderers
+            if (zoneConfigChanged || currentRendererStateUpdateIds.size() != rendererStateUpdateIds.size())
+            {
+                bumpVersionUnlocked(ChangeEntityType::CET_RENDERERSTATE, "");
+                bumpVersionUnlocked(ChangeEntityType::CET_ZONEMEDIALIST, "");
+            }
+
+            rendererStateUpdateIds = currentRendererStateUpdateIds;
+            zoneConfigUpdateId = currentZoneConfigUpdateId;
+        }
+
+    }
+}
@@ -0,0 +1,255 @@
+#include <raumserver/manager/lockStatisticsManager.h>
+#include <algorithm>
+
+namespace Raumserver
+{
+    namespace Manager
+    {
+
+        LockStatisticsManager::LockStatisticsManager() : ManagerBaseServer()
+        {
+            reset();
+            owner = -1;
+        }
+
+
+        LockStatisticsManager::~LockStatisticsManager()
+        {
+        }
+
+
+        void LockStatisticsManager::reset()
+        {
+            for (auto &statistics : lockStatistics)
+            {
+                statistics.acquiredCount = 0;
+                statistics.contendedCount = 0;
+                statistics.waitTimeSumUS = 0;
+                statistics.waitTimeMaxUS = 0;
+                statistics.holdTimeSumUS = 0;
+                statistics.holdTimeMaxUS = 0;
+                statistics.blockingCount = 0;
+                statistics.blockingWaitTimeSumUS = 0;
+            }
+            otherBlockingCount = 0;
+            otherBlockingWaitTimeSumUS = 0;
+        }
+
+
+        void LockStatisticsManager::updateMax(std::atomic<std::uint64_t> &_max, std::uint64_t _value)
+        {
+            auto max = _max.load(std::memory_order_relaxed);
+            while (_value > max && !_max.compare_exchange_weak(max, _value, std::memory_order_relaxed))
+            {
+            }
+        }
+
+
+        std::int32_t LockStatisticsManager::beginLockWait()
+        {
+            return owner.load(std::memory_order_relaxed);
+        }
+
+
+        void LockStatisticsManager::addLockAcquired(Request::RequestActionType _type, std::uint64_t _waitTimeUS, std::int32_t _ownerOnWait)
+        {
+            auto index = (std::size_t)_type;
+            addLockAcquired(index < LOCKSTATISTICS_MAX_REQUESTACTIONTYPES ? index : lockStatistics.size(), _waitTimeUS, _ownerOnWait);
+        }
+
+
+        void LockStatisticsManager::addLockAcquired(LockOwner _owner, std::uint64_t _waitTimeUS, std::int32_t _ownerOnWait)
+        {
+            addLockAcquired(LOCKSTATISTICS_MAX_REQUESTACTIONTYPES + (std::size_t)_owner, _waitTimeUS, _ownerOnWait);
+        }
+
+
+        void LockStatisticsManager::addLockAcquired(std::size_t _index, std::uint64_t _waitTimeUS, std::int32_t _ownerOnWait)
+        {
+            if (_index < lockStatistics.size())
+            {
+                auto &statistics = lockStatistics[_index];
+                statistics.acquiredCount.fetch_add(1, std::memory_order_relaxed);
+                statistics.waitTimeSumUS.fetch_add(_waitTimeUS, std::memory_order_relaxed);
+                updateMax(statistics.waitTimeMaxUS, _waitTimeUS);
+
+                // the owner is only a snapshot when the wait began, so a short wait is not counted as contended even if there was an owner
+                if (_ownerOnWait >= 0 || _waitTimeUS >= LOCKSTATISTICS_CONTENDED_WAIT_US)
+                {
+                    statistics.contendedCount.fetch_add(1, std::memory_order_relaxed);
+                    if (_ownerOnWait >= 0 && (std::size_t)_ownerOnWait < lockStatistics.size())
+                    {
+                        lockStatistics[_ownerOnWait].blockingCount.fetch_add(1, std::memory_order_relaxed);
+                        lockStatistics[_ownerOnWait].blockingWaitTimeSumUS.fetch_add(_waitTimeUS, std::memory_order_relaxed);
+                    }
+                    else
+                    {
+                        otherBlockingCount.fetch_add(1, std::memory_order_relaxed);
+                        otherBlockingWaitTimeSumUS.fetch_add(_waitTimeUS, std::memory_order_relaxed);
+                    }
+                }
+            }
+
+            owner.store(_index < lockStatistics.size() ? (std::int32_t)_index : -1, std::memory_order_relaxed);
+        }
+
+
+        void LockStatisticsManager::addLockReleased(Request::RequestActionType _type, std::uint64_t _holdTimeUS)
+        {
+            auto index = (std::size_t)_type;
+            addLockReleased(index < LOCKSTATISTICS_MAX_REQUESTACTIONTYPES ? index : lockStatistics.size(), _holdTimeUS);
+        }
+
+
+        void LockStatisticsManager::addLockReleased(LockOwner _owner, std::uint64_t _holdTimeUS)
+        {
+            addLockReleased(LOCKSTATISTICS_MAX_REQUESTACTIONTYPES + (std::size_t)_owner, _holdTimeUS);
+        }
+
+
+        void LockStatisticsManager::addLockReleased(std::size_t _index, std::uint64_t _holdTimeUS)
+        {
+            // the owner has to be cleared before the locks are released, otherwise it may overwrite the next owner
+            owner.store(-1, std::memory_order_relaxed);
+
+            if (_index >= lockStatistics.size())
+                return;
+
+            auto &statistics = lockStatistics[_index];
+            statistics.holdTimeSumUS.fetch_add(_holdTimeUS, std::memory_order_relaxed);
+            updateMax(statistics.holdTimeMaxUS, _holdTimeUS);
+        }
+
+
+        std::string LockStatisticsManager::getOwnerName(std::size_t _index)
+        {
+            if (_index < LOCKSTATISTICS_MAX_REQUESTACTIONTYPES)
+                return Request::RequestAction::requestActionTypeToString((Request::RequestActionType)_index);
+
+            switch ((LockOwner)(_index - LOCKSTATISTICS_MAX_REQUESTACTIONTYPES))
+            {
+                case LockOwner::LO_BATCH:
+                    return "batch";
+                case LockOwner::LO_KERNELPOLLER:
+                    return "kernelPoller";
+            }
+            return "";
+        }
+
+
+        std::string LockStatisticsManager::getStatisticsJson()
+        {
+            rapidjson::StringBuffer jsonStringBuffer;
+            rapidjson::Writer<rapidjson::StringBuffer> jsonWriter(jsonStringBuffer);
+
+            // the request action types (and owners) which waited the longest will be first, they are the ones which suffer from the contention
+            std::vector<std::size_t> indexes;
+            for (std::size_t index = 0; index < lockStatistics.size(); index++)
+            {
+                if (lockStatistics[index].acquiredCount.load(std::memory_order_relaxed))
+                    indexes.push_back(index);
+            }
+            std::sort(indexes.begin(), indexes.end(), [this](std::size_t _a, std::size_t _b)
+            {
+                return lockStatistics[_a].waitTimeSumUS.load(std::memory_order_relaxed) > lockStatistics[_b].waitTimeSumUS.load(std::memory_order_relaxed);
+            });
+
+            auto currentOwner = owner.load(std::memory_order_relaxed);
+
+            jsonWriter.StartObject();
+            jsonWriter.Key("owner"); jsonWriter.String(currentOwner >= 0 ? getOwnerName(currentOwner).c_str() : "");
+            jsonWriter.Key("contendedWaitTimeUS"); jsonWriter.Uint64(LOCKSTATISTICS_CONTENDED_WAIT_US);
+            jsonWriter.Key("actions");
+            jsonWriter.StartArray();
+            for (auto index : indexes)
+            {
+                auto &statistics = lockStatistics[index];
+                auto acquiredCount = statistics.acquiredCount.load(std::memory_order_relaxed);
+                auto waitTimeSumUS = statistics.waitTimeSumUS.load(std::memory_order_relaxed);
+                auto holdTimeSumUS = statistics.holdTimeSumUS.load(std::memory_order_relaxed);
+
+                jsonWriter.StartObject();
+                jsonWriter.Key("action"); jsonWriter.String(getOwnerName(index).c_str());
+                jsonWriter.Key("internal"); jsonWriter.Bool(index >= LOCKSTATISTICS_MAX_REQUESTACTIONTYPES);
+                jsonWriter.Key("acquired"); jsonWriter.Uint64(acquiredCount);
+                jsonWriter.Key("contended"); jsonWriter.Uint64(statistics.contendedCount.load(std::memory_order_relaxed));
+                jsonWriter.Key("waitTimeSumUS"); jsonWriter.Uint64(waitTimeSumUS);
+                jsonWriter.Key("waitTimeAvgUS"); jsonWriter.Uint64(waitTimeSumUS / acquiredCount);
+                jsonWriter.Key("waitTimeMaxUS"); jsonWriter.Uint64(statistics.waitTimeMaxUS.load(std::memory_order_relaxed));
+                jsonWriter.Key("holdTimeSumUS"); jsonWriter.Uint64(holdTimeSumUS);
+                jsonWriter.Key("holdTimeAvgUS"); jsonWriter.Uint64(holdTimeSumUS / acquiredCount);
+                jsonWriter.Key("holdTimeMaxUS"); jsonWriter.Uint64(statistics.holdTimeMaxUS.load(std::memory_order_relaxed));
+                jsonWriter.Key("blocking"); jsonWriter.Uint64(statistics.blockingCount.load(std::memory_order_relaxed));
+                jsonWriter.Key("blockingWaitTimeSumUS"); jsonWriter.Uint64(statistics.blockingWaitTimeSumUS.load(std::memory_order_relaxed));
+                jsonWriter.EndObject();
+            }
+            jsonWriter.EndArray();
+            // waits while no tracked owner held the locks, which is the kernel itself
+            jsonWriter.Key("other");
+            jsonWriter.StartObject();
+            jsonWriter.Key("blocking"); jsonWriter.Uint64(otherBlockingCount.load(std::memory_order_relaxed));
+            jsonWriter.Key("blockingWaitTimeSumUS"); jsonWriter.Uint64(otherBlockingWaitTimeSumUS.load(std::memory_order_relaxed));
+            jsonWriter.EndObject();
+            jsonWriter.EndObject();
+
+            return jsonStringBuffer.GetString();
+        }
+
+
+        ManagerLockOwnerGuard::ManagerLockOwnerGuard(std::shared_ptr<Raumkernel::Manager::ManagerEngineer> _managerEngineer, std::shared_ptr<LockStatisticsManager> _lockStatisticsManager, LockOwner _owner, bool _lock)
+        {
+            managerEngineer = _managerEngineer;
+            lockStatisticsManager = _lockStatisticsManager;
+            owner = _owner;
+            locked = false;
+            if (_lock)
+                lock();
+        }
+
+
+        ManagerLockOwnerGuard::~ManagerLockOwnerGuard()
+        {
+            unlock();
+        }
+
+
+        void ManagerLockOwnerGuard::lock()
+        {
+            if (locked)
+                return;
+
+            // the owner of the locks is taken before the wait, so the wait can be accounted to the one which blocked us
+            auto ownerOnWait = lockStatisticsManager ? lockStatisticsManager->beginLockWait() : -1;
+            auto waitStartTime = std::chrono::steady_clock::now();
+
+            managerEngineer->getDeviceManager()->lock();
+            managerEngineer->getZoneManager()->lock();
+            locked = true;
+
+            acquiredTime = std::chrono::steady_clock::now();
+            if (lockStatisticsManager)
+                lockStatisticsManager->addLockAcquired(owner, std::chrono::duration_cast<std::chrono::microseconds>(acquiredTime - waitStartTime).count(), ownerOnWait);
+        }
+
+
+        void ManagerLockOwnerGuard::unlock()
+        {
+            if (!locked)
+                return;
+            locked = false;
+
+            if (lockStatisticsManager)
+                lockStatisticsManager->addLockReleased(owner, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - acquiredTime).count());
+
+            managerEngineer->getDeviceManager()->unlock();
+            managerEngineer->getZoneManager()->unlock();
+        }
+
+
+        bool ManagerLockOwnerGuard::isLocked()
+        {
+            return locked;
+        }
+
+    }
+}
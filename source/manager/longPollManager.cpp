@@ -0,0 +1,358 @@
+#include <raumserver/manager/longPollManager.h>
+#include <algorithm>
+#include <raumserver/manager/managerEngineerServer.h>
+#include <raumserver/request/requestActionReturnableLP.h>
+
+namespace Raumserver
+{
+    namespace Manager
+    {
+
+        LongPollManager::LongPollManager() : ManagerBaseServer()
+        {
+            stopThreads = false;
+            changePending = false;
+            checkIntervalMS = 200;
+            maxParkedCount = 0;
+            parkedRequestCount = 0;
+            lastSubscriptionId = 0;
+        }
+
+
+        LongPollManager::~LongPollManager()
+        {
+            stopThreads = true;
+            notifyChange();
+            if (changeWatcherThreadObject.joinable())
+            {
+                logDebug("Waiting for LongPollWatcher thread to finish", CURRENT_POSITION);
+                changeWatcherThreadObject.join();
+            }
+
+            // the watcher is gone, so we have to resume all waiters which are still parked. Subscriptions do not have a 
+            // parked thread, so we can remove them directly
+            std::unique_lock<std::mutex> lock(mutexWaiters);
+            std::vector<std::shared_ptr<LongPollWaiter>> subscriptions;
+            for (auto waiter : waiters)
+            {
+                if (waiter->subscriptionId)
+                    subscriptions.push_back(waiter);
+            }
+            for (auto subscription : subscriptions)
+                removeWaiter(subscription);
+            for (auto waiter : waiters)
+                waiter->state = LongPollWaiterState::LPWS_ABORTED;
+            condWaiterResumed.notify_all();
+            // and we have to wait till they have left the registry before we are allowed to go away
+            condWaiterResumed.wait(lock, [this] { return waiters.empty(); });
+
+            logDebug("Destroying LongPoll-Manager", CURRENT_POSITION);
+        }
+
+
+        void LongPollManager::init()
+        {
+            // media lists will signal their changes, so we do not have to wait for the next check interval
+            if (getManagerEngineer())
+                connections.connect(getManagerEngineer()->getMediaListManager()->sigMediaListDataChanged, this, &LongPollManager::onMediaListDataChanged);
+
+            changeWatcherThreadObject = std::thread(&LongPollManager::changeWatcherThread, this);
+        }
+
+
+        void LongPollManager::setCheckInterval(std::uint32_t _checkIntervalMS)
+        {
+            checkIntervalMS = _checkIntervalMS;
+        }
+
+
+        void LongPollManager::setMaxParkedCount(std::uint32_t _maxParkedCount)
+        {
+            std::unique_lock<std::mutex> lock(mutexWaiters);
+            maxParkedCount = _maxParkedCount;
+        }
+
+
+        std::uint32_t LongPollManager::getParkedCount()
+        {
+            std::unique_lock<std::mutex> lock(mutexWaiters);
+            return (std::uint32_t)waiters.size();
+        }
+
+
+        std::uint32_t LongPollManager::getSubscriptionCount()
+        {
+            std::unique_lock<std::mutex> lock(mutexWaiters);
+            std::uint32_t subscriptionCount = 0;
+            for (auto &waiter : waiters)
+            {
+                if (waiter->subscriptionId)
+                    subscriptionCount++;
+            }
+            return subscriptionCount;
+        }
+
+
+        std::uint32_t LongPollManager::getSessionCount()
+        {
+            std::unique_lock<std::mutex> lock(mutexWaiters);
+            std::unordered_set<std::string> sessionIds;
+            for (auto &waiter : waiters)
+            {
+                if (!waiter->sessionId.empty())
+                    sessionIds.insert(waiter->sessionId);
+            }
+            return (std::uint32_t)sessionIds.size();
+        }
+
+
+        void LongPollManager::onMediaListDataChanged(std::string _listId)
+        {
+            notifyChange();
+        }
+
+
+        void LongPollManager::notifyChange()
+        {
+            std::unique_lock<std::mutex> lock(mutexChange);
+            changePending = true;
+            condChange.notify_one();
+        }
+
+
+        void LongPollManager::notifyChannelChange(const std::string &_channel)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutexWaiters);
+                if (channelWaiterCounts.find(_channel) == channelWaiterCounts.end())
+                    return;
+            }
+
+            std::unique_lock<std::mutex> lock(mutexChange);
+            changedChannels.insert(_channel);
+            condChange.notify_one();
+        }
+
+
+        void LongPollManager::addWaiter(std::shared_ptr<LongPollWaiter> _waiter)
+        {
+            waiters.push_back(_waiter);
+            if (!_waiter->subscriptionId)
+                parkedRequestCount++;
+            if (!_waiter->channel.empty())
+                channelWaiterCounts[_waiter->channel]++;
+        }
+
+
+        void LongPollManager::removeWaiter(std::shared_ptr<LongPollWaiter> _waiter)
+        {
+            waiters.remove(_waiter);
+            if (!_waiter->subscriptionId)
+                parkedRequestCount--;
+            if (_waiter->channel.empty())
+                return;
+            auto it = channelWaiterCounts.find(_waiter->channel);
+            if (it != channelWaiterCounts.end() && !--it->second)
+                channelWaiterCounts.erase(it);
+        }
+
+
+        LongPollWaiterState LongPollManager::waitForUpdate(Request::RequestActionReturnableLongPolling* _requestAction, const std::string &_updateId, const std::string &_sessionId, std::string &_lastUpdateId)
+        {
+            auto waiter = std::shared_ptr<LongPollWaiter>(new LongPollWaiter());
+            waiter->requestAction = _requestAction;
+            waiter->key = _requestAction->getLongPollingKey();
+            waiter->channel = _requestAction->getLongPollingChannel();
+            waiter->updateId = _updateId;
+            waiter->sessionId = _sessionId;
+            waiter->state = LongPollWaiterState::LPWS_PARKED;
+            waiter->subscriptionId = 0;
+
+            std::unique_lock<std::mutex> lock(mutexWaiters);
+
+            if (stopThreads)
+                return LongPollWaiterState::LPWS_ABORTED;
+
+            // each parked request holds a webserver thread. If the threads reserved for them are used up the request has to 
+            // return now, otherwise it would take one of the threads the controller calls need
+            if (maxParkedCount && parkedRequestCount >= maxParkedCount)
+                return LongPollWaiterState::LPWS_REJECTED;
+
+            addWaiter(waiter);
+            // a new waiter may already be outdated, so let the watcher check it as soon as possible
+            notifyChange();
+
+            // only the watcher thread (or the destructor after the watcher has finished) will resume a waiter, so the request action
+            // we are holding in the waiter object will stay valid as long as the waiter is parked
+            condWaiterResumed.wait(lock, [&waiter] { return waiter->state != LongPollWaiterState::LPWS_PARKED; });
+
+            removeWaiter(waiter);
+            _lastUpdateId = waiter->lastUpdateId;
+
+            // the destructor may wait for the registry to get empty
+            if (stopThreads)
+                condWaiterResumed.notify_all();
+
+            return waiter->state;
+        }
+
+
+        std::uint64_t LongPollManager::subscribe(std::shared_ptr<Request::RequestActionReturnableLongPolling> _requestAction, const std::string &_updateId, std::function<void(const std::string &_lastUpdateId)> _callback)
+        {
+            auto waiter = std::shared_ptr<LongPollWaiter>(new LongPollWaiter());
+            waiter->requestAction = _requestAction.get();
+            waiter->key = _requestAction->getLongPollingKey();
+            waiter->channel = _requestAction->getLongPollingChannel();
+            waiter->updateId = _updateId;
+            waiter->state = LongPollWaiterState::LPWS_PARKED;
+            waiter->subscriptionAction = _requestAction;
+            waiter->subscriptionCallback = _callback;
+
+            std::unique_lock<std::mutex> lock(mutexWaiters);
+            waiter->subscriptionId = ++lastSubscriptionId;
+            addWaiter(waiter);
+            notifyChange();
+
+            return waiter->subscriptionId;
+        }
+
+
+        void LongPollManager::unsubscribe(std::uint64_t _subscriptionId)
+        {
+            // if the watcher is calling the callbacks we have to wait till it's finished
+            std::unique_lock<std::mutex> lockSubscriptions(mutexSubscriptions);
+            std::unique_lock<std::mutex> lock(mutexWaiters);
+            auto it = std::find_if(waiters.begin(), waiters.end(), [_subscriptionId](std::shared_ptr<LongPollWaiter> _waiter) { return _waiter->subscriptionId == _subscriptionId; });
+            if (it != waiters.end())
+                removeWaiter(*it);
+        }
+
+
+        void LongPollManager::changeWatcherThread()
+        {
+            while (!stopThreads)
+            {
+                bool checkAll;
+                std::unordered_set<std::string> channels;
+
+                {
+                    std::unique_lock<std::mutex> lock(mutexChange);
+                    auto notified = condChange.wait_for(lock, std::chrono::milliseconds(checkIntervalMS), [this] { return changePending || !changedChannels.empty() || stopThreads; });
+                    // if only some channels have changed we don't have to ask the kernel or check the other waiters
+                    checkAll = changePending || !notified;
+                    changePending = false;
+                    channels.swap(changedChannels);
+                }
+
+                if (stopThreads)
+                    break;
+
+                try
+                {
+                    if (checkAll)
+                    {
+                        // the versions have to be up to date before we check the waiters, even if no one is waiting
+                        // because a request without long polling will get the current version too
+                        getManagerEngineerServer()->getChangeSequenceManager()->checkKernelUpdateIds();
+                        checkWaiters();
+                    }
+                    else
+                    {
+                        checkWaiters(&channels);
+                    }
+                }
+                catch (Raumkernel::Exception::RaumkernelException &e)
+                {
+                    if (e.type() == Raumkernel::Exception::ExceptionType::EXCEPTIONTYPE_APPCRASH)
+                        throw e;
+                }
+                catch (std::exception &e)
+                {
+                    logError(e.what(), CURRENT_POSITION);
+                }
+                catch (std::string &e)
+                {
+                    logError(e, CURRENT_POSITION);
+                }
+                catch (...)
+                {
+                    logError("Unknown exception!", CURRENT_POSITION);
+                }
+            }
+        }
+
+
+        void LongPollManager::checkWaiters(const std::unordered_set<std::string> *_channels)
+        {
+            std::vector<std::shared_ptr<LongPollWaiter>> parkedWaiters, changedSubscriptions;
+            std::unordered_map<std::string, std::string> lastUpdateIds;
+
+            // no subscription may be removed while we are checking, otherwise we may call a callback which is not valid anymore
+            std::unique_lock<std::mutex> lockSubscriptions(mutexSubscriptions);
+
+            {
+                std::unique_lock<std::mutex> lock(mutexWaiters);
+                for (auto waiter : waiters)
+                {
+                    if (waiter->state != LongPollWaiterState::LPWS_PARKED)
+                        continue;
+                    if (_channels && _channels->find(waiter->channel) == _channels->end())
+                        continue;
+                    parkedWaiters.push_back(waiter);
+                }
+            }
+
+            if (parkedWaiters.empty())
+                return;
+
+            // resolve the update id only once for each request key. We do this without holding the registry lock because the 
+            // request actions will lock the device and zone manager. The waiters can't leave while we are doing this
+            for (auto waiter : parkedWaiters)
+            {
+                if (lastUpdateIds.find(waiter->key) == lastUpdateIds.end())
+                    lastUpdateIds.insert(std::make_pair(waiter->key, waiter->requestAction->getLastUpdateId()));
+            }
+
+            bool resumed = false;
+            std::unique_lock<std::mutex> lock(mutexWaiters);
+
+            for (auto waiter : parkedWaiters)
+            {
+                waiter->lastUpdateId = lastUpdateIds[waiter->key];
+
+                // subscriptions will stay parked, they only have to remember the new update id
+                if (waiter->subscriptionId)
+                {
+                    if (waiter->lastUpdateId != waiter->updateId)
+                    {
+                        waiter->updateId = waiter->lastUpdateId;
+                        changedSubscriptions.push_back(waiter);
+                    }
+                }
+                else if (waiter->lastUpdateId != waiter->updateId)
+                {
+                    waiter->state = LongPollWaiterState::LPWS_CHANGED;
+                    resumed = true;
+                }
+                // check if session was killed, if so then the request has to return without data
+                else if (!waiter->sessionId.empty() && getManagerEngineerServer()->getSessionManager()->isSessionAborted(waiter->sessionId))
+                {
+                    waiter->state = LongPollWaiterState::LPWS_ABORTED;
+                    resumed = true;
+                }
+            }
+
+            if (resumed)
+                condWaiterResumed.notify_all();
+
+            lock.unlock();
+
+            // the callbacks are called without holding the registry lock, so they are allowed to subscribe to something new
+            for (auto waiter : changedSubscriptions)
+            {
+                waiter->subscriptionCallback(waiter->lastUpdateId);
+            }
+        }
+
+    }
+}
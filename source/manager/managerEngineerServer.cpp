@@ -9,12 +9,37 @@ namespace Raumserver
         ManagerEngineerServer::ManagerEngineerServer() : RaumserverBase()
         {
             requestActionManager = nullptr;    
+            sessionManager = nullptr;
+            changeSequenceManager = nullptr;
+            longPollManager = nullptr;
+            responseCacheManager = nullptr;
+            metricsManager = nullptr;
+            traceManager = nullptr;
+            timerManager = nullptr;
             systemReady = false;
         }
 
 
         ManagerEngineerServer::~ManagerEngineerServer()
         {
+            // the request workers and the timer callbacks are using the other managers (eg. the timer, the long poll or the metrics manager), 
+            // so they have to be stopped before any manager is destroyed. The timers are stopped after the workers because the workers add timers
+            if (requestActionManager)
+                requestActionManager->stop();
+            if (timerManager)
+                timerManager->stop();
+
+            // the threads of the simulation and the long poll manager are using the change sequence manager
+            simulationManager = nullptr;
+            longPollManager = nullptr;
+            changeSequenceManager = nullptr;
+            responseCacheManager = nullptr;
+            sessionManager = nullptr;
+            requestActionManager = nullptr;
+            metricsManager = nullptr;
+            traceManager = nullptr;
+            lockStatisticsManager = nullptr;
+            timerManager = nullptr;
         }
 
 
@@ -40,6 +65,38 @@ namespace Raumserver
             logDebug("Create SessionManager-Manager...", CURRENT_FUNCTION);
             sessionManager = std::shared_ptr<Manager::SessionManager>(new Manager::SessionManager());
             sessionManager->setLogObject(getLogObject());
+
+            logDebug("Create ChangeSequenceManager-Manager...", CURRENT_FUNCTION);
+            changeSequenceManager = std::shared_ptr<Manager::ChangeSequenceManager>(new Manager::ChangeSequenceManager());
+            changeSequenceManager->setLogObject(getLogObject());
+
+            logDebug("Create LongPollManager-Manager...", CURRENT_FUNCTION);
+            longPollManager = std::shared_ptr<Manager::LongPollManager>(new Manager::LongPollManager());
+            longPollManager->setLogObject(getLogObject());
+
+            logDebug("Create ResponseCacheManager-Manager...", CURRENT_FUNCTION);
+            responseCacheManager = std::shared_ptr<Manager::ResponseCacheManager>(new Manager::ResponseCacheManager());
+            responseCacheManager->setLogObject(getLogObject());
+
+            logDebug("Create MetricsManager-Manager...", CURRENT_FUNCTION);
+            metricsManager = std::shared_ptr<Manager::MetricsManager>(new Manager::MetricsManager());
+            metricsManager->setLogObject(getLogObject());
+
+            logDebug("Create TraceManager-Manager...", CURRENT_FUNCTION);
+            traceManager = std::shared_ptr<Manager::TraceManager>(new Manager::TraceManager());
+            traceManager->setLogObject(getLogObject());
+
+            logDebug("Create LockStatisticsManager-Manager...", CURRENT_FUNCTION);
+            lockStatisticsManager = std::shared_ptr<Manager::LockStatisticsManager>(new Manager::LockStatisticsManager());
+            lockStatisticsManager->setLogObject(getLogObject());
+
+            logDebug("Create SimulationManager-Manager...", CURRENT_FUNCTION);
+            simulationManager = std::shared_ptr<Manager::SimulationManager>(new Manager::SimulationManager());
+            simulationManager->setLogObject(getLogObject());
+
+            logDebug("Create TimerManager-Manager...", CURRENT_FUNCTION);
+            timerManager = std::shared_ptr<Manager::TimerManager>(new Manager::TimerManager());
+            timerManager->setLogObject(getLogObject());
         }
 
 
@@ -56,6 +113,54 @@ namespace Raumserver
         }
 
 
+        std::shared_ptr<ChangeSequenceManager> ManagerEngineerServer::getChangeSequenceManager()
+        {
+            return changeSequenceManager;
+        }
+
+
+        std::shared_ptr<LongPollManager> ManagerEngineerServer::getLongPollManager()
+        {
+            return longPollManager;
+        }
+
+
+        std::shared_ptr<ResponseCacheManager> ManagerEngineerServer::getResponseCacheManager()
+        {
+            return responseCacheManager;
+        }
+
+
+        std::shared_ptr<TimerManager> ManagerEngineerServer::getTimerManager()
+        {
+            return timerManager;
+        }
+
+
+        std::shared_ptr<MetricsManager> ManagerEngineerServer::getMetricsManager()
+        {
+            return metricsManager;
+        }
+
+
+        std::shared_ptr<TraceManager> ManagerEngineerServer::getTraceManager()
+        {
+            return traceManager;
+        }
+
+
+        std::shared_ptr<LockStatisticsManager> ManagerEngineerServer::getLockStatisticsManager()
+        {
+            return lockStatisticsManager;
+        }
+
+
+        std::shared_ptr<SimulationManager> ManagerEngineerServer::getSimulationManager()
+        {
+            return simulationManager;
+        }
+
+
         void ManagerEngineerServer::raiseSigsegv()
         {
             raise(SIGSEGV);
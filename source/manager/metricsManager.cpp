@@ -0,0 +1,244 @@
+#include <raumserver/manager/metricsManager.h>
+#include <raumserver/manager/managerEngineerServer.h>
+#include <raumserver/request/requestActionPool.h>
+
+namespace Raumserver
+{
+    namespace Manager
+    {
+
+        MetricsManager::MetricsManager() : ManagerBaseServer()
+        {
+            for (auto &metrics : requestActionMetrics)
+            {
+                for (auto &bucket : metrics.latencyBuckets)
+                    bucket = 0;
+                metrics.latencySumUS = 0;
+                metrics.executedCount = 0;
+                metrics.errorCount = 0;
+            }
+            httpRequestCount = 0;
+            httpRequestErrorCount = 0;
+            busyWebserverThreadCount = 0;
+            webserverThreadCount = 0;
+        }
+
+
+        MetricsManager::~MetricsManager()
+        {
+        }
+
+
+        void MetricsManager::addRequestActionExecution(Request::RequestActionType _type, std::uint64_t _durationUS, bool _success)
+        {
+            auto index = (std::size_t)_type;
+            if (index >= requestActionMetrics.size())
+                return;
+
+            // the buckets are stored without the counts of the lower buckets, they will be summed up when the metrics are written
+            std::size_t bucketIndex = 0;
+            while (bucketIndex < METRICS_LATENCY_BUCKETS_US.size() && _durationUS > METRICS_LATENCY_BUCKETS_US[bucketIndex])
+                bucketIndex++;
+
+            auto &metrics = requestActionMetrics[index];
+            metrics.latencyBuckets[bucketIndex].fetch_add(1, std::memory_order_relaxed);
+            metrics.latencySumUS.fetch_add(_durationUS, std::memory_order_relaxed);
+            metrics.executedCount.fetch_add(1, std::memory_order_relaxed);
+            if (!_success)
+                metrics.errorCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+
+        void MetricsManager::addRequestActionError(Request::RequestActionType _type)
+        {
+            auto index = (std::size_t)_type;
+            if (index < requestActionMetrics.size())
+                requestActionMetrics[index].errorCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+
+        void MetricsManager::beginHttpRequest()
+        {
+            httpRequestCount.fetch_add(1, std::memory_order_relaxed);
+            busyWebserverThreadCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+
+        void MetricsManager::endHttpRequest()
+        {
+            busyWebserverThreadCount.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+
+        void MetricsManager::addHttpRequestError()
+        {
+            httpRequestErrorCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+
+        void MetricsManager::setWebserverThreadCount(std::uint32_t _threadCount)
+        {
+            webserverThreadCount = _threadCount;
+        }
+
+
+        void MetricsManager::writeMetricHeader(std::string &_text, const std::string &_name, const std::string &_type, const std::string &_help)
+        {
+            _text += "# HELP " + _name + " " + _help + "\n";
+            _text += "# TYPE " + _name + " " + _type + "\n";
+        }
+
+
+        std::string MetricsManager::microsecondsToSeconds(std::uint64_t _microseconds)
+        {
+            // the fraction is written without trailing zeros (eg. 0.0025 instead of 0.002500)
+            auto fraction = std::to_string(1000000 + _microseconds % 1000000).substr(1);
+            fraction.erase(fraction.find_last_not_of('0') + 1);
+            return std::to_string(_microseconds / 1000000) + (fraction.empty() ? "" : "." + fraction);
+        }
+
+
+        void MetricsManager::writeMetricValue(std::string &_text, const std::string &_name, const std::string &_labels, const std::string &_value)
+        {
+            _text += _name;
+            if (!_labels.empty())
+                _text += "{" + _labels + "}";
+            _text += " " + _value + "\n";
+        }
+
+
+        void MetricsManager::writeRequestActionMetrics(std::string &_text)
+        {
+            const std::string latencyName = "raumserver_request_action_duration_seconds";
+            const std::string executedName = "raumserver_request_actions_total";
+            const std::string errorName = "raumserver_request_action_errors_total";
+            std::string latencyText, executedText, errorText;
+
+            for (std::size_t index = 0; index < requestActionMetrics.size(); index++)
+            {
+                auto &metrics = requestActionMetrics[index];
+                auto executedCount = metrics.executedCount.load(std::memory_order_relaxed);
+                auto errorCount = metrics.errorCount.load(std::memory_order_relaxed);
+                if (!executedCount && !errorCount)
+                    continue;
+
+                auto actionName = Raumkernel::Tools::StringUtil::tolower(Request::RequestAction::requestActionTypeToString((Request::RequestActionType)index));
+                auto actionLabel = "action=\"" + actionName + "\"";
+
+                // the buckets of a Prometheus histogram contain all values which are less or equal to their bound
+                std::uint64_t cumulativeCount = 0;
+                for (std::size_t bucketIndex = 0; bucketIndex <= METRICS_LATENCY_BUCKETS_US.size(); bucketIndex++)
+                {
+                    cumulativeCount += metrics.latencyBuckets[bucketIndex].load(std::memory_order_relaxed);
+                    auto bound = bucketIndex < METRICS_LATENCY_BUCKETS_US.size() ? microsecondsToSeconds(METRICS_LATENCY_BUCKETS_US[bucketIndex]) : "+Inf";
+                    writeMetricValue(latencyText, latencyName + "_bucket", actionLabel + ",le=\"" + bound + "\"", std::to_string(cumulativeCount));
+                }
+                writeMetricValue(latencyText, latencyName + "_sum", actionLabel, microsecondsToSeconds(metrics.latencySumUS.load(std::memory_order_relaxed)));
+                writeMetricValue(latencyText, latencyName + "_count", actionLabel, std::to_string(cumulativeCount));
+
+                writeMetricValue(executedText, executedName, actionLabel, std::to_string(executedCount));
+                writeMetricValue(errorText, errorName, actionLabel, std::to_string(errorCount));
+            }
+
+            writeMetricHeader(_text, latencyName, "histogram", "Duration of the execution of the request actions (the calls to the Raumfeld devices)");
+            _text += latencyText;
+            writeMetricHeader(_text, executedName, "counter", "Count of executed request actions");
+            _text += executedText;
+            writeMetricHeader(_text, errorName, "counter", "Count of request actions which failed or were invalid");
+            _text += errorText;
+
+            writeMetricHeader(_text, "raumserver_request_action_pool_reused_total", "counter", "Count of request actions which got their memory from the pool");
+            writeMetricValue(_text, "raumserver_request_action_pool_reused_total", "", std::to_string(Request::RequestActionPool::getInstance().getReuseCount()));
+        }
+
+
+        void MetricsManager::writeQueueMetrics(std::string &_text)
+        {
+            auto requestActionManager = getManagerEngineerServer()->getRequestActionManager();
+            if (!requestActionManager)
+                return;
+
+            writeMetricHeader(_text, "raumserver_queue_depth", "gauge", "Count of request actions waiting in the queue");
+            writeMetricValue(_text, "raumserver_queue_depth", "", std::to_string(requestActionManager->getQueueDepth()));
+            writeMetricHeader(_text, "raumserver_queue_running", "gauge", "Count of request actions running right now");
+            writeMetricValue(_text, "raumserver_queue_running", "", std::to_string(requestActionManager->getRunningCount()));
+            writeMetricHeader(_text, "raumserver_queue_merged_total", "counter", "Count of request actions merged into a waiting one");
+            writeMetricValue(_text, "raumserver_queue_merged_total", "", std::to_string(requestActionManager->getMergedRequestActionCount()));
+
+            auto waitStatistics = requestActionManager->getWaitStatistics();
+            std::string waitText, waitMaxText, droppedText;
+            for (auto &statistics : waitStatistics)
+            {
+                auto priorityLabel = "priority=\"" + Request::RequestAction::requestActionPriorityToString(statistics.first) + "\"";
+                writeMetricValue(waitText, "raumserver_queue_wait_seconds_sum", priorityLabel, microsecondsToSeconds(statistics.second.waitTimeSumUS));
+                writeMetricValue(waitText, "raumserver_queue_wait_seconds_count", priorityLabel, std::to_string(statistics.second.count));
+                writeMetricValue(waitMaxText, "raumserver_queue_wait_seconds_max", priorityLabel, microsecondsToSeconds(statistics.second.waitTimeMaxUS));
+                writeMetricValue(droppedText, "raumserver_queue_dropped_total", priorityLabel, std::to_string(statistics.second.droppedCount));
+            }
+
+            writeMetricHeader(_text, "raumserver_queue_wait_seconds", "summary", "Time the request actions waited in the queue");
+            _text += waitText;
+            writeMetricHeader(_text, "raumserver_queue_wait_seconds_max", "gauge", "Longest time a request action waited in the queue");
+            _text += waitMaxText;
+            writeMetricHeader(_text, "raumserver_queue_dropped_total", "counter", "Count of request actions dropped because they passed their deadline");
+            _text += droppedText;
+        }
+
+
+        void MetricsManager::writeLongPollMetrics(std::string &_text)
+        {
+            auto longPollManager = getManagerEngineerServer()->getLongPollManager();
+            if (longPollManager)
+            {
+                auto parkedCount = longPollManager->getParkedCount();
+                auto subscriptionCount = longPollManager->getSubscriptionCount();
+
+                writeMetricHeader(_text, "raumserver_longpoll_requests", "gauge", "Count of parked long polling requests");
+                writeMetricValue(_text, "raumserver_longpoll_requests", "", std::to_string(parkedCount - subscriptionCount));
+                writeMetricHeader(_text, "raumserver_longpoll_subscriptions", "gauge", "Count of subscriptions (websocket and server sent event clients)");
+                writeMetricValue(_text, "raumserver_longpoll_subscriptions", "", std::to_string(subscriptionCount));
+                writeMetricHeader(_text, "raumserver_sessions", "gauge", "Count of distinct sessions of the parked long polling requests");
+                writeMetricValue(_text, "raumserver_sessions", "", std::to_string(longPollManager->getSessionCount()));
+            }
+
+            auto responseCacheManager = getManagerEngineerServer()->getResponseCacheManager();
+            if (responseCacheManager)
+            {
+                writeMetricHeader(_text, "raumserver_response_cache_hits_total", "counter", "Count of data responses taken from the response cache");
+                writeMetricValue(_text, "raumserver_response_cache_hits_total", "", std::to_string(responseCacheManager->getHitCount()));
+            }
+        }
+
+
+        void MetricsManager::writeWebserverMetrics(std::string &_text)
+        {
+            writeMetricHeader(_text, "raumserver_http_requests_total", "counter", "Count of http requests");
+            writeMetricValue(_text, "raumserver_http_requests_total", "", std::to_string(httpRequestCount.load(std::memory_order_relaxed)));
+            writeMetricHeader(_text, "raumserver_http_request_errors_total", "counter", "Count of http requests which got an error response");
+            writeMetricValue(_text, "raumserver_http_request_errors_total", "", std::to_string(httpRequestErrorCount.load(std::memory_order_relaxed)));
+            writeMetricHeader(_text, "raumserver_webserver_threads", "gauge", "Count of the threads of the webserver");
+            writeMetricValue(_text, "raumserver_webserver_threads", "", std::to_string(webserverThreadCount.load()));
+            // a parked long polling request keeps its thread busy, so a high value does not have to mean that the server is overloaded
+            writeMetricHeader(_text, "raumserver_webserver_threads_busy", "gauge", "Count of the threads of the webserver which are handling a request");
+            writeMetricValue(_text, "raumserver_webserver_threads_busy", "", std::to_string(std::max(busyWebserverThreadCount.load(std::memory_order_relaxed), 0)));
+        }
+
+
+        std::string MetricsManager::getMetricsText()
+        {
+            std::string text;
+            text.reserve(16 * 1024);
+
+            writeRequestActionMetrics(text);
+            writeWebserverMetrics(text);
+            if (getManagerEngineerServer())
+            {
+                writeQueueMetrics(text);
+                writeLongPollMetrics(text);
+            }
+
+            return text;
+        }
+
+    }
+}
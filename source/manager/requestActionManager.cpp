@@ -1,5 +1,7 @@
 
 #include <raumserver/manager/requestActionManager.h>
+#include <algorithm>
+#include <raumserver/manager/managerEngineerServer.h>
 
 namespace Raumserver
 {
@@ -9,24 +11,73 @@ namespace Raumserver
         RequestActionManager::RequestActionManager() : ManagerBaseServer()
         {    
             stopThreads = false;
+            workerCount = 4;
+            runningCount = 0;
+            barrierRunning = false;
+            mergedRequestActionCount = 0;
+            runningNotHighCount = 0;
+            lastRequestId = 0;
+            lastDeadlineId = 0;
+            lastWaitingJobId = 0;
+            lastStatusVersion = 0;
+            setStatusBufferSize(1000);
+
+            for (auto priority : { Request::RequestActionPriority::RAP_HIGH, Request::RequestActionPriority::RAP_NORMAL, Request::RequestActionPriority::RAP_LOW })
+                waitStatistics[priority] = { 0, 0, 0, 0 };
         }
 
 
         RequestActionManager::~RequestActionManager()
         {    
-            stopThreads = true;
-            if (doRequestsThreadObject.joinable())
+            stop();
+            logDebug("Destroying RequestAction-Manager", CURRENT_POSITION);
+        }
+
+
+        void RequestActionManager::stop()
+        {
+            // set the stop flag while holding the lock, otherwise the worker may miss the notification
             {
-                logDebug("Waiting for RequestWorkerThread thread to finish (This may take some time...)", CURRENT_POSITION);
-                doRequestsThreadObject.join();
+                std::unique_lock<std::mutex> lock(mutexRequestActionQueue);
+                stopThreads = true;
             }
-            logDebug("Destroying RequestAction-Manager", CURRENT_POSITION);
+            condRequestActionQueue.notify_all();
+            logDebug("Waiting for RequestWorkerThread threads to finish (This may take some time...)", CURRENT_POSITION);
+            for (auto &workerThreadObject : workerThreadObjects)
+            {
+                if (workerThreadObject.joinable())
+                    workerThreadObject.join();
+            }
+
+            // someone may be waiting for the jobs which were not executed or which are waiting for a timer (eg. a batch)
+            std::vector<RequestActionLaneJob> droppedJobs;
+            {
+                std::unique_lock<std::mutex> lock(mutexRequestActionQueue);
+                for (auto &item : requestActionQueue)
+                {
+                    if (item.job)
+                        droppedJobs.push_back(item.job);
+                }
+                requestActionQueue.clear();
+                for (auto &pair : waitingJobs)
+                    droppedJobs.push_back(pair.second);
+                waitingJobs.clear();
+            }
+            for (auto &job : droppedJobs)
+                job(false);
         }
    
         
         void RequestActionManager::init()
         {
-            doRequestsThreadObject = std::thread(&RequestActionManager::requestProcessingWorkerThread, this);
+            for (std::uint32_t i = 0; i < workerCount; i++)
+                workerThreadObjects.push_back(std::thread(&RequestActionManager::requestProcessingWorkerThread, this));
+        }
+
+
+        void RequestActionManager::setWorkerCount(std::uint32_t _workerCount)
+        {
+            workerCount = _workerCount ? _workerCount : 1;
         }
         
         
@@ -34,55 +85,428 @@ namespace Raumserver
         {
             while (!stopThreads)
             {
-                mutexRequestActionQueue.lock();
+                RequestActionQueueItem item;
 
-                try
-                {                    
-                    if (requestActionQueue.size())
+                // wait till there is a request in the queue which may run and take it out. The queue is not locked while the request is executed,
+                // so the webserver threads can add new requests while a slow request (eg. loadPlaylist) is running
+                {
+                    std::unique_lock<std::mutex> lock(mutexRequestActionQueue);
+                    while (!stopThreads && !takeNextRequestAction(item))
+                        condRequestActionQueue.wait(lock);
+                    if (stopThreads)
+                        break;
+                }
+
+                std::uint32_t waitTime = 0;
+                // jobs will handle their errors on their own
+                if (item.job)
+                    waitTime = item.job(true);
+                else
+                    waitTime = executeQueuedRequestAction(item);
+
+                // the lane is idle now, so other workers may take the next request of the lane or a waiting barrier
+                // if the request has a wait time the lane will be idle when the timer is done, but the worker is free now
+                {
+                    std::unique_lock<std::mutex> lock(mutexRequestActionQueue);
+                    if (item.priority != Request::RequestActionPriority::RAP_HIGH)
+                        runningNotHighCount--;
+                    if (!waitTime)
+                        finishRequestAction(item);
+                }
+                if (waitTime)
+                {
+                    // a waiting job is remembered, so it can be dropped if the manager is stopped before the timer is called
+                    std::uint64_t waitingJobId = 0;
+                    if (item.job)
                     {
-                        // get the first request in the queue and process it!
-                        auto requestAction = requestActionQueue.front();
-                        logDebug("Processing Request: " + requestAction->getRequestInfo(), CURRENT_POSITION);
-                        requestAction->execute();                        
-                        logDebug("Popping Request: " + requestAction->getRequestInfo(), CURRENT_POSITION);
-                        requestActionQueue.pop();
+                        std::unique_lock<std::mutex> lock(mutexRequestActionQueue);
+                        waitingJobId = ++lastWaitingJobId;
+                        waitingJobs.insert(std::make_pair(waitingJobId, item.job));
                     }
 
+                    getManagerEngineerServer()->getTimerManager()->addTimer(waitTime, [this, item, waitingJobId]
+                    {
+                        {
+                            std::unique_lock<std::mutex> lock(mutexRequestActionQueue);
+                            finishRequestAction(item);
+                            // a job which had to wait will continue before anything else of its lane, so the lane stays in order
+                            // If the manager was stopped meanwhile the job was already dropped
+                            if (item.job && waitingJobs.erase(waitingJobId))
+                            {
+                                auto continuedItem = item;
+                                continuedItem.enqueueTime = std::chrono::steady_clock::now();
+                                requestActionQueue.push_front(continuedItem);
+                            }
+                        }
+                        condRequestActionQueue.notify_all();
+                    });
                 }
-                catch (Raumkernel::Exception::RaumkernelException &e)
+                condRequestActionQueue.notify_all();
+            }
+        }
+
+
+        std::uint32_t RequestActionManager::executeQueuedRequestAction(const RequestActionQueueItem &_item)
+        {
+            auto requestAction = _item.requestAction;
+            bool executed = false;
+            if (TraceManager::isEnabled())
+                TraceManager::addSpan("queueWait", "queue", _item.enqueueTime, std::chrono::steady_clock::now(), _item.requestId, requestAction->getActionType());
+            setRequestStatus(_item.requestId, RequestActionState::RAS_RUNNING);
+            // the wait time after the execution will not block the worker. The lane stays blocked by a timer instead
+            requestAction->setWaitAfterExecution(false);
+
+            try
+            {                    
+                logDebug("Processing Request: " + requestAction->getRequestInfo(), CURRENT_POSITION);
+                executed = requestAction->execute();                        
+                logDebug("Request processed: " + requestAction->getRequestInfo(), CURRENT_POSITION);
+            }
+            catch (Raumkernel::Exception::RaumkernelException &e)
+            {
+                if (e.type() == Raumkernel::Exception::ExceptionType::EXCEPTIONTYPE_APPCRASH)
+                    throw e;
+            }
+            catch (std::exception &e)
+            {
+                logError(e.what(), CURRENT_POSITION);
+            }
+            catch (std::string &e)
+            {
+                logError(e, CURRENT_POSITION);
+            }
+            catch (OpenHome::Exception &e)
+            {
+                logError(e.Message(), CURRENT_POSITION);;
+            }
+            catch (...)
+            {
+                logError("Unknown exception!", CURRENT_POSITION);
+            }
+
+            if (executed)
+                setRequestStatus(_item.requestId, RequestActionState::RAS_DONE);
+            else
+                setRequestStatus(_item.requestId, RequestActionState::RAS_ERROR, requestAction->getErrors());
+
+            return requestAction->getWaitTimeAfterExecution();
+        }
+
+
+        Request::RequestActionPriority RequestActionManager::getQueuedPriority(const RequestActionQueueItem &_item)
+        {
+            return _item.requestAction ? _item.requestAction->getPriority() : _item.priority;
+        }
+
+
+        bool RequestActionManager::takeNextRequestAction(RequestActionQueueItem &_item)
+        {
+            if (barrierRunning)
+                return false;
+
+            // if all other workers are busy the last one is only allowed to start high priority request actions
+            bool reserveWorker = workerCount > 1 && runningNotHighCount + 1 >= workerCount;
+            auto nextIt = requestActionQueue.end();
+            // the lanes which have a request running or waiting before the current position in the queue
+            std::unordered_set<std::string> blockedLanes = runningLanes;
+
+            for (auto it = requestActionQueue.begin(); it != requestActionQueue.end(); it++)
+            {
+                if (it->laneId.empty())
                 {
-                    if (e.type() == Raumkernel::Exception::ExceptionType::EXCEPTIONTYPE_APPCRASH)
-                        throw e;
+                    // no request behind a barrier may run before the barrier is done
+                    if (it == requestActionQueue.begin() && !runningCount)
+                        nextIt = it;
+                    break;
                 }
-                catch (std::exception &e)
+
+                if (blockedLanes.find(it->laneId) != blockedLanes.end())
+                    continue;
+                blockedLanes.insert(it->laneId);
+
+                auto priority = getQueuedPriority(*it);
+                if (reserveWorker && priority != Request::RequestActionPriority::RAP_HIGH)
+                    continue;
+                if (nextIt == requestActionQueue.end() || priority < getQueuedPriority(*nextIt))
+                    nextIt = it;
+            }
+
+            if (nextIt == requestActionQueue.end())
+                return false;
+
+            _item = *nextIt;
+            _item.priority = getQueuedPriority(_item);
+            requestActionQueue.erase(nextIt);
+
+            // if the timer was already called it is waiting for the queue lock, but it will not find the request action anymore
+            if (_item.deadlineTimerId)
+                getManagerEngineerServer()->getTimerManager()->cancelTimer(_item.deadlineTimerId);
+
+            if (_item.laneId.empty())
+                barrierRunning = true;
+            else
+                runningLanes.insert(_item.laneId);
+            if (_item.priority != Request::RequestActionPriority::RAP_HIGH)
+                runningNotHighCount++;
+            runningCount++;
+
+            auto waitTimeUS = (std::uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _item.enqueueTime).count();
+            auto &statistics = waitStatistics[_item.priority];
+            statistics.count++;
+            statistics.waitTimeSumUS += waitTimeUS;
+            if (waitTimeUS > statistics.waitTimeMaxUS)
+                statistics.waitTimeMaxUS = waitTimeUS;
+
+            return true;
+        }
+
+
+        void RequestActionManager::dropExpiredRequestAction(std::uint64_t _requestId, std::uint64_t _deadlineId)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutexRequestActionQueue);
+
+                auto it = std::find_if(requestActionQueue.begin(), requestActionQueue.end(), [_requestId](const RequestActionQueueItem &_item) { return _item.requestId == _requestId; });
+                if (it == requestActionQueue.end())
+                    return;
+                // the timer may have been called while a merge replaced the deadline of the request action
+                if (it->deadlineId != _deadlineId)
+                    return;
+
+                auto waitTimeMS = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - it->enqueueTime).count();
+                logWarning("Dropping Request (waited " + std::to_string(waitTimeMS) + "ms, deadline " + std::to_string(it->deadline) + "ms): " + it->requestAction->getRequestInfo(), CURRENT_POSITION);
+                waitStatistics[getQueuedPriority(*it)].droppedCount++;
+                setRequestStatus(it->requestId, RequestActionState::RAS_DROPPED, "Deadline of " + std::to_string(it->deadline) + "ms has passed");
+                requestActionQueue.erase(it);
+            }
+
+            // the dropped request action may have blocked its lane or a barrier
+            condRequestActionQueue.notify_all();
+        }
+
+
+        void RequestActionManager::finishRequestAction(const RequestActionQueueItem &_item)
+        {
+            runningCount--;
+            if (_item.laneId.empty())
+                barrierRunning = false;
+            else
+                runningLanes.erase(_item.laneId);
+        }
+        
+
+        void RequestActionManager::addRequestAction(std::shared_ptr<Request::RequestAction> _requestAction)
+        {
+            _requestAction->setRequestId(++lastRequestId);
+
+            // delayed or scheduled request actions (eg. play?at=<unixtime>) will wait in the timer manager, not in the queue
+            auto startDelay = _requestAction->getStartDelay();
+            if (startDelay)
+            {
+                setRequestStatus(_requestAction->getRequestId(), RequestActionState::RAS_DELAYED, "", 0, _requestAction->getRequestInfo());
+                logDebug("Delaying Request for " + std::to_string(startDelay) + "ms: " + _requestAction->getRequestInfo(), CURRENT_POSITION);
+                getManagerEngineerServer()->getTimerManager()->addTimer(startDelay, std::bind(&RequestActionManager::queueRequestAction, this, _requestAction));
+                return;
+            }
+            queueRequestAction(_requestAction);
+        }
+
+
+        void RequestActionManager::queueRequestAction(std::shared_ptr<Request::RequestAction> _requestAction)
+        {
+            TraceSpan traceSpan("enqueue", "queue", _requestAction->getRequestId(), _requestAction->getActionType());
+            RequestActionQueueItem item;
+            item.requestAction = _requestAction;
+            item.laneId = _requestAction->getExecutionLaneId();
+            item.enqueueTime = std::chrono::steady_clock::now();
+            item.deadline = _requestAction->getDeadline();
+            item.deadlineTimerId = 0;
+            item.deadlineId = 0;
+            item.priority = _requestAction->getPriority();
+            item.requestId = _requestAction->getRequestId();
+            // the status has to be set before the request is in the queue, otherwise a worker may have started it already
+            setRequestStatus(item.requestId, RequestActionState::RAS_QUEUED, "", 0, _requestAction->getRequestInfo());
+
+            {
+                std::unique_lock<std::mutex> lock(mutexRequestActionQueue);
+                if (mergeRequestAction(item))
                 {
-                    logError(e.what(), CURRENT_POSITION);
+                    mergedRequestActionCount++;
+                    return;
                 }
-                catch (std::string &e)
+                // the timer is added while holding the queue lock, so a worker can't take the request action before the timer id is stored.
+                // The timer thread never holds its lock while calling a callback, so this can't dead lock
+                if (item.deadline)
                 {
-                    logError(e, CURRENT_POSITION);
+                    item.deadlineId = ++lastDeadlineId;
+                    item.deadlineTimerId = getManagerEngineerServer()->getTimerManager()->addTimer(item.deadline, std::bind(&RequestActionManager::dropExpiredRequestAction, this, item.requestId, item.deadlineId));
                 }
-                catch (OpenHome::Exception &e)
+                requestActionQueue.push_back(item);
+            }
+            condRequestActionQueue.notify_one();
+        }
+
+
+        void RequestActionManager::addLaneJob(const std::string &_laneId, RequestActionLaneJob _job)
+        {
+            RequestActionQueueItem item;
+            item.requestAction = nullptr;
+            item.job = _job;
+            item.laneId = _laneId;
+            item.enqueueTime = std::chrono::steady_clock::now();
+            item.deadline = 0;
+            item.deadlineTimerId = 0;
+            item.deadlineId = 0;
+            item.priority = Request::RequestActionPriority::RAP_NORMAL;
+            item.requestId = 0;
+
+            {
+                std::unique_lock<std::mutex> lock(mutexRequestActionQueue);
+                requestActionQueue.push_back(item);
+            }
+            condRequestActionQueue.notify_one();
+        }
+
+
+        bool RequestActionManager::mergeRequestAction(const RequestActionQueueItem &_item)
+        {
+            // only the last waiting request action of the same lane may be merged, otherwise we would change the order of the lane.
+            // Nothing may be merged over a barrier
+            for (auto it = requestActionQueue.rbegin(); it != requestActionQueue.rend(); it++)
+            {
+                if (it->laneId != _item.laneId)
                 {
-                    logError(e.Message(), CURRENT_POSITION);;
+                    // a barrier waits for all requests before it, so it may only be merged into a barrier at the end of the queue
+                    if (it->laneId.empty() || _item.laneId.empty())
+                        return false;
+                    continue;
                 }
-                catch (...)
+
+                // nothing can be merged into a job
+                if (!it->requestAction)
+                    return false;
+
+                auto mergedRequestAction = it->requestAction->createMergedRequestAction(_item.requestAction);
+                if (!mergedRequestAction)
+                    return false;
+
+                logDebug("Merged Request: " + _item.requestAction->getRequestInfo() + " into " + it->requestAction->getRequestInfo(), CURRENT_POSITION);
+                it->requestAction = mergedRequestAction;
+
+                // the merged request action carries the newer command, so it gets the deadline of the newer one. Otherwise the deadline
+                // of the older one may drop a command which has no deadline or a later one
+                if (it->deadlineTimerId)
+                    getManagerEngineerServer()->getTimerManager()->cancelTimer(it->deadlineTimerId);
+                it->deadline = _item.deadline;
+                it->deadlineTimerId = 0;
+                it->deadlineId = 0;
+                if (it->deadline)
                 {
-                    logError("Unknown exception!", CURRENT_POSITION);
+                    it->deadlineId = ++lastDeadlineId;
+                    it->deadlineTimerId = getManagerEngineerServer()->getTimerManager()->addTimer(it->deadline, std::bind(&RequestActionManager::dropExpiredRequestAction, this, it->requestId, it->deadlineId));
                 }
 
-                mutexRequestActionQueue.unlock();
-
-                // Keep the cpu load low. the processing of the request is not very critical but should be in time
-                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                setRequestStatus(_item.requestId, RequestActionState::RAS_MERGED, "", it->requestId);
+                return true;
             }
+
+            return false;
         }
-        
 
-        void RequestActionManager::addRequestAction(std::shared_ptr<Request::RequestAction> _requestAction)
+
+        std::uint64_t RequestActionManager::getMergedRequestActionCount()
+        {
+            return mergedRequestActionCount;
+        }
+
+
+        std::map<Request::RequestActionPriority, RequestActionWaitStatistics> RequestActionManager::getWaitStatistics()
+        {
+            std::unique_lock<std::mutex> lock(mutexRequestActionQueue);
+            return waitStatistics;
+        }
+
+
+        std::uint32_t RequestActionManager::getQueueDepth()
         {
             std::unique_lock<std::mutex> lock(mutexRequestActionQueue);
-            requestActionQueue.push(_requestAction);
+            return (std::uint32_t)requestActionQueue.size();
+        }
+
+
+        std::uint32_t RequestActionManager::getRunningCount()
+        {
+            std::unique_lock<std::mutex> lock(mutexRequestActionQueue);
+            return runningCount;
+        }
+
+
+        void RequestActionManager::setStatusBufferSize(std::uint32_t _statusBufferSize)
+        {
+            std::unique_lock<std::mutex> lock(mutexRequestStatus);
+            RequestActionStatus emptyStatus = { 0, "", RequestActionState::RAS_UNKNOWN, "", 0, 0, 0, 0, 0 };
+            requestStatusBuffer.assign(_statusBufferSize ? _statusBufferSize : 1, emptyStatus);
+        }
+
+
+        void RequestActionManager::setRequestStatus(std::uint64_t _requestId, RequestActionState _state, const std::string &_error, std::uint64_t _mergedIntoRequestId, const std::string &_requestInfo)
+        {
+            auto now = (std::uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+            {
+                std::unique_lock<std::mutex> lock(mutexRequestStatus);
+
+                auto &status = requestStatusBuffer[_requestId % requestStatusBuffer.size()];
+                // a new request will overwrite the oldest status in the slot
+                if (status.requestId != _requestId)
+                {
+                    status = { _requestId, "", RequestActionState::RAS_UNKNOWN, "", 0, now, 0, 0, 0 };
+                }
+
+                if (!_requestInfo.empty())
+                    status.requestInfo = _requestInfo;
+                status.state = _state;
+                status.error = _error;
+                status.mergedIntoRequestId = _mergedIntoRequestId;
+                status.version = ++lastStatusVersion;
+                if (_state == RequestActionState::RAS_RUNNING)
+                    status.startTime = now;
+                if (_state == RequestActionState::RAS_DONE || _state == RequestActionState::RAS_ERROR || _state == RequestActionState::RAS_DROPPED || _state == RequestActionState::RAS_MERGED)
+                    status.endTime = now;
+            }
+
+            // long polling status requests for this request will be resumed. The other waiters will not be checked because of this
+            if (getManagerEngineerServer() && getManagerEngineerServer()->getLongPollManager())
+                getManagerEngineerServer()->getLongPollManager()->notifyChannelChange(Request::RequestActionReturnableLongPolling_GetRequestStatus::getRequestStatusChannel(_requestId));
+        }
+
+
+        bool RequestActionManager::getRequestStatus(std::uint64_t _requestId, RequestActionStatus &_status)
+        {
+            std::unique_lock<std::mutex> lock(mutexRequestStatus);
+
+            auto &status = requestStatusBuffer[_requestId % requestStatusBuffer.size()];
+            if (!_requestId || status.requestId != _requestId)
+                return false;
+            _status = status;
+            return true;
+        }
+
+
+        std::string RequestActionManager::requestActionStateToString(RequestActionState _state)
+        {
+            switch (_state)
+            {
+                case RequestActionState::RAS_UNKNOWN: return "unknown";
+                case RequestActionState::RAS_DELAYED: return "delayed";
+                case RequestActionState::RAS_QUEUED: return "queued";
+                case RequestActionState::RAS_RUNNING: return "running";
+                case RequestActionState::RAS_DONE: return "done";
+                case RequestActionState::RAS_ERROR: return "error";
+                case RequestActionState::RAS_DROPPED: return "dropped";
+                case RequestActionState::RAS_MERGED: return "merged";
+            }
+            return "";
         }
 
 
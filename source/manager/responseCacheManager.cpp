@@ -0,0 +1,175 @@
+#include <raumserver/manager/responseCacheManager.h>
+
+namespace Raumserver
+{
+    namespace Manager
+    {
+
+        ResponseCacheManager::ResponseCacheManager() : ManagerBaseServer()
+        {
+            maxEntries = 256;
+            accessCounter = 0;
+            hitCount = 0;
+        }
+
+
+        ResponseCacheManager::~ResponseCacheManager()
+        {
+            logDebug("Destroying ResponseCache-Manager", CURRENT_POSITION);
+        }
+
+
+        void ResponseCacheManager::setMaxEntries(std::uint32_t _maxEntries)
+        {
+            std::unique_lock<std::mutex> lock(mutexCache);
+            maxEntries = _maxEntries;
+            removeOldEntries();
+        }
+
+
+        std::uint64_t ResponseCacheManager::getHitCount()
+        {
+            std::unique_lock<std::mutex> lock(mutexCache);
+            return hitCount;
+        }
+
+
+        bool ResponseCacheManager::acquireResponse(const std::string &_key, const std::string &_updateId, ResponseCacheEntry &_entry)
+        {
+            std::unique_lock<std::mutex> lock(mutexCache);
+
+            // a cache without entries is disabled, so each request has to build its own response
+            if (!maxEntries)
+                return true;
+
+            while (true)
+            {
+                auto it = cache.find(_key);
+
+                // there is no response for the key or only one for another update id, so the caller has to build a new one
+                if (it == cache.end() || (!it->second.building && it->second.updateId != _updateId))
+                {
+                    auto &entry = cache[_key];
+                    entry.updateId = _updateId;
+                    entry.data = nullptr;
+                    entry.header.clear();
+                    entry.encodedData.clear();
+                    entry.success = false;
+                    entry.building = true;
+                    entry.lastAccess = ++accessCounter;
+                    removeOldEntries();
+                    return true;
+                }
+
+                // another request is building the response for another update id. We won't wait for that one
+                if (it->second.updateId != _updateId)
+                    return true;
+
+                if (!it->second.building)
+                {
+                    it->second.lastAccess = ++accessCounter;
+                    hitCount++;
+                    _entry = it->second;
+                    return false;
+                }
+
+                condResponseBuilt.wait(lock);
+            }
+        }
+
+
+        void ResponseCacheManager::releaseResponse(const std::string &_key, const std::string &_updateId, std::shared_ptr<const std::string> _data, const std::map<std::string, std::string> &_header, bool _success)
+        {
+            std::unique_lock<std::mutex> lock(mutexCache);
+
+            auto it = cache.find(_key);
+            if (it != cache.end() && it->second.building && it->second.updateId == _updateId)
+            {
+                // the next waiting request will try to build the response if we were not able to do it
+                if (!_data)
+                {
+                    cache.erase(it);
+                }
+                else
+                {
+                    it->second.data = _data;
+                    it->second.header = _header;
+                    it->second.success = _success;
+                    it->second.building = false;
+                }
+            }
+
+            condResponseBuilt.notify_all();
+        }
+
+
+        bool ResponseCacheManager::acquireEncodedResponse(const std::string &_key, const std::shared_ptr<const std::string> &_data, const std::string &_encoding, std::shared_ptr<const std::string> &_encodedData)
+        {
+            std::unique_lock<std::mutex> lock(mutexCache);
+
+            while (true)
+            {
+                // the data is not the one in the cache (anymore), so the caller has to encode it for itself
+                auto it = cache.find(_key);
+                if (it == cache.end() || it->second.building || it->second.data != _data)
+                    return true;
+
+                auto encodedIt = it->second.encodedData.find(_encoding);
+                if (encodedIt == it->second.encodedData.end())
+                {
+                    it->second.encodedData[_encoding] = nullptr;
+                    return true;
+                }
+
+                if (encodedIt->second)
+                {
+                    _encodedData = encodedIt->second;
+                    return false;
+                }
+
+                condResponseBuilt.wait(lock);
+            }
+        }
+
+
+        void ResponseCacheManager::releaseEncodedResponse(const std::string &_key, const std::shared_ptr<const std::string> &_data, const std::string &_encoding, std::shared_ptr<const std::string> _encodedData)
+        {
+            std::unique_lock<std::mutex> lock(mutexCache);
+
+            auto it = cache.find(_key);
+            if (it != cache.end() && !it->second.building && it->second.data == _data)
+            {
+                auto encodedIt = it->second.encodedData.find(_encoding);
+                if (encodedIt != it->second.encodedData.end() && !encodedIt->second)
+                {
+                    // the next waiting request will try to encode the data if we were not able to do it
+                    if (_encodedData)
+                        encodedIt->second = _encodedData;
+                    else
+                        it->second.encodedData.erase(encodedIt);
+                }
+            }
+
+            condResponseBuilt.notify_all();
+        }
+
+
+        void ResponseCacheManager::removeOldEntries()
+        {
+            while (cache.size() > maxEntries)
+            {
+                auto oldestIt = cache.end();
+                for (auto it = cache.begin(); it != cache.end(); it++)
+                {
+                    if (!it->second.building && (oldestIt == cache.end() || it->second.lastAccess < oldestIt->second.lastAccess))
+                        oldestIt = it;
+                }
+                // all entries are being built right now, they will be removed later
+                if (oldestIt == cache.end())
+                    return;
+                cache.erase(oldestIt);
+            }
+        }
+
+    }
+}
@@ -0,0 +1,793 @@
+#include <raumserver/manager/simulationManager.h>
+#include <raumserver/manager/managerEngineerServer.h>
+#include <algorithm>
+
+namespace Raumserver
+{
+    namespace Manager
+    {
+
+        SimulationManager::SimulationManager() : ManagerBaseServer()
+        {
+            enabled = false;
+            zoneCount = 4;
+            roomCount = 8;
+            latencyMS = 20;
+            mediaListSize = 100;
+            changeRate = 0;
+            lastZoneNumber = 0;
+            randomGenerator.seed(SIMULATION_RANDOM_SEED);
+            stopThreads = false;
+        }
+
+
+        SimulationManager::~SimulationManager()
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutexStop);
+                stopThreads = true;
+                condStop.notify_all();
+            }
+            if (changeStormThreadObject.joinable())
+            {
+                logDebug("Waiting for SimulationChangeStorm thread to finish", CURRENT_POSITION);
+                changeStormThreadObject.join();
+            }
+        }
+
+
+        void SimulationManager::setEnabled(bool _enabled)
+        {
+            enabled = _enabled;
+        }
+
+
+        bool SimulationManager::isEnabled()
+        {
+            return enabled;
+        }
+
+
+        void SimulationManager::setZoneCount(std::uint32_t _zoneCount)
+        {
+            zoneCount = _zoneCount;
+        }
+
+
+        void SimulationManager::setRoomCount(std::uint32_t _roomCount)
+        {
+            roomCount = _roomCount;
+        }
+
+
+        void SimulationManager::setLatency(std::uint32_t _latencyMS)
+        {
+            latencyMS = _latencyMS;
+        }
+
+
+        void SimulationManager::setMediaListSize(std::uint32_t _mediaListSize)
+        {
+            mediaListSize = _mediaListSize;
+        }
+
+
+        void SimulationManager::setChangeRate(std::uint32_t _changeRate)
+        {
+            changeRate = _changeRate;
+        }
+
+
+        void SimulationManager::init()
+        {
+            std::unique_lock<std::mutex> lock(mutexSimulation);
+
+            rooms.clear();
+            zones.clear();
+            for (std::uint32_t i = 0; i < roomCount; i++)
+            {
+                SimulatedRoom room;
+                room.UDN = "uuid:simulated-room-" + std::to_string(i + 1);
+                room.name = "Room " + std::to_string(i + 1);
+                room.color = "#" + std::to_string(100000 + (i * 7919) % 900000);
+                room.rendererUDN = "uuid:simulated-renderer-" + std::to_string(i + 1);
+                room.zoneUDN = "";
+                room.volume = 20;
+                room.mute = false;
+                room.standby = false;
+                rooms.push_back(room);
+            }
+
+            // the rooms are spread over the zones, so each zone has at least one room
+            auto initialZoneCount = std::min(zoneCount, roomCount);
+            for (std::uint32_t i = 0; i < initialZoneCount; i++)
+            {
+                std::vector<std::size_t> roomIndexes;
+                for (std::size_t roomIndex = i; roomIndex < rooms.size(); roomIndex += initialZoneCount)
+                    roomIndexes.push_back(roomIndex);
+                moveRoomsToZone(roomIndexes, "");
+            }
+
+            logInfo("Simulating a Raumfeld system with " + std::to_string(zones.size()) + " zones and " + std::to_string(rooms.size()) + " rooms", CURRENT_POSITION);
+
+            lock.unlock();
+
+            if (changeRate)
+                changeStormThreadObject = std::thread(&SimulationManager::changeStormThread, this);
+        }
+
+
+        bool SimulationManager::isRequestActionTypeSimulated(Request::RequestActionType _type)
+        {
+            switch (_type)
+            {
+                case Request::RequestActionType::RAA_UNDEFINED:
+                case Request::RequestActionType::RAA_KILLSESSION:
+                case Request::RequestActionType::RAA_CRASH:
+                    return false;
+                default:
+                    return true;
+            }
+        }
+
+
+        void SimulationManager::simulateLatency()
+        {
+            if (latencyMS)
+                std::this_thread::sleep_for(std::chrono::milliseconds(latencyMS));
+        }
+
+
+        std::int32_t SimulationManager::findRoom(const std::string &_id)
+        {
+            for (std::size_t i = 0; i < rooms.size(); i++)
+            {
+                if (rooms[i].name == _id || rooms[i].UDN == _id || rooms[i].rendererUDN == _id)
+                    return (std::int32_t)i;
+            }
+            return -1;
+        }
+
+
+        SimulatedZone* SimulationManager::findZone(const std::string &_id)
+        {
+            std::string zoneUDN = _id;
+            auto roomIndex = findRoom(_id);
+            if (roomIndex >= 0)
+                zoneUDN = rooms[roomIndex].zoneUDN;
+
+            for (auto &zone : zones)
+            {
+                if (zone.UDN == zoneUDN || zone.rendererUDN == zoneUDN)
+                    return &zone;
+            }
+            return nullptr;
+        }
+
+
+        std::string SimulationManager::getZoneName(const SimulatedZone &_zone)
+        {
+            std::string name;
+            for (auto roomIndex : _zone.roomIndexes)
+                name += (name.empty() ? "" : ", ") + rooms[roomIndex].name;
+            return name;
+        }
+
+
+        std::string SimulationManager::getMuteState(const SimulatedZone &_zone)
+        {
+            std::size_t muteCount = 0;
+            for (auto roomIndex : _zone.roomIndexes)
+            {
+                if (rooms[roomIndex].mute)
+                    muteCount++;
+            }
+            if (!muteCount)
+                return "MUTE_NONE";
+            return muteCount == _zone.roomIndexes.size() ? "MUTE_ALL" : "MUTE_PARTIAL";
+        }
+
+
+        void SimulationManager::signalRendererChange(const std::string &_rendererUDN)
+        {
+            getManagerEngineerServer()->getChangeSequenceManager()->bumpVersion(ChangeEntityType::CET_RENDERERSTATE, _rendererUDN);
+            getManagerEngineerServer()->getLongPollManager()->notifyChange();
+        }
+
+
+        void SimulationManager::signalZoneConfigChange()
+        {
+            // the state of all renderers and the list of all zones depend on the zone configuration (like for the kernel)
+            auto changeSequenceManager = getManagerEngineerServer()->getChangeSequenceManager();
+            changeSequenceManager->bumpVersion(ChangeEntityType::CET_ZONECONFIG);
+            changeSequenceManager->bumpVersion(ChangeEntityType::CET_RENDERERSTATE);
+            changeSequenceManager->bumpVersion(ChangeEntityType::CET_ZONEMEDIALIST);
+            getManagerEngineerServer()->getLongPollManager()->notifyChange();
+        }
+
+
+        void SimulationManager::removeRoomsFromZones(const std::vector<std::size_t> &_roomIndexes)
+        {
+            for (auto roomIndex : _roomIndexes)
+            {
+                for (auto &zone : zones)
+                    zone.roomIndexes.erase(std::remove(zone.roomIndexes.begin(), zone.roomIndexes.end(), roomIndex), zone.roomIndexes.end());
+                rooms[roomIndex].zoneUDN = "";
+            }
+            zones.erase(std::remove_if(zones.begin(), zones.end(), [](const SimulatedZone &_zone) { return _zone.roomIndexes.empty(); }), zones.end());
+        }
+
+
+        void SimulationManager::moveRoomsToZone(const std::vector<std::size_t> &_roomIndexes, const std::string &_zoneUDN)
+        {
+            if (_roomIndexes.empty())
+                return;
+
+            // the zone has to be found again after the rooms were removed, because empty zones will be erased
+            removeRoomsFromZones(_roomIndexes);
+
+            auto zoneIt = std::find_if(zones.begin(), zones.end(), [&_zoneUDN](const SimulatedZone &_zone) { return _zone.UDN == _zoneUDN; });
+            if (zoneIt == zones.end())
+            {
+                SimulatedZone zone;
+                lastZoneNumber++;
+                zone.UDN = "uuid:simulated-zone-" + std::to_string(lastZoneNumber);
+                zone.rendererUDN = "uuid:simulated-zonerenderer-" + std::to_string(lastZoneNumber);
+                zone.volume = 20;
+                zone.transportState = "STOPPED";
+                zone.playMode = "NORMAL";
+                zone.containerId = "";
+                zone.numberOfTracks = 0;
+                zone.currentTrack = 0;
+                zone.positionMS = 0;
+                zones.push_back(zone);
+                zoneIt = zones.end() - 1;
+            }
+
+            for (auto roomIndex : _roomIndexes)
+            {
+                zoneIt->roomIndexes.push_back(roomIndex);
+                rooms[roomIndex].zoneUDN = zoneIt->UDN;
+            }
+        }
+
+
+        bool SimulationManager::executeRequest(const SimulatedRequest &_request)
+        {
+            // each request is a call to a renderer or to the host, which will take its time like on the network
+            simulateLatency();
+
+            std::unique_lock<std::mutex> lock(mutexSimulation);
+
+            // the rooms of the request. A zone id stands for all rooms of the zone
+            std::vector<std::size_t> roomIndexes;
+            for (auto &id : _request.ids)
+            {
+                auto roomIndex = findRoom(id);
+                auto zone = roomIndex < 0 ? findZone(id) : nullptr;
+                if (roomIndex >= 0)
+                    roomIndexes.push_back(roomIndex);
+                else if (zone)
+                    roomIndexes.insert(roomIndexes.end(), zone->roomIndexes.begin(), zone->roomIndexes.end());
+            }
+
+            switch (_request.type)
+            {
+                case Request::RequestActionType::RAA_CREATEZONE:
+                case Request::RequestActionType::RAA_ADDTOZONE:
+                {
+                    std::string zoneUDN;
+                    if (_request.type == Request::RequestActionType::RAA_ADDTOZONE && !_request.zoneId.empty())
+                    {
+                        // no valid request if zone is not found and its defined (like for the kernel)
+                        auto zone = findZone(_request.zoneId);
+                        if (!zone)
+                            return true;
+                        zoneUDN = zone->UDN;
+                    }
+                    if (roomIndexes.empty())
+                        return true;
+                    moveRoomsToZone(roomIndexes, zoneUDN);
+                    signalZoneConfigChange();
+                    return true;
+                }
+                case Request::RequestActionType::RAA_DROPFROMZONE:
+                {
+                    if (roomIndexes.empty())
+                        return true;
+                    removeRoomsFromZones(roomIndexes);
+                    signalZoneConfigChange();
+                    return true;
+                }
+                case Request::RequestActionType::RAA_ENTERAUTOMATICSTANDBY:
+                case Request::RequestActionType::RAA_ENTERMANUALSTANDBY:
+                case Request::RequestActionType::RAA_LEAVESTANDBY:
+                {
+                    if (_request.ids.empty())
+                    {
+                        for (std::size_t i = 0; i < rooms.size(); i++)
+                            roomIndexes.push_back(i);
+                    }
+                    for (auto roomIndex : roomIndexes)
+                    {
+                        auto &room = rooms[roomIndex];
+                        room.standby = _request.type != Request::RequestActionType::RAA_LEAVESTANDBY;
+                        signalRendererChange(room.rendererUDN);
+                        auto zone = findZone(room.zoneUDN);
+                        if (zone)
+                            signalRendererChange(zone->rendererUDN);
+                    }
+                    return !roomIndexes.empty();
+                }
+                default:
+                    break;
+            }
+
+            // if we have no id provided, we do action on all renderers
+            if (_request.ids.empty())
+            {
+                for (auto &zone : zones)
+                    executeZoneRequest(_request, zone, "");
+                return true;
+            }
+
+            auto zone = findZone(_request.ids.front());
+            if (!zone)
+            {
+                logError("Room or Zone with ID: " + _request.ids.front() + " not found!", CURRENT_FUNCTION);
+                return false;
+            }
+            return executeZoneRequest(_request, *zone, _request.ids.front());
+        }
+
+
+        bool SimulationManager::executeZoneRequest(const SimulatedRequest &_request, SimulatedZone &_zone, const std::string &_id)
+        {
+            // a room id without the zone scope will only change the room (volume and mute)
+            auto roomIndex = (_id.empty() || _request.zoneScope) ? -1 : findRoom(_id);
+            auto clampVolume = [](std::int32_t _volume) { return (std::uint32_t)std::max(0, std::min(100, _volume)); };
+
+            switch (_request.type)
+            {
+                case Request::RequestActionType::RAA_PLAY:
+                    _zone.transportState = "PLAYING";
+                    break;
+                case Request::RequestActionType::RAA_PAUSE:
+                    _zone.transportState = "PAUSED_PLAYBACK";
+                    break;
+                case Request::RequestActionType::RAA_STOP:
+                    _zone.transportState = "STOPPED";
+                    _zone.positionMS = 0;
+                    break;
+                case Request::RequestActionType::RAA_NEXT:
+                    if (_zone.currentTrack < _zone.numberOfTracks)
+                        _zone.currentTrack++;
+                    _zone.positionMS = 0;
+                    break;
+                case Request::RequestActionType::RAA_PREV:
+                    if (_zone.currentTrack > 1)
+                        _zone.currentTrack--;
+                    _zone.positionMS = 0;
+                    break;
+                case Request::RequestActionType::RAA_SETVOLUME:
+                case Request::RequestActionType::RAA_VOLUMEUP:
+                case Request::RequestActionType::RAA_VOLUMEDOWN:
+                case Request::RequestActionType::RAA_FADETOVOLUME:
+                    if (roomIndex >= 0)
+                    {
+                        auto &room = rooms[roomIndex];
+                        room.volume = clampVolume(_request.relative ? (std::int32_t)room.volume + _request.value : _request.value);
+                        std::uint32_t volumeSum = 0;
+                        for (auto zoneRoomIndex : _zone.roomIndexes)
+                            volumeSum += rooms[zoneRoomIndex].volume;
+                        _zone.volume = volumeSum / (std::uint32_t)_zone.roomIndexes.size();
+                    }
+                    else
+                    {
+                        _zone.volume = clampVolume(_request.relative ? (std::int32_t)_zone.volume + _request.value : _request.value);
+                        for (auto zoneRoomIndex : _zone.roomIndexes)
+                            rooms[zoneRoomIndex].volume = clampVolume(_request.relative ? (std::int32_t)rooms[zoneRoomIndex].volume + _request.value : _request.value);
+                    }
+                    break;
+                case Request::RequestActionType::RAA_MUTE:
+                case Request::RequestActionType::RAA_UNMUTE:
+                case Request::RequestActionType::RAA_TOGGLEMUTE:
+                {
+                    bool mute = _request.type == Request::RequestActionType::RAA_MUTE;
+                    if (_request.type == Request::RequestActionType::RAA_TOGGLEMUTE)
+                        mute = roomIndex >= 0 ? !rooms[roomIndex].mute : getMuteState(_zone) != "MUTE_ALL";
+                    if (roomIndex >= 0)
+                        rooms[roomIndex].mute = mute;
+                    else
+                    {
+                        for (auto zoneRoomIndex : _zone.roomIndexes)
+                            rooms[zoneRoomIndex].mute = mute;
+                    }
+                    break;
+                }
+                case Request::RequestActionType::RAA_SETPLAYMODE:
+                    _zone.playMode = _request.text.empty() ? "NORMAL" : _request.text;
+                    std::transform(_zone.playMode.begin(), _zone.playMode.end(), _zone.playMode.begin(), ::toupper);
+                    break;
+                case Request::RequestActionType::RAA_LOADPLAYLIST:
+                case Request::RequestActionType::RAA_LOADCONTAINER:
+                case Request::RequestActionType::RAA_LOADURI:
+                case Request::RequestActionType::RAA_LOADSHUFFLE:
+                    _zone.containerId = _request.text.empty() ? "0/Simulated/Shuffle" : _request.text;
+                    _zone.numberOfTracks = _request.type == Request::RequestActionType::RAA_LOADURI ? 1 : mediaListSize;
+                    _zone.currentTrack = std::min(_zone.numberOfTracks, (std::uint32_t)std::max(_request.trackIndex, 0) + 1);
+                    _zone.positionMS = 0;
+                    _zone.transportState = "PLAYING";
+                    getManagerEngineerServer()->getChangeSequenceManager()->bumpVersion(ChangeEntityType::CET_ZONEMEDIALIST, _zone.rendererUDN);
+                    break;
+                case Request::RequestActionType::RAA_SEEK:
+                {
+                    auto seekType = Raumkernel::Tools::StringUtil::tolower(_request.text);
+                    if (seekType == "track")
+                        _zone.currentTrack = std::min(_zone.numberOfTracks, (std::uint32_t)std::max(_request.value, 1));
+                    else
+                        _zone.positionMS = std::max(0, (seekType == "rel" || seekType == "relative") ? _zone.positionMS + _request.value : _request.value);
+                    break;
+                }
+                case Request::RequestActionType::RAA_SEEKTOTRACK:
+                    _zone.currentTrack = std::min(_zone.numberOfTracks, (std::uint32_t)std::max(_request.trackIndex, 0) + 1);
+                    _zone.positionMS = 0;
+                    break;
+                default:
+                    // eg. the sleep timer does not change the state of the renderer
+                    return true;
+            }
+
+            signalRendererChange(_zone.rendererUDN);
+            return true;
+        }
+
+
+        void SimulationManager::changeStormThread()
+        {
+            double pendingChanges = 0;
+            auto lastTickTime = std::chrono::steady_clock::now();
+
+            while (!stopThreads)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(mutexStop);
+                    condStop.wait_for(lock, std::chrono::milliseconds(SIMULATION_CHANGESTORM_TICK_MS), [this] { return (bool)stopThreads; });
+                }
+                if (stopThreads)
+                    break;
+
+                // the changes are made for the time which has really elapsed, so the rate will be kept even if a tick is late
+                auto tickTime = std::chrono::steady_clock::now();
+                pendingChanges += changeRate * std::chrono::duration_cast<std::chrono::microseconds>(tickTime - lastTickTime).count() / 1000000.0;
+                lastTickTime = tickTime;
+
+                std::unique_lock<std::mutex> lock(mutexSimulation);
+                while (pendingChanges >= 1)
+                {
+                    makeRandomChange();
+                    pendingChanges -= 1;
+                }
+            }
+        }
+
+
+        void SimulationManager::makeRandomChange()
+        {
+            if (zones.empty())
+                return;
+
+            auto &zone = zones[randomGenerator() % zones.size()];
+            switch (randomGenerator() % 3)
+            {
+                case 0:
+                {
+                    // the volume of a room drifts like someone is using the knob on the device
+                    auto &room = rooms[zone.roomIndexes[randomGenerator() % zone.roomIndexes.size()]];
+                    std::int32_t change = (std::int32_t)(randomGenerator() % 7) - 3;
+                    room.volume = (std::uint32_t)std::max(0, std::min(100, (std::int32_t)room.volume + change));
+                    break;
+                }
+                case 1:
+                    if (zone.numberOfTracks)
+                        zone.currentTrack = zone.currentTrack % zone.numberOfTracks + 1;
+                    zone.positionMS = 0;
+                    break;
+                default:
+                    zone.transportState = zone.transportState == "PLAYING" ? "PAUSED_PLAYBACK" : "PLAYING";
+                    break;
+            }
+
+            signalRendererChange(zone.rendererUDN);
+        }
+
+
+        std::string SimulationManager::getRendererUDN(const std::string &_id)
+        {
+            std::unique_lock<std::mutex> lock(mutexSimulation);
+            auto zone = findZone(_id);
+            return zone ? zone->rendererUDN : "";
+        }
+
+
+        std::string SimulationManager::getExecutionLaneId(const std::string &_id)
+        {
+            // rooms will share the lane with the zone they are in, so room and zone requests for the same zone will stay in order
+            std::unique_lock<std::mutex> lock(mutexSimulation);
+            auto roomIndex = findRoom(_id);
+            if (roomIndex >= 0)
+                return rooms[roomIndex].zoneUDN.empty() ? rooms[roomIndex].UDN : rooms[roomIndex].zoneUDN;
+            auto zone = findZone(_id);
+            return zone ? zone->UDN : _id;
+        }
+
+
+        std::string SimulationManager::getZoneConfigJson()
+        {
+            rapidjson::StringBuffer jsonStringBuffer;
+            rapidjson::Writer<rapidjson::StringBuffer> jsonWriter(jsonStringBuffer);
+
+            std::unique_lock<std::mutex> lock(mutexSimulation);
+
+            auto addRoomToJson = [&jsonWriter](const SimulatedRoom &_room)
+            {
+                jsonWriter.StartObject();
+                jsonWriter.Key("UDN"); jsonWriter.String(_room.UDN.c_str());
+                jsonWriter.Key("name"); jsonWriter.String(_room.name.c_str());
+                jsonWriter.Key("color"); jsonWriter.String(_room.color.c_str());
+                jsonWriter.Key("online"); jsonWriter.Bool(true);
+                jsonWriter.EndObject();
+            };
+
+            jsonWriter.StartArray();
+            for (auto &zone : zones)
+            {
+                jsonWriter.StartObject();
+                jsonWriter.Key("UDN"); jsonWriter.String(zone.UDN.c_str());
+                jsonWriter.Key("name"); jsonWriter.String(getZoneName(zone).c_str());
+                jsonWriter.Key("rooms");
+                jsonWriter.StartArray();
+                for (auto roomIndex : zone.roomIndexes)
+                    addRoomToJson(rooms[roomIndex]);
+                jsonWriter.EndArray();
+                jsonWriter.EndObject();
+            }
+
+            // add unasigned rooms to empty zone array object
+            jsonWriter.StartObject();
+            jsonWriter.Key("UDN"); jsonWriter.String("");
+            jsonWriter.Key("name"); jsonWriter.String("");
+            jsonWriter.Key("rooms");
+            jsonWriter.StartArray();
+            for (auto &room : rooms)
+            {
+                if (room.zoneUDN.empty())
+                    addRoomToJson(room);
+            }
+            jsonWriter.EndArray();
+            jsonWriter.EndObject();
+            jsonWriter.EndArray();
+
+            return jsonStringBuffer.GetString();
+        }
+
+
+        template <typename JsonWriter>
+        void SimulationManager::addMediaItemToJson(const std::string &_containerId, std::uint32_t _index, JsonWriter &_jsonWriter)
+        {
+            auto albumNumber = std::to_string(_index / SIMULATION_ALBUM_TRACKCOUNT + 1);
+            _jsonWriter.Key("id"); _jsonWriter.String((_containerId + "/" + std::to_string(_index)).c_str());
+            _jsonWriter.Key("parentId"); _jsonWriter.String(_containerId.c_str());
+            _jsonWriter.Key("type"); _jsonWriter.String("TRACK");
+            _jsonWriter.Key("title"); _jsonWriter.String(("Track " + std::to_string(_index + 1)).c_str());
+            _jsonWriter.Key("description"); _jsonWriter.String("");
+            _jsonWriter.Key("artist"); _jsonWriter.String(("Artist " + std::to_string(_index % 17 + 1)).c_str());
+            _jsonWriter.Key("artistArtUri"); _jsonWriter.String("");
+            _jsonWriter.Key("album"); _jsonWriter.String(("Album " + albumNumber).c_str());
+            _jsonWriter.Key("albumArtUri"); _jsonWriter.String("");
+            _jsonWriter.Key("albumDate"); _jsonWriter.String("");
+            _jsonWriter.Key("albumTotalPlaytime"); _jsonWriter.String("");
+            _jsonWriter.Key("albumTrackCount"); _jsonWriter.Int(SIMULATION_ALBUM_TRACKCOUNT);
+        }
+
+
+        template <typename JsonWriter>
+        void SimulationManager::addRendererStateToJson(const SimulatedZone &_zone, JsonWriter &_jsonWriter)
+        {
+            auto name = getZoneName(_zone);
+
+            _jsonWriter.StartObject();
+            _jsonWriter.Key("udn"); _jsonWriter.String(_zone.rendererUDN.c_str());
+            _jsonWriter.Key("friendlyName"); _jsonWriter.String(name.c_str());
+            _jsonWriter.Key("name"); _jsonWriter.String(name.c_str());
+            _jsonWriter.Key("isZoneRenderer"); _jsonWriter.Bool(true);
+            _jsonWriter.Key("avTransportUri"); _jsonWriter.String(_zone.containerId.empty() ? "" : ("dlna-playcontainer://simulated?cid=" + _zone.containerId).c_str());
+            _jsonWriter.Key("bitrate"); _jsonWriter.Uint(_zone.numberOfTracks ? 320 : 0);
+            _jsonWriter.Key("volume"); _jsonWriter.Uint(_zone.volume);
+            _jsonWriter.Key("numberOfTracks"); _jsonWriter.Uint(_zone.numberOfTracks);
+            _jsonWriter.Key("currentTrack"); _jsonWriter.Uint(_zone.currentTrack);
+            _jsonWriter.Key("currentTrackDuration"); _jsonWriter.Uint(_zone.numberOfTracks ? 240 : 0);
+            _jsonWriter.Key("muteState"); _jsonWriter.String(getMuteState(_zone).c_str());
+            _jsonWriter.Key("playMode"); _jsonWriter.String(_zone.playMode.c_str());
+            _jsonWriter.Key("transportState"); _jsonWriter.String(_zone.transportState.c_str());
+
+            _jsonWriter.Key("mediaItem");
+            _jsonWriter.StartObject();
+            if (_zone.currentTrack)
+                addMediaItemToJson(_zone.containerId, _zone.currentTrack - 1, _jsonWriter);
+            _jsonWriter.EndObject();
+
+            _jsonWriter.Key("roomStates");
+            _jsonWriter.StartArray();
+            for (auto roomIndex : _zone.roomIndexes)
+            {
+                auto &room = rooms[roomIndex];
+                _jsonWriter.StartObject();
+                _jsonWriter.Key("roomUdn"); _jsonWriter.String(room.UDN.c_str());
+                _jsonWriter.Key("isMute"); _jsonWriter.Bool(room.mute);
+                _jsonWriter.Key("isOnline"); _jsonWriter.Bool(!room.standby);
+                _jsonWriter.Key("volume"); _jsonWriter.Uint(room.volume);
+                _jsonWriter.Key("transportState"); _jsonWriter.String(_zone.transportState.c_str());
+                _jsonWriter.EndObject();
+            }
+            _jsonWriter.EndArray();
+            _jsonWriter.EndObject();
+        }
+
+
+        template <typename JsonWriter>
+        void SimulationManager::addRoomRendererStateToJson(const SimulatedRoom &_room, JsonWriter &_jsonWriter)
+        {
+            _jsonWriter.StartObject();
+            _jsonWriter.Key("udn"); _jsonWriter.String(_room.rendererUDN.c_str());
+            _jsonWriter.Key("friendlyName"); _jsonWriter.String(_room.name.c_str());
+            _jsonWriter.Key("name"); _jsonWriter.String(_room.name.c_str());
+            _jsonWriter.Key("isZoneRenderer"); _jsonWriter.Bool(false);
+            _jsonWriter.Key("avTransportUri"); _jsonWriter.String("");
+            _jsonWriter.Key("bitrate"); _jsonWriter.Uint(0);
+            _jsonWriter.Key("volume"); _jsonWriter.Uint(_room.volume);
+            _jsonWriter.Key("numberOfTracks"); _jsonWriter.Uint(0);
+            _jsonWriter.Key("currentTrack"); _jsonWriter.Uint(0);
+            _jsonWriter.Key("currentTrackDuration"); _jsonWriter.Uint(0);
+            _jsonWriter.Key("muteState"); _jsonWriter.String(_room.mute ? "MUTE_ALL" : "MUTE_NONE");
+            _jsonWriter.Key("playMode"); _jsonWriter.String("NORMAL");
+            _jsonWriter.Key("transportState"); _jsonWriter.String("NO_MEDIA_PRESENT");
+            _jsonWriter.Key("mediaItem");
+            _jsonWriter.StartObject();
+            _jsonWriter.EndObject();
+            _jsonWriter.Key("roomStates");
+            _jsonWriter.StartArray();
+            _jsonWriter.EndArray();
+            _jsonWriter.EndObject();
+        }
+
+
+        bool SimulationManager::getRendererStateJson(const std::string &_id, bool _listAll, const std::unordered_set<std::string> *_changedRendererUDNs, std::string &_json)
+        {
+            rapidjson::StringBuffer jsonStringBuffer;
+            rapidjson::Writer<rapidjson::StringBuffer> jsonWriter(jsonStringBuffer);
+            bool ret = true;
+
+            auto isChanged = [_changedRendererUDNs](const std::string &_rendererUDN)
+            {
+                return !_changedRendererUDNs || _changedRendererUDNs->find(_rendererUDN) != _changedRendererUDNs->end();
+            };
+
+            std::unique_lock<std::mutex> lock(mutexSimulation);
+
+            jsonWriter.StartArray();
+            if (!_id.empty())
+            {
+                auto zone = findZone(_id);
+                if (!zone)
+                {
+                    logError("Room or Zone with ID: " + _id + " not found!", CURRENT_FUNCTION);
+                    ret = false;
+                }
+                else
+                {
+                    addRendererStateToJson(*zone, jsonWriter);
+                }
+            }
+            else
+            {
+                for (auto &zone : zones)
+                {
+                    if (isChanged(zone.rendererUDN))
+                        addRendererStateToJson(zone, jsonWriter);
+                }
+                if (_listAll)
+                {
+                    for (auto &room : rooms)
+                    {
+                        if (room.zoneUDN.empty() && isChanged(room.rendererUDN))
+                            addRoomRendererStateToJson(room, jsonWriter);
+                    }
+                }
+            }
+            jsonWriter.EndArray();
+
+            _json = jsonStringBuffer.GetString();
+            return ret;
+        }
+
+
+        bool SimulationManager::getZoneMediaListJson(const std::string &_id, std::string &_json)
+        {
+            rapidjson::StringBuffer jsonStringBuffer;
+            rapidjson::Writer<rapidjson::StringBuffer> jsonWriter(jsonStringBuffer);
+
+            auto addZoneMediaListToJson = [this, &jsonWriter](const SimulatedZone &_zone, const std::string &_udn)
+            {
+                jsonWriter.StartObject();
+                jsonWriter.Key("udn"); jsonWriter.String(_udn.c_str());
+                jsonWriter.Key("items");
+                jsonWriter.StartArray();
+                for (std::uint32_t i = 0; i < _zone.numberOfTracks; i++)
+                {
+                    jsonWriter.StartObject();
+                    addMediaItemToJson(_zone.containerId, i, jsonWriter);
+                    jsonWriter.EndObject();
+                }
+                jsonWriter.EndArray();
+                jsonWriter.EndObject();
+            };
+
+            std::unique_lock<std::mutex> lock(mutexSimulation);
+
+            jsonWriter.StartArray();
+            // the lists are written with the renderer udn for an id and with the zone udn for all zones (like for the kernel)
+            if (!_id.empty())
+            {
+                auto zone = findZone(_id);
+                if (!zone)
+                {
+                    logError("Room or Zone with ID: " + _id + " not found!", CURRENT_FUNCTION);
+                    return false;
+                }
+                addZoneMediaListToJson(*zone, zone->rendererUDN);
+            }
+            else
+            {
+                for (auto &zone : zones)
+                    addZoneMediaListToJson(zone, zone.UDN);
+            }
+            jsonWriter.EndArray();
+
+            _json = jsonStringBuffer.GetString();
+            return true;
+        }
+
+
+        void SimulationManager::loadMediaList(const std::string &_listId)
+        {
+            // the media server needs its time to browse the list. The list will signal its change when it's loaded
+            simulateLatency();
+            getManagerEngineerServer()->getChangeSequenceManager()->bumpVersion(ChangeEntityType::CET_MEDIALIST, _listId);
+            getManagerEngineerServer()->getLongPollManager()->notifyChange();
+        }
+
+
+        std::string SimulationManager::getMediaListJson(const std::string &_listId)
+        {
+            rapidjson::StringBuffer jsonStringBuffer;
+            rapidjson::Writer<rapidjson::StringBuffer> jsonWriter(jsonStringBuffer);
+
+            jsonWriter.StartObject();
+            jsonWriter.Key("id"); jsonWriter.String(_listId.c_str());
+            jsonWriter.Key("items");
+            jsonWriter.StartArray();
+            for (std::uint32_t i = 0; i < mediaListSize; i++)
+            {
+                jsonWriter.StartObject();
+                addMediaItemToJson(_listId, i, jsonWriter);
+                jsonWriter.EndObject();
+            }
+            jsonWriter.EndArray();
+            jsonWriter.EndObject();
+
+            return jsonStringBuffer.GetString();
+        }
+
+    }
+}
@@ -0,0 +1,230 @@
+#include <raumserver/manager/timerManager.h>
+
+namespace Raumserver
+{
+    namespace Manager
+    {
+
+        TimerManager::TimerManager() : ManagerBaseServer()
+        {
+            stopThreads = false;
+            currentTick = 0;
+            lastTimerId = 0;
+            startTime = std::chrono::steady_clock::now();
+
+            for (std::uint32_t level = 0; level < TIMERWHEEL_LEVELS; level++)
+                wheels[level].resize(level == 0 ? (1 << TIMERWHEEL_LEVEL0_BITS) : (1 << TIMERWHEEL_LEVELN_BITS));
+        }
+
+
+        TimerManager::~TimerManager()
+        {
+            stop();
+            logDebug("Destroying Timer-Manager", CURRENT_POSITION);
+        }
+
+
+        void TimerManager::stop()
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutexWheels);
+                stopThreads = true;
+            }
+            condTimer.notify_all();
+
+            if (timerThreadObject.joinable())
+            {
+                logDebug("Waiting for timer thread to finish", CURRENT_POSITION);
+                timerThreadObject.join();
+            }
+        }
+
+
+        void TimerManager::init()
+        {
+            timerThreadObject = std::thread(&TimerManager::timerThread, this);
+        }
+
+
+        std::uint64_t TimerManager::getCurrentTick()
+        {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count() / TIMERWHEEL_TICKMS;
+        }
+
+
+        std::uint64_t TimerManager::addTimer(std::uint32_t _delayMS, TimerCallback _callback)
+        {
+            if (!_callback)
+                return 0;
+
+            std::unique_lock<std::mutex> lock(mutexWheels);
+
+            // the timer thread does not advance the ticks while there are no timers, so we have to bring it up to date
+            if (timers.empty())
+                currentTick = getCurrentTick();
+
+            // round up to the next tick, so the timer will never be called too early
+            auto expireMS = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count() + _delayMS;
+            auto timerEntry = std::shared_ptr<TimerEntry>(new TimerEntry());
+            timerEntry->id = ++lastTimerId;
+            timerEntry->expireTick = (expireMS + TIMERWHEEL_TICKMS - 1) / TIMERWHEEL_TICKMS;
+            timerEntry->callback = _callback;
+
+            timers.insert(std::make_pair(timerEntry->id, timerEntry));
+            insertTimer(timerEntry);
+
+            lock.unlock();
+            condTimer.notify_all();
+
+            return timerEntry->id;
+        }
+
+
+        bool TimerManager::cancelTimer(std::uint64_t _timerId)
+        {
+            std::unique_lock<std::mutex> lock(mutexWheels);
+
+            auto it = timers.find(_timerId);
+            if (it == timers.end())
+                return false;
+
+            // the entry stays in its slot till the slot is processed, but it will not be called anymore
+            it->second->callback = nullptr;
+            timers.erase(it);
+            return true;
+        }
+
+
+        std::uint32_t TimerManager::getTimerCount()
+        {
+            std::unique_lock<std::mutex> lock(mutexWheels);
+            return (std::uint32_t)timers.size();
+        }
+
+
+        void TimerManager::insertTimer(std::shared_ptr<TimerEntry> _timerEntry)
+        {
+            // timers which are already expired will be called on the next tick
+            auto expireTick = _timerEntry->expireTick > currentTick ? _timerEntry->expireTick : currentTick + 1;
+            auto delta = expireTick - currentTick;
+
+            std::uint32_t shift = 0;
+            for (std::uint32_t level = 0; level < TIMERWHEEL_LEVELS; level++)
+            {
+                std::uint32_t bits = level == 0 ? TIMERWHEEL_LEVEL0_BITS : TIMERWHEEL_LEVELN_BITS;
+                std::uint64_t range = (std::uint64_t)1 << (shift + bits);
+
+                // timers which are too far in the future will be put into the last slot of the highest level 
+                // and they will be put in again when this slot is cascaded
+                if (level == TIMERWHEEL_LEVELS - 1 && delta >= range)
+                    expireTick = currentTick + range - 1;
+
+                if (delta < range || level == TIMERWHEEL_LEVELS - 1)
+                {
+                    wheels[level][(expireTick >> shift) & ((1 << bits) - 1)].push_back(_timerEntry);
+                    return;
+                }
+                shift += bits;
+            }
+        }
+
+
+        void TimerManager::advanceTick(std::list<std::shared_ptr<TimerEntry>> &_expiredTimers)
+        {
+            currentTick++;
+
+            // if a level has finished a turn, the next slot of the level above will be spread over the lower levels
+            std::uint32_t shift = TIMERWHEEL_LEVEL0_BITS;
+            for (std::uint32_t level = 1; level < TIMERWHEEL_LEVELS; level++)
+            {
+                if (currentTick & (((std::uint64_t)1 << shift) - 1))
+                    break;
+
+                auto &slot = wheels[level][(currentTick >> shift) & ((1 << TIMERWHEEL_LEVELN_BITS) - 1)];
+                std::list<std::shared_ptr<TimerEntry>> cascadeTimers;
+                cascadeTimers.swap(slot);
+                for (auto timerEntry : cascadeTimers)
+                {
+                    if (timerEntry->callback)
+                        insertTimer(timerEntry);
+                }
+                shift += TIMERWHEEL_LEVELN_BITS;
+            }
+
+            auto &slot = wheels[0][currentTick & ((1 << TIMERWHEEL_LEVEL0_BITS) - 1)];
+            for (auto timerEntry : slot)
+            {
+                if (!timerEntry->callback)
+                    continue;
+                timers.erase(timerEntry->id);
+                _expiredTimers.push_back(timerEntry);
+            }
+            slot.clear();
+        }
+
+
+        void TimerManager::timerThread()
+        {
+            std::unique_lock<std::mutex> lock(mutexWheels);
+
+            while (!stopThreads)
+            {
+                // there is no need to wake up every tick if there is no timer
+                if (timers.empty())
+                {
+                    for (auto &wheel : wheels)
+                    {
+                        for (auto &slot : wheel)
+                            slot.clear();
+                    }
+                    condTimer.wait(lock, [this] { return stopThreads || !timers.empty(); });
+                    continue;
+                }
+
+                std::list<std::shared_ptr<TimerEntry>> expiredTimers;
+                auto targetTick = getCurrentTick();
+                while (currentTick < targetTick)
+                    advanceTick(expiredTimers);
+
+                if (!expiredTimers.empty())
+                {
+                    // the callbacks are called without the lock, so they may add new timers
+                    lock.unlock();
+                    for (auto timerEntry : expiredTimers)
+                    {
+                        try
+                        {
+                            timerEntry->callback();
+                        }
+                        catch (Raumkernel::Exception::RaumkernelException &e)
+                        {
+                            if (e.type() == Raumkernel::Exception::ExceptionType::EXCEPTIONTYPE_APPCRASH)
+                                throw e;
+                        }
+                        catch (std::exception &e)
+                        {
+                            logError(e.what(), CURRENT_POSITION);
+                        }
+                        catch (std::string &e)
+                        {
+                            logError(e, CURRENT_POSITION);
+                        }
+                        catch (OpenHome::Exception &e)
+                        {
+                            logError(e.Message(), CURRENT_POSITION);;
+                        }
+                        catch (...)
+                        {
+                            logError("Unknown exception!", CURRENT_POSITION);
+                        }
+                    }
+                    lock.lock();
+                    continue;
+                }
+
+                condTimer.wait_until(lock, startTime + std::chrono::milliseconds((currentTick + 1) * TIMERWHEEL_TICKMS));
+            }
+        }
+
+    }
+}
@@ -0,0 +1,172 @@
+#include <raumserver/manager/traceManager.h>
+#include <raumserver/request/requestAction.h>
+
+namespace Raumserver
+{
+    namespace Manager
+    {
+        std::atomic<bool> TraceManager::enabled(false);
+
+        // the buffers of all threads which ever recorded a span and the buffers of ended threads which may be used again
+        static std::mutex mutexTraceBuffers;
+        static std::vector<std::shared_ptr<TraceBuffer>> traceBuffers;
+        static std::vector<TraceBuffer*> freeTraceBuffers;
+        static std::uint32_t lastTraceThreadId = 0;
+
+
+        /**
+        * gives the buffer back when the thread ends (eg. the threads of the webserver and the websocket senders when the webserver
+        * is restarted), so the buffers will not grow with each new thread
+        */
+        struct TraceBufferOwner
+        {
+            TraceBuffer *buffer = nullptr;
+
+            ~TraceBufferOwner()
+            {
+                if (!buffer)
+                    return;
+                std::unique_lock<std::mutex> lock(mutexTraceBuffers);
+                freeTraceBuffers.push_back(buffer);
+            }
+        };
+
+
+        TraceManager::TraceManager() : ManagerBaseServer()
+        {
+        }
+
+
+        TraceManager::~TraceManager()
+        {
+        }
+
+
+        void TraceManager::setEnabled(bool _enabled)
+        {
+            enabled = _enabled;
+        }
+
+
+        TraceBuffer* TraceManager::getThreadBuffer()
+        {
+            static thread_local TraceBufferOwner bufferOwner;
+            if (bufferOwner.buffer)
+                return bufferOwner.buffer;
+
+            std::unique_lock<std::mutex> lock(mutexTraceBuffers);
+            if (!freeTraceBuffers.empty())
+            {
+                bufferOwner.buffer = freeTraceBuffers.back();
+                bufferOwner.buffer->threadId = ++lastTraceThreadId;
+                freeTraceBuffers.pop_back();
+            }
+            else
+            {
+                auto buffer = std::shared_ptr<TraceBuffer>(new TraceBuffer());
+                buffer->threadId = ++lastTraceThreadId;
+                buffer->writeCount = 0;
+                buffer->events = std::unique_ptr<TraceEvent[]>(new TraceEvent[TRACE_BUFFER_SIZE]);
+                for (std::uint32_t i = 0; i < TRACE_BUFFER_SIZE; i++)
+                    buffer->events[i].sequence = 0;
+                traceBuffers.push_back(buffer);
+                bufferOwner.buffer = buffer.get();
+            }
+            return bufferOwner.buffer;
+        }
+
+
+        void TraceManager::addSpan(const char* _name, const char* _category, std::chrono::steady_clock::time_point _startTime, std::chrono::steady_clock::time_point _endTime, std::uint64_t _requestId, Request::RequestActionType _actionType)
+        {
+            auto buffer = getThreadBuffer();
+            auto index = buffer->writeCount.load(std::memory_order_relaxed);
+            auto &event = buffer->events[index % TRACE_BUFFER_SIZE];
+
+            // the odd sequence tells a reader that the span is being written, the even one which span of the ring is stored in the slot
+            event.sequence.store(index * 2 + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            event.name.store(_name, std::memory_order_relaxed);
+            event.category.store(_category, std::memory_order_relaxed);
+            event.startUS.store(std::chrono::duration_cast<std::chrono::microseconds>(_startTime.time_since_epoch()).count(), std::memory_order_relaxed);
+            event.durationUS.store(std::chrono::duration_cast<std::chrono::microseconds>(_endTime - _startTime).count(), std::memory_order_relaxed);
+            event.requestId.store(_requestId, std::memory_order_relaxed);
+            event.actionType.store((std::int32_t)_actionType, std::memory_order_relaxed);
+            event.threadId.store(buffer->threadId, std::memory_order_relaxed);
+            event.sequence.store(index * 2 + 2, std::memory_order_release);
+
+            buffer->writeCount.store(index + 1, std::memory_order_release);
+        }
+
+
+        std::string TraceManager::getTraceJson(std::uint32_t _seconds)
+        {
+            rapidjson::StringBuffer jsonStringBuffer;
+            rapidjson::Writer<rapidjson::StringBuffer> jsonWriter(jsonStringBuffer);
+            auto nowUS = (std::uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+            auto minEndUS = nowUS > (std::uint64_t)_seconds * 1000000 ? nowUS - (std::uint64_t)_seconds * 1000000 : 0;
+
+            std::unique_lock<std::mutex> lock(mutexTraceBuffers);
+
+            jsonWriter.StartObject();
+            jsonWriter.Key("displayTimeUnit"); jsonWriter.String("ms");
+            jsonWriter.Key("traceEvents");
+            jsonWriter.StartArray();
+
+            for (auto &buffer : traceBuffers)
+            {
+                auto writeCount = buffer->writeCount.load(std::memory_order_acquire);
+                auto firstIndex = writeCount > TRACE_BUFFER_SIZE ? writeCount - TRACE_BUFFER_SIZE : 0;
+
+                for (auto index = firstIndex; index < writeCount; index++)
+                {
+                    auto &event = buffer->events[index % TRACE_BUFFER_SIZE];
+
+                    // the span is skipped if the thread has overwritten it while we were reading it
+                    auto sequence = event.sequence.load(std::memory_order_acquire);
+                    if (sequence != index * 2 + 2)
+                        continue;
+                    auto name = event.name.load(std::memory_order_relaxed);
+                    auto category = event.category.load(std::memory_order_relaxed);
+                    auto startUS = event.startUS.load(std::memory_order_relaxed);
+                    auto durationUS = event.durationUS.load(std::memory_order_relaxed);
+                    auto requestId = event.requestId.load(std::memory_order_relaxed);
+                    auto actionType = (Request::RequestActionType)event.actionType.load(std::memory_order_relaxed);
+                    auto threadId = event.threadId.load(std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (event.sequence.load(std::memory_order_relaxed) != sequence)
+                        continue;
+
+                    if (startUS + durationUS < minEndUS)
+                        continue;
+
+                    jsonWriter.StartObject();
+                    jsonWriter.Key("name"); jsonWriter.String(name);
+                    jsonWriter.Key("cat"); jsonWriter.String(category);
+                    jsonWriter.Key("ph"); jsonWriter.String("X");
+                    jsonWriter.Key("ts"); jsonWriter.Uint64(startUS);
+                    jsonWriter.Key("dur"); jsonWriter.Uint64(durationUS);
+                    jsonWriter.Key("pid"); jsonWriter.Uint(1);
+                    jsonWriter.Key("tid"); jsonWriter.Uint(threadId);
+                    jsonWriter.Key("args");
+                    jsonWriter.StartObject();
+                    if (requestId)
+                    {
+                        jsonWriter.Key("requestId"); jsonWriter.Uint64(requestId);
+                    }
+                    if (actionType != Request::RequestActionType::RAA_UNDEFINED)
+                    {
+                        jsonWriter.Key("action"); jsonWriter.String(Request::RequestAction::requestActionTypeToString(actionType).c_str());
+                    }
+                    jsonWriter.EndObject();
+                    jsonWriter.EndObject();
+                }
+            }
+
+            jsonWriter.EndArray();
+            jsonWriter.EndObject();
+
+            return jsonStringBuffer.GetString();
+        }
+
+    }
+}
@@ -3,6 +3,7 @@
 #include <raumkernel/manager/managerEngineer.h>
 
 #include <signal.h>
+#include <algorithm>
 
 namespace Raumserver
 {
@@ -84,20 +85,90 @@ namespace Raumserver
 
         // set links to the manager engineer for all managers (this is a little bit of circular dependencies because the managers have a link to the
         // managerEngineer, which has links to the managers again. But this should be no problem, in this case)
+        // the timer manager has to run before the request action manager because delayed requests will use it
+        managerEngineerServer->getTimerManager()->setManagerEngineer(managerEngineerKernel);
+        managerEngineerServer->getTimerManager()->setManagerEngineerServer(managerEngineerServer);
+        managerEngineerServer->getTimerManager()->init();
+
+        auto requestWorkers = getNumericSettingValue(SETTINGS_RAUMSERVER_REQUESTWORKERS, SETTINGS_RAUMSERVER_REQUESTWORKERS_DEFAULT, 1, 256);
+        auto requestStatusBufferSize = getNumericSettingValue(SETTINGS_RAUMSERVER_REQUESTSTATUSBUFFERSIZE, SETTINGS_RAUMSERVER_REQUESTSTATUSBUFFERSIZE_DEFAULT, 1, 1000000);
+
         managerEngineerServer->getRequestActionManager()->setManagerEngineer(managerEngineerKernel);
         managerEngineerServer->getRequestActionManager()->setManagerEngineerServer(managerEngineerServer);
         managerEngineerServer->getRequestActionManager()->setKernelVersion(raumkernel->getVersionInfo());
         managerEngineerServer->getRequestActionManager()->setServerVersion(versionInfo);
+        managerEngineerServer->getRequestActionManager()->setWorkerCount(requestWorkers);
+        managerEngineerServer->getRequestActionManager()->setStatusBufferSize(requestStatusBufferSize);
         managerEngineerServer->getRequestActionManager()->init();
+
+        auto changeJournalSize = getNumericSettingValue(SETTINGS_RAUMSERVER_CHANGEJOURNALSIZE, SETTINGS_RAUMSERVER_CHANGEJOURNALSIZE_DEFAULT, 1, 1000000);
+
+        managerEngineerServer->getChangeSequenceManager()->setManagerEngineer(managerEngineerKernel);
+        managerEngineerServer->getChangeSequenceManager()->setManagerEngineerServer(managerEngineerServer);
+        managerEngineerServer->getChangeSequenceManager()->setJournalSize(changeJournalSize);
+        managerEngineerServer->getChangeSequenceManager()->init();
+
+        auto responseCacheSize = getNumericSettingValue(SETTINGS_RAUMSERVER_RESPONSECACHESIZE, SETTINGS_RAUMSERVER_RESPONSECACHESIZE_DEFAULT, 0, 100000);
+
+        managerEngineerServer->getResponseCacheManager()->setManagerEngineer(managerEngineerKernel);
+        managerEngineerServer->getResponseCacheManager()->setManagerEngineerServer(managerEngineerServer);
+        managerEngineerServer->getResponseCacheManager()->setMaxEntries(responseCacheSize);
+
+        auto longPollCheckInterval = getNumericSettingValue(SETTINGS_RAUMSERVER_LONGPOLLCHECKINTERVAL, SETTINGS_RAUMSERVER_LONGPOLLCHECKINTERVAL_DEFAULT, 10, 60000);
+        // each parked long poll holds a webserver thread, so they get their own threads and can't starve the controller calls
+        auto longPollThreads = getNumericSettingValue(SETTINGS_RAUMSERVER_LONGPOLLTHREADS, SETTINGS_RAUMSERVER_LONGPOLLTHREADS_DEFAULT, 0, 10000);
+
+        managerEngineerServer->getLongPollManager()->setManagerEngineer(managerEngineerKernel);
+        managerEngineerServer->getLongPollManager()->setManagerEngineerServer(managerEngineerServer);
+        managerEngineerServer->getLongPollManager()->setCheckInterval(longPollCheckInterval);
+        managerEngineerServer->getLongPollManager()->setMaxParkedCount(longPollThreads);
+        managerEngineerServer->getLongPollManager()->init();
+
+        managerEngineerServer->getMetricsManager()->setManagerEngineer(managerEngineerKernel);
+        managerEngineerServer->getMetricsManager()->setManagerEngineerServer(managerEngineerServer);
+
+        // the phases of the requests will only be recorded if tracing is enabled, otherwise each span only costs a check
+        std::string tracing = managerEngineerKernel->getSettingsManager()->getValue(SETTINGS_RAUMSERVER_TRACING);
+        if (tracing.empty())
+            tracing = SETTINGS_RAUMSERVER_TRACING_DEFAULT;
+
+        managerEngineerServer->getTraceManager()->setManagerEngineer(managerEngineerKernel);
+        managerEngineerServer->getTraceManager()->setManagerEngineerServer(managerEngineerServer);
+        Manager::TraceManager::setEnabled(tracing == "true" || tracing == "1");
+
+        managerEngineerServer->getLockStatisticsManager()->setManagerEngineer(managerEngineerKernel);
+        managerEngineerServer->getLockStatisticsManager()->setManagerEngineerServer(managerEngineerServer);
+
+        // the simulation replaces the Raumfeld system, so the server can be load tested without any device. The kernel is still
+        // used for the settings, but its system state will be ignored
+        std::string simulation = managerEngineerKernel->getSettingsManager()->getValue(SETTINGS_RAUMSERVER_SIMULATION);
+        if (simulation.empty())
+            simulation = SETTINGS_RAUMSERVER_SIMULATION_DEFAULT;
+        if (simulation != "true" && simulation != "1" && simulation != "false" && simulation != "0")
+        {
+            logWarning("Invalid value '" + simulation + "' for the simulation! Using '" + SETTINGS_RAUMSERVER_SIMULATION_DEFAULT + "'", CURRENT_POSITION);
+            simulation = SETTINGS_RAUMSERVER_SIMULATION_DEFAULT;
+        }
+
+        managerEngineerServer->getSimulationManager()->setManagerEngineer(managerEngineerKernel);
+        managerEngineerServer->getSimulationManager()->setManagerEngineerServer(managerEngineerServer);
+        if (simulation == "true" || simulation == "1")
+        {
+            managerEngineerServer->getSimulationManager()->setEnabled(true);
+            managerEngineerServer->getSimulationManager()->setZoneCount(getNumericSettingValue(SETTINGS_RAUMSERVER_SIMULATIONZONES, SETTINGS_RAUMSERVER_SIMULATIONZONES_DEFAULT, 0, 1000));
+            managerEngineerServer->getSimulationManager()->setRoomCount(getNumericSettingValue(SETTINGS_RAUMSERVER_SIMULATIONROOMS, SETTINGS_RAUMSERVER_SIMULATIONROOMS_DEFAULT, 1, 1000));
+            managerEngineerServer->getSimulationManager()->setLatency(getNumericSettingValue(SETTINGS_RAUMSERVER_SIMULATIONLATENCY, SETTINGS_RAUMSERVER_SIMULATIONLATENCY_DEFAULT, 0, 60000));
+            managerEngineerServer->getSimulationManager()->setMediaListSize(getNumericSettingValue(SETTINGS_RAUMSERVER_SIMULATIONMEDIALISTSIZE, SETTINGS_RAUMSERVER_SIMULATIONMEDIALISTSIZE_DEFAULT, 0, 100000));
+            managerEngineerServer->getSimulationManager()->setChangeRate(getNumericSettingValue(SETTINGS_RAUMSERVER_SIMULATIONCHANGERATE, SETTINGS_RAUMSERVER_SIMULATIONCHANGERATE_DEFAULT, 0, 100000));
+            managerEngineerServer->getSimulationManager()->init();
+            managerEngineerServer->setSystemReady(true);
+        }
  
         logDebug("Raumserver Manager-Engineer is prepared", CURRENT_POSITION);
 
-        std::string serverPort = managerEngineerKernel->getSettingsManager()->getValue(SETTINGS_RAUMSERVER_PORT);
-        if (serverPort.empty())
-        {
+        if (managerEngineerKernel->getSettingsManager()->getValue(SETTINGS_RAUMSERVER_PORT).empty())
             logWarning("No port is specified for the server! Using port '" + SETTINGS_RAUMSERVER_PORT_DEFAULT  + "'", CURRENT_POSITION);
-            serverPort = SETTINGS_RAUMSERVER_PORT_DEFAULT;
-        }
+        auto serverPort = getNumericSettingValue(SETTINGS_RAUMSERVER_PORT, SETTINGS_RAUMSERVER_PORT_DEFAULT, 1, 65535);
 
         std::string docRoot = managerEngineerKernel->getSettingsManager()->getValue(SETTINGS_RAUMSERVER_DOCROOT);
         if (docRoot.empty())
@@ -106,6 +177,19 @@ namespace Raumserver
             docRoot = SETTINGS_RAUMSERVER_DOCROOT_DEFAULT;
         }
 
+        // each long polling request will hold a thread of the webserver while it is parked, so the count of threads has to be
+        // higher than the count of long polling clients we expect
+        auto serverThreads = getNumericSettingValue(SETTINGS_RAUMSERVER_THREADS, SETTINGS_RAUMSERVER_THREADS_DEFAULT, 1, 10000);
+
+        // a kept alive connection will hold a thread of the webserver while it is waiting for the next request
+        std::string serverKeepAlive = managerEngineerKernel->getSettingsManager()->getValue(SETTINGS_RAUMSERVER_KEEPALIVE);
+        if (serverKeepAlive.empty())
+            serverKeepAlive = SETTINGS_RAUMSERVER_KEEPALIVE_DEFAULT;
+
+        // data responses will be compressed with gzip or deflate if the client accepts it. A level of 0 disables the compression
+        auto serverCompressionLevel = getNumericSettingValue(SETTINGS_RAUMSERVER_COMPRESSIONLEVEL, SETTINGS_RAUMSERVER_COMPRESSIONLEVEL_DEFAULT, 0, 9);
+        auto serverCompressionMinSize = getNumericSettingValue(SETTINGS_RAUMSERVER_COMPRESSIONMINSIZE, SETTINGS_RAUMSERVER_COMPRESSIONMINSIZE_DEFAULT, 0, 100000000);
+
         // create the webserver object and try to start it. 
         // If the Webserver can not be startet the lib will throw an error which should be non recoverable
         webserver = std::shared_ptr<Server::Webserver>(new Server::Webserver());
@@ -113,7 +197,12 @@ namespace Raumserver
         webserver->setManagerEngineerServer(managerEngineerServer);
         webserver->setLogObject(getLogObject());
         webserver->setDocumentRoot(docRoot);
-        webserver->start(std::stoi(serverPort));
+        webserver->setThreadCount(serverThreads);
+        webserver->setLongPollThreadCount(longPollThreads);
+        managerEngineerServer->getMetricsManager()->setWebserverThreadCount(serverThreads + longPollThreads);
+        webserver->setKeepAlive(serverKeepAlive == "true" || serverKeepAlive == "1");
+        webserver->setCompression((std::int32_t)serverCompressionLevel, serverCompressionMinSize);
+        webserver->start(serverPort);
     }
 
 
@@ -132,6 +221,8 @@ namespace Raumserver
     void Raumserver::onRaumfeldSystemOnline()
     {
         logInfo("Raumfeld System is now online!", CURRENT_POSITION);        
+        if (isSimulationEnabled())
+            return;
         managerEngineerServer->setSystemReady(true);
     }
 
@@ -139,6 +230,8 @@ namespace Raumserver
     void Raumserver::onRaumfeldSystemOffline()
     {
         logInfo("Raumfeld System is now offline!", CURRENT_POSITION);        
+        if (isSimulationEnabled())
+            return;
         managerEngineerServer->setSystemReady(false);
     }
 
@@ -151,6 +244,31 @@ namespace Raumserver
     }
 
 
+    bool Raumserver::isSimulationEnabled()
+    {
+        // the simulated system is always online, no matter what the kernel finds on the network
+        return managerEngineerServer && managerEngineerServer->getSimulationManager() && managerEngineerServer->getSimulationManager()->isEnabled();
+    }
+
+
+    std::uint32_t Raumserver::getNumericSettingValue(const std::string &_key, const std::string &_default, std::uint32_t _min, std::uint32_t _max)
+    {
+        std::string value = managerEngineerKernel->getSettingsManager()->getValue(_key);
+        if (value.empty())
+            return (std::uint32_t)std::stoul(_default);
+
+        // only plain numbers are valid, 'std::stoul' would accept a leading sign or trailing text and throws on anything else
+        bool valid = value.length() <= 9 && std::all_of(value.begin(), value.end(), [](char _char) { return _char >= '0' && _char <= '9'; });
+        std::uint32_t number = valid ? (std::uint32_t)std::stoul(value) : 0;
+        if (!valid || number < _min || number > _max)
+        {
+            logWarning("Invalid value '" + value + "' for the setting '" + _key + "' (" + std::to_string(_min) + " to " + std::to_string(_max) + ")! Using '" + _default + "'", CURRENT_POSITION);
+            return (std::uint32_t)std::stoul(_default);
+        }
+        return number;
+    }
+
+
     void Raumserver::onLog(Raumkernel::Log::LogData _logData)
     {
         sigLog.fire(_logData);
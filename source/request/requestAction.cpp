@@ -1,33 +1,46 @@
 
 #include <raumserver/request/requestAction.h>
 #include <raumserver/request/requestActions.h>
+#include <raumserver/request/requestActionRegistry.h>
+#include <raumserver/manager/managerEngineerServer.h>
 
 namespace Raumserver
 {
     namespace Request
     {
-        RequestAction::RequestAction(std::string _url) : RaumserverBaseMgr()
+        RequestAction::RequestAction(const std::string &_url) : RaumserverBaseMgr(), url(&arena), query(&arena), requestOptions(&arena)
         {
-            url = _url;
-            query = "";
+            url.assign(_url.c_str(), _url.length());
             sync = true;
             error = "";
             waitTimeAfterExecution = 0;
+            waitAfterExecution = true;
+            requestId = 0;
             timeout = 5000;
             waitTimeForRequestActionKernelResponse = 25;
+            managerLocksHeld = false;
+            receiver = RequestReceiver::RR_ROOM;
+            optionsParsed = false;
             action = RequestActionType::RAA_UNDEFINED;
+            priority = RequestActionPriority::RAP_NORMAL;
         }
 
-        RequestAction::RequestAction(std::string _path, std::string _query) : RaumserverBaseMgr()
+        RequestAction::RequestAction(const std::string &_path, const std::string &_query) : RaumserverBaseMgr(), url(&arena), query(&arena), requestOptions(&arena)
         {
-            url = _path;
-            query = _query;
+            url.assign(_path.c_str(), _path.length());
+            query.assign(_query.c_str(), _query.length());
             sync = true;
             error = "";
             waitTimeAfterExecution = 0;
+            waitAfterExecution = true;
+            requestId = 0;
             timeout = 5000;
             waitTimeForRequestActionKernelResponse = 25;
+            managerLocksHeld = false;
+            receiver = RequestReceiver::RR_ROOM;
+            optionsParsed = false;
             action = RequestActionType::RAA_UNDEFINED;
+            priority = RequestActionPriority::RAP_NORMAL;
         }
 
 
@@ -53,11 +66,176 @@ namespace Raumserver
         }
 
 
+        RequestActionPriority RequestAction::getPriority()
+        {
+            return priority;
+        }
+
+
+        std::string RequestAction::requestActionPriorityToString(RequestActionPriority _priority)
+        {
+            switch (_priority)
+            {
+                case RequestActionPriority::RAP_HIGH: return "high";
+                case RequestActionPriority::RAP_NORMAL: return "normal";
+                case RequestActionPriority::RAP_LOW: return "low";
+            }
+            return "";
+        }
+
+
+        std::uint32_t RequestAction::getWaitTimeAfterExecution()
+        {
+            auto waitStr = getOptionValue("wait");
+            if (!waitStr.empty())
+                return Raumkernel::Tools::CommonUtil::toUInt32(waitStr);
+            return waitTimeAfterExecution;
+        }
+
+
+        void RequestAction::setWaitAfterExecution(bool _waitAfterExecution)
+        {
+            waitAfterExecution = _waitAfterExecution;
+        }
+
+
+        std::uint32_t RequestAction::getStartDelay()
+        {
+            auto delay = getOptionValue("delay");
+            if (!delay.empty())
+                return Raumkernel::Tools::CommonUtil::toUInt32(delay);
+
+            auto at = getOptionValue("at");
+            if (!at.empty())
+            {
+                auto startTime = std::chrono::system_clock::from_time_t((std::time_t)Raumkernel::Tools::CommonUtil::toInt64(at));
+                auto now = std::chrono::system_clock::now();
+                if (startTime > now)
+                {
+                    auto delayMS = std::chrono::duration_cast<std::chrono::milliseconds>(startTime - now).count();
+                    return delayMS > UINT32_MAX ? UINT32_MAX : (std::uint32_t)delayMS;
+                }
+            }
+            return 0;
+        }
+
+
+        std::uint64_t RequestAction::getRequestId()
+        {
+            return requestId;
+        }
+
+
+        void RequestAction::setRequestId(std::uint64_t _requestId)
+        {
+            requestId = _requestId;
+        }
+
+
+        std::uint32_t RequestAction::getDeadline()
+        {
+            auto deadline = getOptionValue("deadline");
+            if (deadline.empty())
+                return 0;
+            return Raumkernel::Tools::CommonUtil::toUInt32(deadline);
+        }
+
+
         void RequestAction::parseQueryOptions()
         {
-            if (query.empty())
-                query = Raumkernel::Tools::UriUtil::getQueryFromUrl(url);
-            requestOptions = Raumkernel::Tools::UriUtil::parseQueryString(query);
+            // the options will not change after they were parsed, so they are only parsed once ('isValid' is called more than once)
+            if (optionsParsed)
+                return;
+
+            Manager::TraceSpan traceSpan("parse", "request", requestId, action);
+
+            // only a request action which was created with the whole url has to get the query from it
+            if (query.empty() && url.find('?') != RequestActionArenaString::npos)
+            {
+                auto urlQuery = Raumkernel::Tools::UriUtil::getQueryFromUrl(std::string(url.c_str(), url.length()));
+                query.assign(urlQuery.c_str(), urlQuery.length());
+            }
+
+            requestOptions.clear();
+            requestOptions.parseQuery(query.c_str(), query.length());
+
+            if (receiver == RequestReceiver::RR_JSON)
+            {
+                for (auto &option : jsonOptions)
+                    requestOptions.setOption(option.first, option.second);
+            }
+
+            optionsParsed = true;
+        }
+
+
+        bool RequestAction::setOptionsFromJson(std::string _json)
+        {
+            rapidjson::Document document;
+
+            // the json is parsed in place, so the strings will not be copied by the parser and unescaped in the buffer itself
+            // the values are only valid as long as the buffer exists, so they have to be copied before we leave
+            if (_json.empty() || document.ParseInsitu(&_json[0]).HasParseError() || !document.IsObject())
+                return false;
+
+            setOptionsFromJson(document);
+            return true;
+        }
+
+
+        void RequestAction::setOptionsFromJson(const rapidjson::Value &_options)
+        {
+            jsonOptions.clear();
+            jsonOptionsMultiple.clear();
+
+            for (auto it = _options.MemberBegin(); it != _options.MemberEnd(); it++)
+            {
+                auto key = Raumkernel::Tools::StringUtil::tolower(std::string(it->name.GetString(), it->name.GetStringLength()));
+                std::vector<std::string> values;
+
+                if (it->value.IsNull())
+                    continue;
+
+                if (it->value.IsArray())
+                {
+                    for (auto valueIt = it->value.Begin(); valueIt != it->value.End(); valueIt++)
+                        values.push_back(jsonValueToString(*valueIt));
+                }
+                else
+                {
+                    values.push_back(jsonValueToString(it->value));
+                }
+
+                // the string option is needed for the request info and for actions which do not use multiple values
+                std::string value;
+                for (auto &singleValue : values)
+                {
+                    if (!value.empty())
+                        value += ",";
+                    value += singleValue;
+                }
+
+                jsonOptions[key] = value;
+                jsonOptionsMultiple[key] = std::move(values);
+            }
+
+            receiver = RequestReceiver::RR_JSON;
+            optionsParsed = false;
+        }
+
+
+        std::string RequestAction::jsonValueToString(const rapidjson::Value &_value)
+        {
+            if (_value.IsString())
+                return std::string(_value.GetString(), _value.GetStringLength());
+            if (_value.IsBool())
+                return _value.GetBool() ? "true" : "false";
+
+            // numbers (and objects) will be taken as they are written in the json
+            rapidjson::StringBuffer valueStringBuffer;
+            rapidjson::Writer<rapidjson::StringBuffer> valueWriter(valueStringBuffer);
+            _value.Accept(valueWriter);
+            return std::string(valueStringBuffer.GetString(), valueStringBuffer.GetSize());
         }
 
 
@@ -72,19 +250,46 @@ namespace Raumserver
         }
 
 
-        std::string RequestAction::getOptionValue(std::string _key, std::string _default)
+        std::string RequestAction::getOptionValue(const std::string &_key, const std::string &_default)
         {
-            _key = Raumkernel::Tools::StringUtil::tolower(_key);
-            auto it = requestOptions.find(_key);
-            if (it == requestOptions.end())
+            RequestOptionValue value;
+            if (!requestOptions.find(_key.c_str(), _key.length(), value))
                 return _default;            
-            return it->second;
+            return value.toString();
+        }
+
+
+        RequestOptionValue RequestAction::getOptionValueView(const std::string &_key)
+        {
+            RequestOptionValue value;
+            requestOptions.find(_key.c_str(), _key.length(), value);
+            return value;
+        }
+
+
+        bool RequestAction::getOptionValueBool(const std::string &_key, bool _default)
+        {
+            auto value = getOptionValueView(_key);
+            if (value.equals("true") || value.equals("1"))
+                return true;
+            if (value.equals("false") || value.equals("0"))
+                return false;
+            return _default;
         }
 
 
-        std::vector<std::string> RequestAction::getOptionValueMultiple(std::string _key, std::string _delimiter)
+        std::vector<std::string> RequestAction::getOptionValueMultiple(const std::string &_key, const std::string &_delimiter)
         {
             std::vector<std::string> values;
+
+            // json arrays are already split, so values may even contain the delimiter
+            if (receiver == RequestReceiver::RR_JSON)
+            {
+                auto it = jsonOptionsMultiple.find(Raumkernel::Tools::StringUtil::tolower(_key));
+                if (it != jsonOptionsMultiple.end())
+                    return it->second;
+            }
+
             auto optionValue = getOptionValue(_key, "");
             if (!optionValue.empty())
                 values = Raumkernel::Tools::StringUtil::explodeString(optionValue, _delimiter);
@@ -125,6 +330,155 @@ namespace Raumserver
         }
 
 
+        std::string RequestAction::getExecutionLaneId()
+        {
+            auto idView = getOptionValueView("id");
+            if (idView.empty())
+                return "";
+            // the kernel needs the id as string
+            auto id = idView.toString();
+            if (isSimulated())
+                return getManagerEngineerServer()->getSimulationManager()->getExecutionLaneId(id);
+
+            // rooms will share the lane with the zone they are in, so room and zone requests for the same zone will stay in order
+            // we do not use 'getZoneUDNFromId' because unknown ids are not an error here
+            auto roomUDN = getManagerEngineer()->getZoneManager()->getRoomUDNForRoomName(id);
+            if (roomUDN.empty())
+                roomUDN = id;
+            if (getManagerEngineer()->getZoneManager()->existsRoomUDN(roomUDN))
+            {
+                auto zoneUDN = getManagerEngineer()->getZoneManager()->getZoneUDNForRoomUDN(roomUDN);
+                return zoneUDN.empty() ? roomUDN : zoneUDN;
+            }
+            return id;
+        }
+
+
+        bool RequestAction::getVolumeChange(bool &_relative, std::int32_t &_value)
+        {
+            return false;
+        }
+
+
+        std::shared_ptr<RequestAction> RequestAction::createMergedRequestAction(std::shared_ptr<RequestAction> _requestAction)
+        {
+            bool relative, relativeLater;
+            std::int32_t value, valueLater;
+
+            if (!getVolumeChange(relative, value) || !_requestAction->getVolumeChange(relativeLater, valueLater))
+                return nullptr;
+
+            // only merge requests for the same renderer and scope which do not need any special handling
+            if (!getOptionValueView("id").equals(_requestAction->getOptionValueView("id")) ||
+                isZoneScope(getOptionValueView("scope")) != isZoneScope(_requestAction->getOptionValueView("scope")) ||
+                !getOptionValueView("sync").equals(_requestAction->getOptionValueView("sync")) ||
+                !getOptionValueView("wait").empty() || !_requestAction->getOptionValueView("wait").empty())
+                return nullptr;
+
+            // relative changes will be summed up, the latest absolute value wins
+            if (relativeLater)
+            {
+                value += valueLater;
+                if (!relative)
+                    value = value > 100 ? 100 : (value < 0 ? 0 : value);
+            }
+            else
+            {
+                relative = false;
+                value = valueLater;
+            }
+
+            std::string mergedQuery = "value=" + std::to_string(value) + "&relative=" + (relative ? "true" : "false");
+            if (!getOptionValue("id").empty())
+                mergedQuery += "&id=" + Raumkernel::Tools::UriUtil::encodeValue(getOptionValue("id"));
+            if (!getOptionValue("scope").empty())
+                mergedQuery += "&scope=" + Raumkernel::Tools::UriUtil::encodeValue(getOptionValue("scope"));
+            if (!getOptionValue("sync").empty())
+                mergedQuery += "&sync=" + Raumkernel::Tools::UriUtil::encodeValue(getOptionValue("sync"));
+
+            auto mergedRequestAction = createFromPath("/raumserver/controller/setVolume", mergedQuery);
+            if (!mergedRequestAction)
+                return nullptr;
+
+            mergedRequestAction->setManagerEngineer(getManagerEngineer());
+            mergedRequestAction->setManagerEngineerServer(getManagerEngineerServer());
+            mergedRequestAction->setLogObject(getLogObject());
+            if (!mergedRequestAction->isValid())
+                return nullptr;
+
+            return mergedRequestAction;
+        }
+
+
+        bool RequestAction::isManagerLockSharable()
+        {
+            return true;
+        }
+
+
+        void RequestAction::setManagerLocksHeld(bool _managerLocksHeld)
+        {
+            managerLocksHeld = _managerLocksHeld;
+        }
+
+
+        void RequestAction::lockDeviceAndZoneManager()
+        {
+            if (managerLocksHeld)
+                return;
+            Manager::TraceSpan traceSpan("lockDeviceAndZoneManager", "lock", requestId, action);
+
+            // the owner of the locks is taken before the wait, so the wait can be accounted to the request action which blocked us
+            auto lockStatisticsManager = getManagerEngineerServer() ? getManagerEngineerServer()->getLockStatisticsManager() : nullptr;
+            auto ownerOnWait = lockStatisticsManager ? lockStatisticsManager->beginLockWait() : -1;
+            auto waitStartTime = std::chrono::steady_clock::now();
+
+            getManagerEngineer()->getDeviceManager()->lock();
+            getManagerEngineer()->getZoneManager()->lock();
+
+            managerLocksAcquiredTime = std::chrono::steady_clock::now();
+            if (lockStatisticsManager)
+                lockStatisticsManager->addLockAcquired(action, std::chrono::duration_cast<std::chrono::microseconds>(managerLocksAcquiredTime - waitStartTime).count(), ownerOnWait);
+        }
+
+
+        void RequestAction::unlockDeviceAndZoneManager()
+        {
+            if (managerLocksHeld)
+                return;
+
+            auto lockStatisticsManager = getManagerEngineerServer() ? getManagerEngineerServer()->getLockStatisticsManager() : nullptr;
+            if (lockStatisticsManager)
+                lockStatisticsManager->addLockReleased(action, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - managerLocksAcquiredTime).count());
+
+            getManagerEngineer()->getDeviceManager()->unlock();
+            getManagerEngineer()->getZoneManager()->unlock();
+        }
+
+
+        RequestAction::ManagerLockGuard::ManagerLockGuard(RequestAction *_requestAction)
+        {
+            requestAction = _requestAction;
+            requestAction->lockDeviceAndZoneManager();
+            locked = true;
+        }
+
+
+        RequestAction::ManagerLockGuard::~ManagerLockGuard()
+        {
+            unlock();
+        }
+
+
+        void RequestAction::ManagerLockGuard::unlock()
+        {
+            if (!locked)
+                return;
+            locked = false;
+            requestAction->unlockDeviceAndZoneManager();
+        }
+
+
        Raumkernel::Devices::MediaRenderer* RequestAction::getMediaRenderer(std::string _id)
         {
             Raumkernel::Devices::MediaRenderer* renderer = nullptr;
@@ -232,10 +586,11 @@ namespace Raumserver
         bool RequestAction::execute()
         {            
             bool ret = false;
+            bool executionMeasured = false;
             std::uint32_t waitTime = waitTimeAfterExecution;
+            std::chrono::steady_clock::time_point executionStartTime;
 
-            auto syncString = getOptionValue("sync");
-            if (syncString == "false" || syncString == "0")
+            if (!getOptionValueBool("sync", true))
                 sync = false;
 
             // check if the request is valid (mostly used for checking mandatory request options)
@@ -246,23 +601,27 @@ namespace Raumserver
 
                     // TODO: Check if system is online, otherwise don't execute!                    
 
-                    auto measurePoint1 = std::chrono::system_clock::now().time_since_epoch();
-
-                    ret = executeAction();
+                    executionStartTime = std::chrono::steady_clock::now();
 
-                    auto measurePoint2 = std::chrono::system_clock::now().time_since_epoch();
+                    {
+                        Manager::TraceSpan traceSpan("executeAction", "request", requestId, action);
+                        ret = isSimulated() ? executeActionSimulated() : executeAction();
+                    }
 
-                    // put out request process time information
-                    auto durationMS = std::chrono::duration_cast<std::chrono::milliseconds>(measurePoint2).count() - std::chrono::duration_cast<std::chrono::milliseconds>(measurePoint1).count();
-                    logDebug("Request duration: " + std::to_string(durationMS) + "ms: " + getRequestInfo(), CURRENT_FUNCTION);
+                    // put out request process time information and add it to the latency histogram of the action type
+                    auto durationUS = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - executionStartTime).count();
+                    addExecutionMetrics(durationUS, ret);
+                    executionMeasured = true;
+                    logDebug("Request duration: " + std::to_string(durationUS / 1000) + "ms: " + getRequestInfo(), CURRENT_FUNCTION);
 
                     // after execution of the request there may be a wait time we have to wait. The wait time may be provided
                     // by the query of the uri or its defined directly on the request object
-                    auto waitStr = getOptionValue("wait", "0");
-                    if (!waitStr.empty())
-                        waitTime = std::stoi(waitStr);
-                    if (waitTime)
+                    waitTime = getWaitTimeAfterExecution();
+                    if (waitTime && waitAfterExecution)
+                    {
+                        Manager::TraceSpan traceSpan("waitAfterExecution", "request", requestId, action);
                         std::this_thread::sleep_for(std::chrono::milliseconds(waitTime));
+                    }
 
                 }
                 catch (Raumkernel::Exception::RaumkernelException &e)
@@ -286,15 +645,28 @@ namespace Raumserver
                 {
                     logError("Unknown exception!", CURRENT_POSITION);
                 }
+
+                // the execution was aborted by an exception
+                if (!executionMeasured && executionStartTime.time_since_epoch().count())
+                    addExecutionMetrics(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - executionStartTime).count(), false);
             }
             else
             {                
                 logError("Invalid request options! Please validate path and query keys and values!", CURRENT_FUNCTION);
+                if (getManagerEngineerServer() && getManagerEngineerServer()->getMetricsManager())
+                    getManagerEngineerServer()->getMetricsManager()->addRequestActionError(action);
             }
             return ret;
         }
 
 
+        void RequestAction::addExecutionMetrics(std::uint64_t _durationUS, bool _success)
+        {
+            if (getManagerEngineerServer() && getManagerEngineerServer()->getMetricsManager())
+                getManagerEngineerServer()->getMetricsManager()->addRequestActionExecution(action, _durationUS, _success);
+        }
+
+
         bool RequestAction::executeAction()
         {
             // Overwrite!            
@@ -302,107 +674,77 @@ namespace Raumserver
         }
 
 
+        bool RequestAction::isSimulated()
+        {
+            return getManagerEngineerServer() && getManagerEngineerServer()->getSimulationManager() && getManagerEngineerServer()->getSimulationManager()->isEnabled();
+        }
+
+
+        bool RequestAction::executeActionSimulated()
+        {
+            auto simulationManager = getManagerEngineerServer()->getSimulationManager();
+
+            // request actions which do not call the kernel (eg. killSession) are executed as they are
+            if (!simulationManager->isRequestActionTypeSimulated(action))
+                return executeAction();
+
+            Manager::SimulatedRequest simulatedRequest;
+            simulatedRequest.type = action;
+            simulatedRequest.ids = getOptionValueMultiple("id");
+            simulatedRequest.zoneId = getOptionValue("zoneid");
+            simulatedRequest.zoneScope = isZoneScope(getOptionValue("scope"));
+            simulatedRequest.relative = getOptionValueBool("relative");
+            simulatedRequest.value = Raumkernel::Tools::CommonUtil::toInt32(getOptionValue("value"));
+            simulatedRequest.text = getOptionValue("value");
+            simulatedRequest.trackIndex = getOptionValue("trackIndex").empty() ? -1 : Raumkernel::Tools::CommonUtil::toInt32(getOptionValue("trackIndex"));
+
+            // the volume actions know best how their options are meant (eg. 'volumeDown' is a negative relative change)
+            bool relative;
+            std::int32_t value;
+            if (getVolumeChange(relative, value))
+            {
+                simulatedRequest.relative = relative;
+                simulatedRequest.value = value;
+            }
+
+            if (action == RequestActionType::RAA_SETPLAYMODE)
+                simulatedRequest.text = getOptionValue("mode");
+            else if (action == RequestActionType::RAA_SEEK)
+                simulatedRequest.text = getOptionValue("seektype");
+            else if (action == RequestActionType::RAA_SEEKTOTRACK && simulatedRequest.trackIndex < 0 && !getOptionValue("trackNumber").empty())
+                simulatedRequest.trackIndex = Raumkernel::Tools::CommonUtil::toInt32(getOptionValue("trackNumber")) - 1;
+
+            // the simulated renderers are called with the locks held like the kernel renderers, so the lock contention will be the same
+            if (!isManagerLockSharable())
+                return simulationManager->executeRequest(simulatedRequest);
+
+            ManagerLockGuard managerLockGuard(this);
+            return simulationManager->executeRequest(simulatedRequest);
+        }
+
+
         std::string RequestAction::requestActionTypeToString(RequestActionType _requestActionType)
         {            
-            if (_requestActionType == RequestActionType::RAA_NEXT) return "NEXT";
-            if (_requestActionType == RequestActionType::RAA_PAUSE) return "PAUSE";
-            if (_requestActionType == RequestActionType::RAA_PLAY) return "PLAY";
-            if (_requestActionType == RequestActionType::RAA_PREV) return "PREV";
-            if (_requestActionType == RequestActionType::RAA_SETVOLUME) return "SETVOLUME";
-            if (_requestActionType == RequestActionType::RAA_STOP) return "STOP";
-            if (_requestActionType == RequestActionType::RAA_VOLUMEDOWN) return "VOLUMEDOWN";
-            if (_requestActionType == RequestActionType::RAA_VOLUMEUP) return "VOLUMEUP";
-            if (_requestActionType == RequestActionType::RAA_VOLUMECHANGE) return "VOLUMECHANGE";
-            if (_requestActionType == RequestActionType::RAA_CREATEZONE) return "CREATEZONE";
-            if (_requestActionType == RequestActionType::RAA_ADDTOZONE) return "ADDTOZONE";
-            if (_requestActionType == RequestActionType::RAA_DROPFROMZONE) return "DROPFROMZONE";
-            if (_requestActionType == RequestActionType::RAA_MUTE) return "MUTE";
-            if (_requestActionType == RequestActionType::RAA_UNMUTE) return "UNMUTE";
-            if (_requestActionType == RequestActionType::RAA_SETPLAYMODE) return "SETPLAYMODE";
-            if (_requestActionType == RequestActionType::RAA_LOADPLAYLIST) return "LOADPLAYLIST";
-            if (_requestActionType == RequestActionType::RAA_LOADCONTAINER) return "LOADCONTAINER";
-            if (_requestActionType == RequestActionType::RAA_LOADURI) return "LOADURI";
-            if (_requestActionType == RequestActionType::RAA_SEEK) return "SEEK";
-            if (_requestActionType == RequestActionType::RAA_FADETOVOLUME) return "FADETOVOLUME";
-            if (_requestActionType == RequestActionType::RAA_TOGGLEMUTE) return "TOGGLEMUTE";
-            if (_requestActionType == RequestActionType::RAA_SLEEPTIMER) return "SLEEPTIMER";
-            if (_requestActionType == RequestActionType::RAA_SEEKTOTRACK) return "SEEKTOTRACK";
-            if (_requestActionType == RequestActionType::RAA_LOADSHUFFLE) return "LOADSHUFFLE";
-            if (_requestActionType == RequestActionType::RAA_ENTERAUTOMATICSTANDBY) return "ENTERAUTOMATICSTANDBY";
-            if (_requestActionType == RequestActionType::RAA_ENTERMANUALSTANDBY) return "ENTERMANUALSTANDBY";
-            if (_requestActionType == RequestActionType::RAA_LEAVESTANDBY) return "LEAVESTANDBY";
-            if (_requestActionType == RequestActionType::RAA_CRASH) return "CRASH";
-
-            // Returnable requests
-            if (_requestActionType == RequestActionType::RAA_GETVERSION) return "GETVERSION";
-
-            // Returnable requests with long polling ability
-            if (_requestActionType == RequestActionType::RAA_GETZONECONFIG) return "GETZONECONFIG";
-            if (_requestActionType == RequestActionType::RAA_GETMEDIALIST) return "GETMEDIALIST";
-            if (_requestActionType == RequestActionType::RAA_GETZONEMEDIALIST) return "GETZONEMEDIALIST";
-            if (_requestActionType == RequestActionType::RAA_GETRENDERERSTATE) return "GETRENDERERSTATE";
-            if (_requestActionType == RequestActionType::RAA_GETRENDERERTRANSPORTSTATE) return "GETRENDERERTRANSPORTSTATE";            
-            if (_requestActionType == RequestActionType::RAA_KILLSESSION) return "KILLSESSION";
-
-            return "";
+            auto entry = RequestActionRegistry::getInstance().findByType(_requestActionType);
+            return entry ? entry->name : "";
         }
 
 
         RequestActionType RequestAction::stringToRequestActionType(std::string _requestActionTypeString)
         {
-            _requestActionTypeString = Raumkernel::Tools::StringUtil::toupper(_requestActionTypeString);
-            if (_requestActionTypeString == "NEXT") return RequestActionType::RAA_NEXT;
-            if (_requestActionTypeString == "PAUSE") return RequestActionType::RAA_PAUSE;
-            if (_requestActionTypeString == "PLAY") return RequestActionType::RAA_PLAY;
-            if (_requestActionTypeString == "PREV") return RequestActionType::RAA_PREV;
-            if (_requestActionTypeString == "SETVOLUME") return RequestActionType::RAA_SETVOLUME;
-            if (_requestActionTypeString == "STOP") return RequestActionType::RAA_STOP;
-            if (_requestActionTypeString == "VOLUMEDOWN") return RequestActionType::RAA_VOLUMEDOWN;
-            if (_requestActionTypeString == "VOLUMEUP") return RequestActionType::RAA_VOLUMEUP;  
-            if (_requestActionTypeString == "VOLUMECHANGE") return RequestActionType::RAA_VOLUMECHANGE;
-            if (_requestActionTypeString == "CREATEZONE") return RequestActionType::RAA_CREATEZONE;
-            if (_requestActionTypeString == "ADDTOZONE") return RequestActionType::RAA_ADDTOZONE;
-            if (_requestActionTypeString == "DROPFROMZONE") return RequestActionType::RAA_DROPFROMZONE;
-            if (_requestActionTypeString == "MUTE") return RequestActionType::RAA_MUTE;
-            if (_requestActionTypeString == "UNMUTE") return RequestActionType::RAA_UNMUTE;
-            if (_requestActionTypeString == "SETPLAYMODE") return RequestActionType::RAA_SETPLAYMODE;
-            if (_requestActionTypeString == "LOADPLAYLIST") return RequestActionType::RAA_LOADPLAYLIST;
-            if (_requestActionTypeString == "LOADCONTAINER") return RequestActionType::RAA_LOADCONTAINER;
-            if (_requestActionTypeString == "LOADURI") return RequestActionType::RAA_LOADURI; 
-            if (_requestActionTypeString == "SEEK") return RequestActionType::RAA_SEEK;
-            if (_requestActionTypeString == "FADETOVOLUME") return RequestActionType::RAA_FADETOVOLUME;
-            if (_requestActionTypeString == "TOGGLEMUTE") return RequestActionType::RAA_TOGGLEMUTE;
-            if (_requestActionTypeString == "SLEEPTIMER") return RequestActionType::RAA_SLEEPTIMER;
-            if (_requestActionTypeString == "SEEKTOTRACK") return RequestActionType::RAA_SEEKTOTRACK;
-            if (_requestActionTypeString == "LOADSHUFFLE") return RequestActionType::RAA_LOADSHUFFLE;
-            if (_requestActionTypeString == "ENTERAUTOMATICSTANDBY") return RequestActionType::RAA_ENTERAUTOMATICSTANDBY;
-            if (_requestActionTypeString == "ENTERMANUALSTANDBY") return RequestActionType::RAA_ENTERMANUALSTANDBY;
-            if (_requestActionTypeString == "LEAVESTANDBY") return RequestActionType::RAA_LEAVESTANDBY;
-            if (_requestActionTypeString == "CRASH") return RequestActionType::RAA_CRASH;
-
-            // Returnable requests
-            if (_requestActionTypeString == "GETVERSION") return RequestActionType::RAA_GETVERSION;       
-
-            // Returnable requests with long polling ability
-            if (_requestActionTypeString == "GETZONECONFIG") return RequestActionType::RAA_GETZONECONFIG;
-            if (_requestActionTypeString == "GETMEDIALIST") return RequestActionType::RAA_GETMEDIALIST;
-            if (_requestActionTypeString == "GETZONEMEDIALIST") return RequestActionType::RAA_GETZONEMEDIALIST;
-            if (_requestActionTypeString == "GETRENDERERSTATE") return RequestActionType::RAA_GETRENDERERSTATE;
-            if (_requestActionTypeString == "GETRENDERERTRANSPORTSTATE") return RequestActionType::RAA_GETRENDERERTRANSPORTSTATE;
-            if (_requestActionTypeString == "KILLSESSION") return RequestActionType::RAA_KILLSESSION;
-
-            return RequestActionType::RAA_UNDEFINED;
+            auto entry = RequestActionRegistry::getInstance().findByName(_requestActionTypeString.c_str(), _requestActionTypeString.length());
+            return entry ? entry->type : RequestActionType::RAA_UNDEFINED;
         }
 
 
         std::string RequestAction::getRequestInfo()
         {
             std::string options;
-            for (auto it : requestOptions)
+            for (std::size_t i = 0; i < requestOptions.size(); i++)
             {
                 if (!options.empty())
                     options += " | ";
-                options += it.first + ": " + it.second;
+                options += requestOptions.getKey(i).toString() + ": " + requestOptions.getValue(i).toString();
             }
             return RequestAction::requestActionTypeToString(action) + " / " + options;
         }
@@ -429,63 +771,34 @@ namespace Raumserver
         }
 
 
-        std::shared_ptr<RequestAction> RequestAction::createFromPath(std::string _path, std::string _queryString)
-        {          
-            auto pathParts = Raumkernel::Tools::StringUtil::explodeString(_path, "/");
-            // first path has to be empty, the second "raumserver" and the third path has to be "controller"
-            // the third one should be the action. if there is another pathPart than we do have a problem
-            if (pathParts.size() != 4)
-                return nullptr;
-
-            std::string action = pathParts[3];
+        bool RequestAction::isZoneScope(const RequestOptionValue &_scope)
+        {
+            return _scope.equalsLowerCase("zone");
+        }
 
-            auto actionType = RequestAction::stringToRequestActionType(action);
 
-            switch (actionType)
+        std::shared_ptr<RequestAction> RequestAction::createFromPath(const std::string &_path, const std::string &_queryString)
+        {          
+            // first path part has to be empty, the second "raumserver" and the third path has to be "controller" (or "data")
+            // the fourth one should be the action. if there is another pathPart than we do have a problem
+            // the action is looked up directly from the path, so the path does not have to be split
+            std::size_t slashCount = 0, actionPos = 0;
+            for (std::size_t i = 0; i < _path.length(); i++)
             {
-                case RequestActionType::RAA_UNDEFINED: return nullptr;
-                case RequestActionType::RAA_NEXT: return std::shared_ptr<RequestAction_Next>(new RequestAction_Next(_path, _queryString));
-                case RequestActionType::RAA_PAUSE: return std::shared_ptr<RequestAction_Pause>(new RequestAction_Pause(_path, _queryString));
-                case RequestActionType::RAA_PLAY: return std::shared_ptr<RequestAction_Play>(new RequestAction_Play(_path, _queryString));
-                case RequestActionType::RAA_PREV: return std::shared_ptr<RequestAction_Prev>(new RequestAction_Prev(_path, _queryString));               
-                case RequestActionType::RAA_STOP: return std::shared_ptr<RequestAction_Stop>(new RequestAction_Stop(_path, _queryString));
-                case RequestActionType::RAA_SETVOLUME: return std::shared_ptr<RequestAction_SetVolume>(new RequestAction_SetVolume(_path, _queryString));
-                case RequestActionType::RAA_VOLUMEDOWN: return std::shared_ptr<RequestAction_VolumeDown>(new RequestAction_VolumeDown(_path, _queryString));
-                case RequestActionType::RAA_VOLUMEUP: return std::shared_ptr<RequestAction_VolumeUp>(new RequestAction_VolumeUp(_path, _queryString));                
-                case RequestActionType::RAA_CREATEZONE: return std::shared_ptr<RequestAction_CreateZone>(new RequestAction_CreateZone(_path, _queryString));
-                case RequestActionType::RAA_ADDTOZONE: return std::shared_ptr<RequestAction_AddToZone>(new RequestAction_AddToZone(_path, _queryString));
-                case RequestActionType::RAA_DROPFROMZONE: return std::shared_ptr<RequestAction_DropFromZone>(new RequestAction_DropFromZone(_path, _queryString));
-                case RequestActionType::RAA_MUTE: return std::shared_ptr<RequestAction_Mute>(new RequestAction_Mute(_path, _queryString));
-                case RequestActionType::RAA_UNMUTE: return std::shared_ptr<RequestAction_Unmute>(new RequestAction_Unmute(_path, _queryString));
-                case RequestActionType::RAA_SETPLAYMODE: return std::shared_ptr<RequestAction_SetPlayMode>(new RequestAction_SetPlayMode(_path, _queryString));
-                case RequestActionType::RAA_LOADPLAYLIST: return std::shared_ptr<RequestAction_LoadPlaylist>(new RequestAction_LoadPlaylist(_path, _queryString));
-                case RequestActionType::RAA_LOADCONTAINER: return std::shared_ptr<RequestAction_LoadContainer>(new RequestAction_LoadContainer(_path, _queryString));
-                case RequestActionType::RAA_LOADURI: return std::shared_ptr<RequestAction_LoadUri>(new RequestAction_LoadUri(_path, _queryString));
-                case RequestActionType::RAA_SEEK: return std::shared_ptr<RequestAction_Seek>(new RequestAction_Seek(_path, _queryString));
-                case RequestActionType::RAA_SEEKTOTRACK:return std::shared_ptr<RequestAction_SeekToTrack>(new RequestAction_SeekToTrack(_path, _queryString));;
-                case RequestActionType::RAA_FADETOVOLUME: return std::shared_ptr<RequestAction_FadeToVolume>(new RequestAction_FadeToVolume(_path, _queryString));
-                case RequestActionType::RAA_TOGGLEMUTE: return std::shared_ptr<RequestAction_ToggleMute>(new RequestAction_ToggleMute(_path, _queryString));
-                case RequestActionType::RAA_SLEEPTIMER: return std::shared_ptr<RequestAction_SleepTimer>(new RequestAction_SleepTimer(_path, _queryString));
-                case RequestActionType::RAA_LOADSHUFFLE: return std::shared_ptr<RequestAction_LoadShuffle>(new RequestAction_LoadShuffle(_path, _queryString));
-                case RequestActionType::RAA_ENTERAUTOMATICSTANDBY: return std::shared_ptr<RequestAction_EnterAutomaticStandby>(new RequestAction_EnterAutomaticStandby(_path, _queryString));
-                case RequestActionType::RAA_ENTERMANUALSTANDBY: return std::shared_ptr<RequestAction_EnterManualStandby>(new RequestAction_EnterManualStandby(_path, _queryString));
-                case RequestActionType::RAA_LEAVESTANDBY: return std::shared_ptr<RequestAction_LeaveStandby>(new RequestAction_LeaveStandby(_path, _queryString));
-                case RequestActionType::RAA_CRASH: return std::shared_ptr<RequestAction_Crash>(new RequestAction_Crash(_path, _queryString));
-                case RequestActionType::RAA_KILLSESSION: return std::shared_ptr<RequestAction_KillSession>(new RequestAction_KillSession(_path, _queryString));
-
-                 // Returnable requests 
-                case RequestActionType::RAA_GETVERSION: return std::shared_ptr<RequestActionReturnable_GetVersion>(new RequestActionReturnable_GetVersion(_path, _queryString));
-
-                // Returnable requests with long polling ability
-                case RequestActionType::RAA_GETZONECONFIG: return std::shared_ptr<RequestActionReturnableLongPolling_GetZoneConfig>(new RequestActionReturnableLongPolling_GetZoneConfig(_path, _queryString));
-                case RequestActionType::RAA_GETMEDIALIST: return std::shared_ptr<RequestActionReturnableLongPolling_GetMediaList>(new RequestActionReturnableLongPolling_GetMediaList(_path, _queryString));
-                case RequestActionType::RAA_GETZONEMEDIALIST: return std::shared_ptr<RequestActionReturnableLongPolling_GetZoneMediaList>(new RequestActionReturnableLongPolling_GetZoneMediaList(_path, _queryString));
-                case RequestActionType::RAA_GETRENDERERSTATE: return std::shared_ptr<RequestActionReturnableLongPolling_GetRendererState>(new RequestActionReturnableLongPolling_GetRendererState(_path, _queryString));
-                case RequestActionType::RAA_GETRENDERERTRANSPORTSTATE: return std::shared_ptr<RequestActionReturnableLongPolling_GetRendererTransportState>(new RequestActionReturnableLongPolling_GetRendererTransportState(_path, _queryString));
+                if (_path[i] == '/')
+                {
+                    slashCount++;
+                    actionPos = i + 1;
+                }
             }
-            
+            if (slashCount != 3 || _path[0] != '/' || actionPos >= _path.length())
+                return nullptr;
+
+            auto entry = RequestActionRegistry::getInstance().findByName(_path.c_str() + actionPos, _path.length() - actionPos);
+            if (!entry || !entry->factory)
+                return nullptr;
 
-            return nullptr;
+            return entry->factory(_path, _queryString);
         }
         
 
@@ -0,0 +1,369 @@
+#include <raumserver/request/requestActionBatch.h>
+#include <raumserver/request/requestActions.h>
+#include <raumserver/manager/managerEngineerServer.h>
+
+namespace Raumserver
+{
+    namespace Request
+    {
+
+        RequestActionBatch::RequestActionBatch() : RaumserverBaseMgr()
+        {
+            mode = RequestActionBatchMode::RABM_ORDERED;
+            stopOnError = false;
+            stopped = false;
+            runningLaneJobs = 0;
+        }
+
+
+        RequestActionBatch::~RequestActionBatch()
+        {
+        }
+
+
+        void RequestActionBatch::setMode(RequestActionBatchMode _mode)
+        {
+            mode = _mode;
+        }
+
+
+        void RequestActionBatch::setStopOnError(bool _stopOnError)
+        {
+            stopOnError = _stopOnError;
+        }
+
+
+        const std::vector<RequestActionBatchItem>& RequestActionBatch::getItems()
+        {
+            return items;
+        }
+
+
+        void RequestActionBatch::addItem(const std::string &_action, const std::string &_query)
+        {
+            RequestActionBatchItem item;
+            item.action = _action;
+            item.state = RequestActionBatchItemState::RABS_WAITING;
+            item.error = "";
+            item.delayed = false;
+            // the same factory as for the single requests, so there is no difference between a batch item and a request
+            item.requestAction = _action.empty() ? nullptr : RequestAction::createFromPath("/raumserver/controller/" + _action, _query);
+            items.push_back(item);
+        }
+
+
+        bool RequestActionBatch::addItemsFromJson(const std::string &_json)
+        {
+            rapidjson::Document document;
+            std::string json = _json;
+
+            // the json is parsed in place. The request actions will copy the option values, so the buffer may be destroyed afterwards
+            if (json.empty() || document.ParseInsitu(&json[0]).HasParseError() || !document.IsArray())
+                return false;
+
+            for (auto it = document.Begin(); it != document.End(); it++)
+            {
+                std::string action = "";
+
+                if (it->IsObject() && it->HasMember("action") && (*it)["action"].IsString())
+                    action = (*it)["action"].GetString();
+
+                addItem(action, "");
+
+                // the options are given to the request action as they are, so there is no need for escaping them to a query string
+                auto &item = items.back();
+                if (item.requestAction && it->HasMember("options") && (*it)["options"].IsObject())
+                    item.requestAction->setOptionsFromJson((*it)["options"]);
+            }
+
+            return true;
+        }
+
+
+        bool RequestActionBatch::execute()
+        {
+            bool hasInvalidItems = false;
+            stopped = false;
+
+            // all items will be validated before anything is executed, so a typo in the last item will not leave a half done scene
+            for (auto &item : items)
+            {
+                if (!item.requestAction)
+                {
+                    item.state = RequestActionBatchItemState::RABS_INVALID;
+                    item.error = "Action '" + item.action + "' not found! Please check to the documentation for valid requests!";
+                    hasInvalidItems = true;
+                    continue;
+                }
+
+                item.requestAction->setManagerEngineer(getManagerEngineer());
+                item.requestAction->setManagerEngineerServer(getManagerEngineerServer());
+                item.requestAction->setLogObject(getLogObject());
+
+                // returnable request actions can't be part of a batch, their data would have to be embedded in the result
+                if (std::dynamic_pointer_cast<RequestActionReturnable>(item.requestAction))
+                {
+                    item.state = RequestActionBatchItemState::RABS_INVALID;
+                    item.error = "Action '" + item.action + "' returns data and can't be executed in a batch!";
+                    hasInvalidItems = true;
+                }
+                else if (!item.requestAction->isValid())
+                {
+                    item.state = RequestActionBatchItemState::RABS_INVALID;
+                    item.error = item.requestAction->getErrors();
+                    hasInvalidItems = true;
+                }
+            }
+
+            if (hasInvalidItems && stopOnError)
+                stopped = true;
+
+            if (mode == RequestActionBatchMode::RABM_PARALLEL)
+            {
+                executeParallel();
+            }
+            else
+            {
+                // the items share the locks of the device and zone manager, so the whole batch runs in one lane. If the items are for 
+                // different zones the batch will be a barrier for all lanes
+                std::vector<std::size_t> itemIndexes;
+                std::string laneId;
+                bool singleLane = true;
+                for (std::size_t i = 0; i < items.size(); i++)
+                {
+                    itemIndexes.push_back(i);
+                    if (items[i].state != RequestActionBatchItemState::RABS_WAITING)
+                        continue;
+                    auto itemLaneId = items[i].requestAction->getExecutionLaneId();
+                    if (itemLaneId.empty() || (!laneId.empty() && itemLaneId != laneId))
+                        singleLane = false;
+                    laneId = itemLaneId;
+                }
+                // the job is called again after each wait, so the position is shared by all calls
+                auto position = std::make_shared<std::size_t>(0);
+                addLaneJob(singleLane ? laneId : "", [this, itemIndexes, position] { return executeOrdered(itemIndexes, *position, true); });
+                waitForLaneJobs();
+            }
+
+            bool success = true;
+            for (auto &item : items)
+            {
+                // jobs which were dropped because the server is stopping have not executed their items
+                if (item.state == RequestActionBatchItemState::RABS_WAITING)
+                    item.state = RequestActionBatchItemState::RABS_SKIPPED;
+                if (item.state != RequestActionBatchItemState::RABS_DONE)
+                    success = false;
+            }
+            return success;
+        }
+
+
+        void RequestActionBatch::executeItem(RequestActionBatchItem &_item)
+        {
+            logDebug("Processing Batch Request: " + _item.requestAction->getRequestInfo(), CURRENT_POSITION);
+
+            bool executed = _item.requestAction->execute();
+            _item.state = executed ? RequestActionBatchItemState::RABS_DONE : RequestActionBatchItemState::RABS_ERROR;
+            _item.error = _item.requestAction->getErrors();
+
+            if (!executed && stopOnError)
+                stopped = true;
+        }
+
+
+        std::uint32_t RequestActionBatch::executeOrdered(const std::vector<std::size_t> &_itemIndexes, std::size_t &_position, bool _shareManagerLocks)
+        {
+            // the batch is the owner of the shared locks, so the wait and hold times are added to its statistics. The guard will
+            // release the locks on an exception and when the lane has to wait
+            Manager::ManagerLockOwnerGuard managerLockGuard(getManagerEngineer(), getManagerEngineerServer()->getLockStatisticsManager(), Manager::LockOwner::LO_BATCH, false);
+
+            for (; _position < _itemIndexes.size(); _position++)
+            {
+                auto &item = items[_itemIndexes[_position]];
+                if (item.state != RequestActionBatchItemState::RABS_WAITING)
+                    continue;
+                if (stopped)
+                {
+                    item.state = RequestActionBatchItemState::RABS_SKIPPED;
+                    continue;
+                }
+
+                // a delayed item lets its lane wait on a timer, after that the job is called again and the item is executed
+                if (!item.delayed)
+                {
+                    item.delayed = true;
+                    auto startDelay = item.requestAction->getStartDelay();
+                    if (startDelay)
+                        return startDelay;
+                }
+
+                // following request actions will share the lock of the device and zone manager. Request actions which have to wait
+                // for the kernel will be executed without the lock, so the kernel can apply their changes
+                bool shareLock = _shareManagerLocks && item.requestAction->isManagerLockSharable();
+                if (shareLock)
+                    managerLockGuard.lock();
+                else
+                    managerLockGuard.unlock();
+
+                // the wait time after the execution is meant to give the kernel the time to get the changes. The lane will wait on a timer 
+                // without the lock, so the worker does not sleep
+                item.requestAction->setManagerLocksHeld(managerLockGuard.isLocked());
+                item.requestAction->setWaitAfterExecution(false);
+                executeItem(item);
+
+                auto waitTime = item.requestAction->getWaitTimeAfterExecution();
+                if (waitTime && !stopped)
+                {
+                    _position++;
+                    return waitTime;
+                }
+            }
+
+            return 0;
+        }
+
+
+        void RequestActionBatch::executeParallel()
+        {
+            // the items of one lane are executed in order, the lanes will run in parallel on the request workers. The lanes will not share 
+            // the manager locks, otherwise one lane would block the others while it is executing
+            std::map<std::string, std::vector<std::size_t>> laneItemIndexes;
+
+            auto addLanes = [this, &laneItemIndexes]()
+            {
+                for (auto &lane : laneItemIndexes)
+                {
+                    auto itemIndexes = lane.second;
+                    auto position = std::make_shared<std::size_t>(0);
+                    addLaneJob(lane.first, [this, itemIndexes, position] { return executeOrdered(itemIndexes, *position, false); });
+                }
+                laneItemIndexes.clear();
+            };
+
+            for (std::size_t i = 0; i < items.size(); i++)
+            {
+                if (items[i].state != RequestActionBatchItemState::RABS_WAITING)
+                    continue;
+
+                // a request action without a lane (eg. a zone change or an action for all zones) is a barrier in the queue, 
+                // so it will wait for all items before and the items after will wait for it
+                auto laneId = items[i].requestAction->getExecutionLaneId();
+                if (laneId.empty())
+                {
+                    addLanes();
+                    auto position = std::make_shared<std::size_t>(0);
+                    addLaneJob("", [this, i, position] { return executeOrdered({ i }, *position, false); });
+                }
+                else
+                {
+                    laneItemIndexes[laneId].push_back(i);
+                }
+            }
+
+            addLanes();
+            waitForLaneJobs();
+        }
+
+
+        void RequestActionBatch::addLaneJob(const std::string &_laneId, std::function<std::uint32_t()> _job)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutexLaneJobs);
+                runningLaneJobs++;
+            }
+
+            getManagerEngineerServer()->getRequestActionManager()->addLaneJob(_laneId, [this, _job](bool _execute) -> std::uint32_t
+            {
+                std::exception_ptr jobException;
+                if (_execute)
+                {
+                    try
+                    {
+                        // the job is not done yet, it will be called again when its lane has waited
+                        auto waitTime = _job();
+                        if (waitTime)
+                            return waitTime;
+                    }
+                    catch (...)
+                    {
+                        jobException = std::current_exception();
+                    }
+                }
+
+                std::unique_lock<std::mutex> lock(mutexLaneJobs);
+                if (jobException && !laneJobException)
+                    laneJobException = jobException;
+                runningLaneJobs--;
+                condLaneJobs.notify_all();
+                return 0;
+            });
+        }
+
+
+        void RequestActionBatch::waitForLaneJobs()
+        {
+            std::unique_lock<std::mutex> lock(mutexLaneJobs);
+            condLaneJobs.wait(lock, [this] { return runningLaneJobs == 0; });
+
+            if (laneJobException)
+            {
+                auto jobException = laneJobException;
+                laneJobException = nullptr;
+                std::rethrow_exception(jobException);
+            }
+        }
+
+
+        std::string RequestActionBatch::getResultJson()
+        {
+            rapidjson::StringBuffer jsonStringBuffer;
+            rapidjson::Writer<rapidjson::StringBuffer> jsonWriter(jsonStringBuffer);
+            bool error = false;
+
+            jsonWriter.StartObject();
+            jsonWriter.Key("mode"); jsonWriter.String(mode == RequestActionBatchMode::RABM_PARALLEL ? "parallel" : "ordered");
+            jsonWriter.Key("stopOnError"); jsonWriter.Bool(stopOnError);
+            jsonWriter.Key("results");
+            jsonWriter.StartArray();
+            for (auto &item : items)
+            {
+                jsonWriter.StartObject();
+                jsonWriter.Key("action"); jsonWriter.String(item.action.c_str());
+                jsonWriter.Key("state"); jsonWriter.String(itemStateToString(item.state).c_str());
+                jsonWriter.Key("error"); jsonWriter.String(item.error.c_str());
+                jsonWriter.EndObject();
+
+                if (item.state != RequestActionBatchItemState::RABS_DONE)
+                    error = true;
+            }
+            jsonWriter.EndArray();
+            jsonWriter.Key("error"); jsonWriter.Bool(error);
+            jsonWriter.EndObject();
+
+            return jsonStringBuffer.GetString();
+        }
+
+
+        std::string RequestActionBatch::itemStateToString(RequestActionBatchItemState _state)
+        {
+            switch (_state)
+            {
+                case RequestActionBatchItemState::RABS_WAITING: return "waiting";
+                case RequestActionBatchItemState::RABS_INVALID: return "invalid";
+                case RequestActionBatchItemState::RABS_DONE: return "done";
+                case RequestActionBatchItemState::RABS_ERROR: return "error";
+                case RequestActionBatchItemState::RABS_SKIPPED: return "skipped";
+            }
+            return "";
+        }
+
+
+        RequestActionBatchMode RequestActionBatch::stringToMode(const std::string &_mode)
+        {
+            if (Raumkernel::Tools::StringUtil::tolower(_mode) == "parallel")
+                return RequestActionBatchMode::RABM_PARALLEL;
+            return RequestActionBatchMode::RABM_ORDERED;
+        }
+
+    }
+}
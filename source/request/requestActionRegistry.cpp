@@ -0,0 +1,96 @@
+#include <raumserver/request/requestActionRegistry.h>
+#include <raumserver/request/requestActions.h>
+
+namespace Raumserver
+{
+    namespace Request
+    {
+
+        RequestActionRegistry::RequestActionRegistry()
+        {
+            // the request actions of the library. A new request action only needs its type and a line here
+            // there are no static registration objects in the request action files because the linker would drop them from the static library
+            registerRequestAction(RequestActionType::RAA_NEXT, "NEXT", &createRequestAction<RequestAction_Next>);
+            registerRequestAction(RequestActionType::RAA_PAUSE, "PAUSE", &createRequestAction<RequestAction_Pause>);
+            registerRequestAction(RequestActionType::RAA_PLAY, "PLAY", &createRequestAction<RequestAction_Play>);
+            registerRequestAction(RequestActionType::RAA_PREV, "PREV", &createRequestAction<RequestAction_Prev>);
+            registerRequestAction(RequestActionType::RAA_SETVOLUME, "SETVOLUME", &createRequestAction<RequestAction_SetVolume>);
+            registerRequestAction(RequestActionType::RAA_STOP, "STOP", &createRequestAction<RequestAction_Stop>);
+            registerRequestAction(RequestActionType::RAA_VOLUMEDOWN, "VOLUMEDOWN", &createRequestAction<RequestAction_VolumeDown>);
+            registerRequestAction(RequestActionType::RAA_VOLUMEUP, "VOLUMEUP", &createRequestAction<RequestAction_VolumeUp>);
+            registerRequestAction(RequestActionType::RAA_VOLUMECHANGE, "VOLUMECHANGE", nullptr);
+            registerRequestAction(RequestActionType::RAA_CREATEZONE, "CREATEZONE", &createRequestAction<RequestAction_CreateZone>);
+            registerRequestAction(RequestActionType::RAA_ADDTOZONE, "ADDTOZONE", &createRequestAction<RequestAction_AddToZone>);
+            registerRequestAction(RequestActionType::RAA_DROPFROMZONE, "DROPFROMZONE", &createRequestAction<RequestAction_DropFromZone>);
+            registerRequestAction(RequestActionType::RAA_MUTE, "MUTE", &createRequestAction<RequestAction_Mute>);
+            registerRequestAction(RequestActionType::RAA_UNMUTE, "UNMUTE", &createRequestAction<RequestAction_Unmute>);
+            registerRequestAction(RequestActionType::RAA_SETPLAYMODE, "SETPLAYMODE", &createRequestAction<RequestAction_SetPlayMode>);
+            registerRequestAction(RequestActionType::RAA_LOADPLAYLIST, "LOADPLAYLIST", &createRequestAction<RequestAction_LoadPlaylist>);
+            registerRequestAction(RequestActionType::RAA_LOADCONTAINER, "LOADCONTAINER", &createRequestAction<RequestAction_LoadContainer>);
+            registerRequestAction(RequestActionType::RAA_LOADURI, "LOADURI", &createRequestAction<RequestAction_LoadUri>);
+            registerRequestAction(RequestActionType::RAA_SEEK, "SEEK", &createRequestAction<RequestAction_Seek>);
+            registerRequestAction(RequestActionType::RAA_FADETOVOLUME, "FADETOVOLUME", &createRequestAction<RequestAction_FadeToVolume>);
+            registerRequestAction(RequestActionType::RAA_TOGGLEMUTE, "TOGGLEMUTE", &createRequestAction<RequestAction_ToggleMute>);
+            registerRequestAction(RequestActionType::RAA_SLEEPTIMER, "SLEEPTIMER", &createRequestAction<RequestAction_SleepTimer>);
+            registerRequestAction(RequestActionType::RAA_SEEKTOTRACK, "SEEKTOTRACK", &createRequestAction<RequestAction_SeekToTrack>);
+            registerRequestAction(RequestActionType::RAA_LOADSHUFFLE, "LOADSHUFFLE", &createRequestAction<RequestAction_LoadShuffle>);
+            registerRequestAction(RequestActionType::RAA_ENTERAUTOMATICSTANDBY, "ENTERAUTOMATICSTANDBY", &createRequestAction<RequestAction_EnterAutomaticStandby>);
+            registerRequestAction(RequestActionType::RAA_ENTERMANUALSTANDBY, "ENTERMANUALSTANDBY", &createRequestAction<RequestAction_EnterManualStandby>);
+            registerRequestAction(RequestActionType::RAA_LEAVESTANDBY, "LEAVESTANDBY", &createRequestAction<RequestAction_LeaveStandby>);
+            registerRequestAction(RequestActionType::RAA_CRASH, "CRASH", &createRequestAction<RequestAction_Crash>);
+            registerRequestAction(RequestActionType::RAA_KILLSESSION, "KILLSESSION", &createRequestAction<RequestAction_KillSession>);
+
+            // Returnable requests
+            registerRequestAction(RequestActionType::RAA_GETVERSION, "GETVERSION", &createRequestAction<RequestActionReturnable_GetVersion>);
+
+            // Returnable requests with long polling ability
+            registerRequestAction(RequestActionType::RAA_GETZONECONFIG, "GETZONECONFIG", &createRequestAction<RequestActionReturnableLongPolling_GetZoneConfig>);
+            registerRequestAction(RequestActionType::RAA_GETMEDIALIST, "GETMEDIALIST", &createRequestAction<RequestActionReturnableLongPolling_GetMediaList>);
+            registerRequestAction(RequestActionType::RAA_GETZONEMEDIALIST, "GETZONEMEDIALIST", &createRequestAction<RequestActionReturnableLongPolling_GetZoneMediaList>);
+            registerRequestAction(RequestActionType::RAA_GETRENDERERSTATE, "GETRENDERERSTATE", &createRequestAction<RequestActionReturnableLongPolling_GetRendererState>);
+            registerRequestAction(RequestActionType::RAA_GETRENDERERTRANSPORTSTATE, "GETRENDERERTRANSPORTSTATE", &createRequestAction<RequestActionReturnableLongPolling_GetRendererTransportState>);
+            registerRequestAction(RequestActionType::RAA_GETREQUESTSTATUS, "GETREQUESTSTATUS", &createRequestAction<RequestActionReturnableLongPolling_GetRequestStatus>);
+        }
+
+
+        RequestActionRegistry& RequestActionRegistry::getInstance()
+        {
+            static RequestActionRegistry registry;
+            return registry;
+        }
+
+
+        void RequestActionRegistry::registerRequestAction(RequestActionType _type, const std::string &_name, RequestActionFactory _factory)
+        {
+            RequestActionRegistryEntry entry;
+            entry.type = _type;
+            entry.name = _name;
+            entry.factory = _factory;
+
+            entriesByName.insert(_name, entry);
+
+            // the first name of a type will stay its name, further names are only aliases
+            auto index = (std::size_t)_type;
+            if (index >= entriesByType.size())
+                entriesByType.resize(index + 1, { RequestActionType::RAA_UNDEFINED, "", nullptr });
+            if (entriesByType[index].name.empty() || entriesByType[index].name == _name)
+                entriesByType[index] = entry;
+        }
+
+
+        const RequestActionRegistryEntry* RequestActionRegistry::findByName(const char* _name, std::size_t _length)
+        {
+            return entriesByName.find(_name, _length);
+        }
+
+
+        const RequestActionRegistryEntry* RequestActionRegistry::findByType(RequestActionType _type)
+        {
+            auto index = (std::size_t)_type;
+            if (index >= entriesByType.size() || entriesByType[index].name.empty())
+                return nullptr;
+            return &entriesByType[index];
+        }
+
+    }
+}
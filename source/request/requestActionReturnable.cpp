@@ -6,15 +6,19 @@ namespace Raumserver
     namespace Request
     {
 
-        RequestActionReturnable::RequestActionReturnable(std::string _url) : RequestAction(_url)
+        RequestActionReturnable::RequestActionReturnable(const std::string &_url) : RequestAction(_url)
         {      
-            responseData = "";
+            responseData = std::make_shared<const std::string>();
+            responseStreamSink = nullptr;
+            responseStreamed = false;
         }
 
 
-        RequestActionReturnable::RequestActionReturnable(std::string _path, std::string _query) : RequestAction(_path, _query)
+        RequestActionReturnable::RequestActionReturnable(const std::string &_path, const std::string &_query) : RequestAction(_path, _query)
         {     
-            responseData = "";
+            responseData = std::make_shared<const std::string>();
+            responseStreamSink = nullptr;
+            responseStreamed = false;
         }
 
 
@@ -35,11 +39,41 @@ namespace Raumserver
 
 
         std::string RequestActionReturnable::getResponseData()
+        {
+            return *responseData;
+        }
+
+
+        std::shared_ptr<const std::string> RequestActionReturnable::getResponseDataBuffer()
         {
             return responseData;
         }
 
 
+        bool RequestActionReturnable::isResponseStreamable()
+        {
+            return false;
+        }
+
+
+        void RequestActionReturnable::setResponseStreamSink(JsonOutputStreamSink _sink)
+        {
+            responseStreamSink = _sink;
+        }
+
+
+        bool RequestActionReturnable::isResponseStreamed()
+        {
+            return responseStreamed;
+        }
+
+
+        bool RequestActionReturnable::executeActionSimulated()
+        {
+            return executeAction();
+        }
+
+
         std::map<std::string, std::string> RequestActionReturnable::getResponseHeader()
         {
             return responseHeader;
@@ -53,6 +87,12 @@ namespace Raumserver
 
 
         void RequestActionReturnable::setResponseData(const std::string &_data)
+        {
+            responseData = std::make_shared<const std::string>(_data);
+        }
+
+
+        void RequestActionReturnable::setResponseDataBuffer(std::shared_ptr<const std::string> _data)
         {
             responseData = _data;
         }
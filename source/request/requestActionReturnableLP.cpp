@@ -7,14 +7,14 @@ namespace Raumserver
     namespace Request
     {
 
-        RequestActionReturnableLongPolling::RequestActionReturnableLongPolling(std::string _url) : RequestActionReturnable(_url)
+        RequestActionReturnableLongPolling::RequestActionReturnableLongPolling(const std::string &_url) : RequestActionReturnable(_url)
         {  
             action = RequestActionType::RAA_UNDEFINED;
             lastUpdateId = "";
         }
 
 
-        RequestActionReturnableLongPolling::RequestActionReturnableLongPolling(std::string _path, std::string _query) : RequestActionReturnable(_path, _query)
+        RequestActionReturnableLongPolling::RequestActionReturnableLongPolling(const std::string &_path, const std::string &_query) : RequestActionReturnable(_path, _query)
         {    
             action = RequestActionType::RAA_UNDEFINED;
             lastUpdateId = "";
@@ -40,6 +40,44 @@ namespace Raumserver
         }
 
 
+        std::string RequestActionReturnableLongPolling::getLongPollingKey()
+        {
+            // the options are stored in the order of the query, so we have to sort them to get the same key for the same options
+            std::map<std::string, std::string> keyOptions;
+            for (std::size_t i = 0; i < requestOptions.size(); i++)
+            {
+                auto optionKey = requestOptions.getKey(i);
+                if (!optionKey.equals("updateid") && !optionKey.equals("sessionid"))
+                    keyOptions[optionKey.toString()] = requestOptions.getValue(i).toString();
+            }
+
+            std::string key = requestActionTypeToString(action);
+            for (auto it : keyOptions)
+            {
+                key += "&" + it.first + "=" + it.second;
+            }
+            return key;
+        }
+
+
+        std::string RequestActionReturnableLongPolling::getLongPollingChannel()
+        {
+            return "";
+        }
+
+
+        std::string RequestActionReturnableLongPolling::getResponseCacheKey()
+        {
+            return getLongPollingKey();
+        }
+
+
+        bool RequestActionReturnableLongPolling::isLongPolling()
+        {
+            return !getOptionValue("updateId").empty();
+        }
+
+
         bool RequestActionReturnableLongPolling::hasLastUpdateIdChanged()
         {                        
             std::string lpid = getOptionValue("updateId");
@@ -56,6 +94,49 @@ namespace Raumserver
         }
 
 
+        bool RequestActionReturnableLongPolling::executeActionLongPollingCached()
+        {
+            Manager::ResponseCacheEntry cacheEntry;
+            auto responseCacheManager = getManagerEngineerServer()->getResponseCacheManager();
+            auto cacheKey = getResponseCacheKey();
+
+            // the header has to be complete before a streamable request starts writing its response
+            addResponseHeader("updateId", lastUpdateId);
+
+            // without an update id we do not know which data the response will contain, so we can't cache it
+            // streamed responses are not cached because they are meant for big data which should not be kept in memory
+            if (lastUpdateId.empty() || cacheKey.empty() || (responseStreamSink && isResponseStreamable()))
+            {
+                Manager::TraceSpan traceSpan("serialize", "request", requestId, action);
+                return executeActionLongPolling();
+            }
+
+            if (!responseCacheManager->acquireResponse(cacheKey, lastUpdateId, cacheEntry))
+            {
+                setResponseDataBuffer(cacheEntry.data);
+                responseHeader = cacheEntry.header;
+                return cacheEntry.success;
+            }
+
+            bool ret = false;
+            try
+            {
+                Manager::TraceSpan traceSpan("serialize", "request", requestId, action);
+                ret = executeActionLongPolling();
+            }
+            catch (...)
+            {
+                responseCacheManager->releaseResponse(cacheKey, lastUpdateId, nullptr, responseHeader, false);
+                throw;
+            }
+
+            // failed responses are not cached, the next request will try it again
+            responseCacheManager->releaseResponse(cacheKey, lastUpdateId, ret ? responseData : nullptr, responseHeader, ret);
+
+            return ret;
+        }
+
+
         bool RequestActionReturnableLongPolling::executeAction()
         {          
             bool ret = false;            
@@ -67,29 +148,28 @@ namespace Raumserver
             if (lpid.empty())
             {             
                 lastUpdateId = getLastUpdateId();
-                ret = executeActionLongPolling();
+                ret = executeActionLongPollingCached();
             }
             // if there is a long polling id we have to wait until the id changes before we execute the request
+            // the request will be parked in the long poll manager which will resume it when the id has changed or the session was killed
             else
             {
-                while (true)
-                {      
-                    lastUpdateId = getLastUpdateId();
-                    if (hasLastUpdateIdChanged())
+                lastUpdateId = getLastUpdateId();
+                if (hasLastUpdateIdChanged())
+                {
+                    ret = executeActionLongPollingCached();
+                }
+                else
+                {
+                    auto state = Manager::LongPollWaiterState::LPWS_ABORTED;
                     {
-                        ret = executeActionLongPolling();
-                        break;
+                        Manager::TraceSpan traceSpan("longPollWait", "request", requestId, action);
+                        state = getManagerEngineerServer()->getLongPollManager()->waitForUpdate(this, lpid, sessionId, lastUpdateId);
                     }
-
-                    // check if session was killed, if so then return from the request                   
-                    if (!sessionId.empty() && getManagerEngineerServer()->getSessionManager()->isSessionAborted(sessionId))
-                    {
-                        ret = false;
-                        break;
-                    }                                    
-
-                    // wait a little bit to keep cpu load and lockings low
-                    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+                    if (state == Manager::LongPollWaiterState::LPWS_CHANGED)
+                        ret = executeActionLongPollingCached();
+                    else if (state == Manager::LongPollWaiterState::LPWS_REJECTED)
+                        logError("Too many parked long polling requests! Please retry later or use the websocket or the event stream", CURRENT_FUNCTION);
                 }
             }
 
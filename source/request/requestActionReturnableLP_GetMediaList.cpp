@@ -1,13 +1,14 @@
 
 #include <raumserver/request/requestActionReturnableLP_GetMediaList.h>
 #include <raumserver/json/mediaItemJsonCreator.h>
+#include <raumserver/manager/managerEngineerServer.h>
 
 namespace Raumserver
 {
     namespace Request
     {
 
-        RequestActionReturnableLongPolling_GetMediaList::RequestActionReturnableLongPolling_GetMediaList(std::string _url) : RequestActionReturnableLongPolling(_url)
+        RequestActionReturnableLongPolling_GetMediaList::RequestActionReturnableLongPolling_GetMediaList(const std::string &_url) : RequestActionReturnableLongPolling(_url)
         {
             action = RequestActionType::RAA_GETMEDIALIST;
             listRetrieved = false;
@@ -15,7 +16,7 @@ namespace Raumserver
         }
 
 
-        RequestActionReturnableLongPolling_GetMediaList::RequestActionReturnableLongPolling_GetMediaList(std::string _path, std::string _query) : RequestActionReturnableLongPolling(_path, _query)
+        RequestActionReturnableLongPolling_GetMediaList::RequestActionReturnableLongPolling_GetMediaList(const std::string &_path, const std::string &_query) : RequestActionReturnableLongPolling(_path, _query)
         {
             action = RequestActionType::RAA_GETMEDIALIST;
             listRetrieved = false;
@@ -50,6 +51,9 @@ namespace Raumserver
             auto id = getOptionValue("id");
             std::string lastUpdateId = "";
 
+            if (isSimulated())
+                return std::to_string(getManagerEngineerServer()->getChangeSequenceManager()->getVersion(Manager::ChangeEntityType::CET_MEDIALIST, id));
+
             getManagerEngineer()->getMediaListManager()->lock();
 
             try
@@ -67,6 +71,12 @@ namespace Raumserver
         }
 
 
+        bool RequestActionReturnableLongPolling_GetMediaList::isResponseStreamable()
+        {
+            return true;
+        }
+
+
         void RequestActionReturnableLongPolling_GetMediaList::onMediaListDataChanged(std::string _listId)
         {            
             if (!_listId.empty() && formatedContainerId == _listId)
@@ -82,6 +92,15 @@ namespace Raumserver
             bool useCache = (useCacheOption == "1" || useCacheOption == "true") ? true : false;
             bool listGotFromCache = false;     
             bool ret = true;
+
+            // the simulated lists are not streamed, they are as big as the lists of a Raumfeld system with the same size
+            if (isSimulated())
+            {
+                if (lpid.empty())
+                    getManagerEngineerServer()->getSimulationManager()->loadMediaList(id);
+                setResponseData(getManagerEngineerServer()->getSimulationManager()->getMediaListJson(id));
+                return true;
+            }
           
             try
             {
@@ -160,12 +179,32 @@ namespace Raumserver
                     if (!listGotFromCache)
                         mediaList = managerEngineer->getMediaListManager()->getList(formatedContainerId);
 
-                    rapidjson::StringBuffer jsonStringBuffer;
-                    rapidjson::Writer<rapidjson::StringBuffer> jsonWriter(jsonStringBuffer);
+                    // big lists will be written directly to the stream of the response if there is one, so the json will never be
+                    // in memory as a whole
+                    if (responseStreamSink)
+                    {
+                        JsonOutputStream jsonOutputStream(responseStreamSink);
+                        rapidjson::Writer<JsonOutputStream> jsonWriter(jsonOutputStream);
+
+                        addMediaListToJson(formatedContainerId, mediaList, jsonWriter);
+                        jsonOutputStream.Flush();
+
+                        responseStreamed = true;
+                        if (jsonOutputStream.hasFailed())
+                        {
+                            logError("Writing media list '" + formatedContainerId + "' to the response stream failed!", CURRENT_POSITION);
+                            ret = false;
+                        }
+                    }
+                    else
+                    {
+                        rapidjson::StringBuffer jsonStringBuffer;
+                        rapidjson::Writer<rapidjson::StringBuffer> jsonWriter(jsonStringBuffer);
 
-                    addMediaListToJson(formatedContainerId, mediaList, jsonWriter);
+                        addMediaListToJson(formatedContainerId, mediaList, jsonWriter);
 
-                    setResponseData(jsonStringBuffer.GetString());
+                        setResponseData(jsonStringBuffer.GetString());
+                    }
                 }
                 catch (...)
                 {
@@ -185,7 +224,8 @@ namespace Raumserver
          
         }
 
-        void RequestActionReturnableLongPolling_GetMediaList::addMediaListToJson(const std::string &_id, std::vector<std::shared_ptr<Raumkernel::Media::Item::MediaItem>> &_mediaList, rapidjson::Writer<rapidjson::StringBuffer> &_jsonWriter)
+        template <typename JsonWriter>
+        void RequestActionReturnableLongPolling_GetMediaList::addMediaListToJson(const std::string &_id, std::vector<std::shared_ptr<Raumkernel::Media::Item::MediaItem>> &_mediaList, JsonWriter &_jsonWriter)
         {
             _jsonWriter.StartObject();
             _jsonWriter.Key("id"); _jsonWriter.String(_id.c_str());
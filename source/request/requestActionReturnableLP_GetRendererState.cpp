@@ -1,19 +1,20 @@
 
 #include <raumserver/request/requestActionReturnableLP_GetRendererState.h>
 #include <raumserver/json/mediaItemJsonCreator.h>
+#include <raumserver/manager/managerEngineerServer.h>
 
 namespace Raumserver
 {
     namespace Request
     {
 
-        RequestActionReturnableLongPolling_GetRendererState::RequestActionReturnableLongPolling_GetRendererState(std::string _url) : RequestActionReturnableLongPolling(_url)
+        RequestActionReturnableLongPolling_GetRendererState::RequestActionReturnableLongPolling_GetRendererState(const std::string &_url) : RequestActionReturnableLongPolling(_url)
         {
             action = RequestActionType::RAA_GETRENDERERSTATE;            
         }
 
 
-        RequestActionReturnableLongPolling_GetRendererState::RequestActionReturnableLongPolling_GetRendererState(std::string _path, std::string _query) : RequestActionReturnableLongPolling(_path, _query)
+        RequestActionReturnableLongPolling_GetRendererState::RequestActionReturnableLongPolling_GetRendererState(const std::string &_path, const std::string &_query) : RequestActionReturnableLongPolling(_path, _query)
         {
             action = RequestActionType::RAA_GETRENDERERSTATE;            
         }
@@ -32,63 +33,53 @@ namespace Raumserver
       
 
         std::string RequestActionReturnableLongPolling_GetRendererState::getLastUpdateId()
-        {                                 
-            std::string lastUpdateIdCur, rendererUDN, lastUpdateIdSum;
-            std::uint64_t lastUpdateSum = 0;
-
+        {
+            std::string lastUpdateId, rendererUDN;
+            auto changeSequenceManager = getManagerEngineerServer()->getChangeSequenceManager();
 
-            getManagerEngineer()->getDeviceManager()->lock();
-            getManagerEngineer()->getZoneManager()->lock();
+            // if we are called by a specific zone renderer id we only check this for a new update id
+            // otherwise the version of the renderer states will change on every change of any renderer or of the zone configuration
+            auto id = getOptionValue("id");
+            if (id.empty())
+                return std::to_string(changeSequenceManager->getVersion(Manager::ChangeEntityType::CET_RENDERERSTATE));
 
-            try
+            if (isSimulated())
             {
+                rendererUDN = getManagerEngineerServer()->getSimulationManager()->getRendererUDN(id);
+                return rendererUDN.empty() ? "" : std::to_string(changeSequenceManager->getVersion(Manager::ChangeEntityType::CET_RENDERERSTATE, rendererUDN));
+            }
 
-                // if we are called by a specific zone renderer id we only check this for a new update id
-                auto id = getOptionValue("id");
-                auto lpid = getOptionValue("updateId");
+            ManagerLockGuard managerLockGuard(this);
 
-                if (!id.empty())
-                {
-                    auto mediaRenderer = getVirtualMediaRenderer(id);
-                    if (!mediaRenderer)
-                    {
-                        logError("Room or Zone with ID: " + id + " not found!", CURRENT_FUNCTION);              
-                        lastUpdateIdSum = "";
-                    }
-                    else
-                    {
-                        lastUpdateIdSum = mediaRenderer->getLastRendererStateUpdateId();
-                    }
-                }
-                // run through the renderers and get current update id by summing up the values
-                // if the value is other than given in header something has changed. 
-                // It could be that the sum of the update ids may be the same (imaging bchanges on 2 renderers and the invidious case that the values would be the same sum) 
+            try
+            {
+                auto mediaRenderer = getVirtualMediaRenderer(id);
+                if (!mediaRenderer)
+                    logError("Room or Zone with ID: " + id + " not found!", CURRENT_FUNCTION);
                 else
-                {
-                    auto zoneInfoMap = getManagerEngineer()->getZoneManager()->getZoneInformationMap();
-                    for (auto it : zoneInfoMap)
-                    {
-                        auto rendererUDN = getManagerEngineer()->getZoneManager()->getRendererUDNForZoneUDN(it.first);
-                        auto mediaRenderer = getVirtualMediaRendererFromUDN(rendererUDN);
-                        if (mediaRenderer)
-                        {
-                            lastUpdateIdCur = mediaRenderer->getLastRendererStateUpdateId();
-                            lastUpdateSum += std::stoull(lastUpdateIdCur);
-                        }
-                    }
-                    lastUpdateIdSum = std::to_string(lastUpdateSum);
-                }
-            
+                    rendererUDN = mediaRenderer->getUDN();
             }
             catch (...)
             {
                 logError("Unknown Exception!", CURRENT_POSITION);
             }
 
-            getManagerEngineer()->getDeviceManager()->unlock();
-            getManagerEngineer()->getZoneManager()->unlock();
+            managerLockGuard.unlock();
 
-            return lastUpdateIdSum;
+            if (!rendererUDN.empty())
+                lastUpdateId = std::to_string(changeSequenceManager->getVersion(Manager::ChangeEntityType::CET_RENDERERSTATE, rendererUDN));
+
+            return lastUpdateId;
+        }
+
+
+        std::string RequestActionReturnableLongPolling_GetRendererState::getResponseCacheKey()
+        {
+            // a delta response depends on the update id the client already knows
+            auto deltaStr = getOptionValue("delta");
+            if (deltaStr == "1" || deltaStr == "true")
+                return getLongPollingKey() + "&updateid=" + getOptionValue("updateId");
+            return getLongPollingKey();
         }
 
 
@@ -144,8 +135,27 @@ namespace Raumserver
             bool listAll = (listAllStr == "1" || listAllStr == "true") ? true : false;
             bool ret = true;
 
-            getManagerEngineer()->getDeviceManager()->lock();
-            getManagerEngineer()->getZoneManager()->lock();
+            // with the 'delta' option only the renderers which have changed since the given update id will be returned
+            // if the changes can't be found in the journal of the change sequence manager we have to return all renderers
+            std::unordered_set<std::string> changedRendererUDNs;
+            auto deltaStr = getOptionValue("delta");
+            auto lpid = getOptionValue("updateId");
+            bool delta = false;
+            if (id.empty() && !lpid.empty() && (deltaStr == "1" || deltaStr == "true"))
+            {
+                delta = getManagerEngineerServer()->getChangeSequenceManager()->getChangedEntities(Manager::ChangeEntityType::CET_RENDERERSTATE, (std::uint64_t)Raumkernel::Tools::CommonUtil::toInt64(lpid), changedRendererUDNs);
+                addResponseHeader("delta", delta ? "1" : "0");
+            }
+
+            if (isSimulated())
+            {
+                std::string json;
+                ret = getManagerEngineerServer()->getSimulationManager()->getRendererStateJson(id, listAll, delta ? &changedRendererUDNs : nullptr, json);
+                setResponseData(json);
+                return ret;
+            }
+
+            ManagerLockGuard managerLockGuard(this);
 
             try
             {
@@ -179,7 +189,7 @@ namespace Raumserver
                     {
                         auto rendererUDN = getManagerEngineer()->getZoneManager()->getRendererUDNForZoneUDN(it.first);
                         auto mediaRenderer = getVirtualMediaRendererFromUDN(rendererUDN);
-                        if (mediaRenderer)
+                        if (mediaRenderer && (!delta || changedRendererUDNs.find(mediaRenderer->getUDN()) != changedRendererUDNs.end()))
                         {
                             rendererState = mediaRenderer->state();
                             addRendererStateToJson(mediaRenderer->getUDN(), rendererState, mediaRenderer, jsonWriter);
@@ -199,7 +209,7 @@ namespace Raumserver
                                 for (auto rendererUDN : pair.second.rendererUDN)
                                 {                                
                                     auto mediaRenderer = getMediaRenderer(rendererUDN);
-                                    if (mediaRenderer)
+                                    if (mediaRenderer && (!delta || changedRendererUDNs.find(mediaRenderer->getUDN()) != changedRendererUDNs.end()))
                                     {
                                         rendererState = mediaRenderer->state();                                    
                                         addRendererStateToJson(mediaRenderer->getUDN(), rendererState, mediaRenderer, jsonWriter);
@@ -221,8 +231,7 @@ namespace Raumserver
                 logError("Unknown Exception!", CURRENT_POSITION);
             }
 
-            getManagerEngineer()->getDeviceManager()->unlock();
-            getManagerEngineer()->getZoneManager()->unlock();
+            managerLockGuard.unlock();
 
             return ret;
         }
@@ -6,13 +6,13 @@ namespace Raumserver
     namespace Request
     {
 
-        RequestActionReturnableLongPolling_GetRendererTransportState::RequestActionReturnableLongPolling_GetRendererTransportState(std::string _url) : RequestActionReturnableLongPolling(_url)
+        RequestActionReturnableLongPolling_GetRendererTransportState::RequestActionReturnableLongPolling_GetRendererTransportState(const std::string &_url) : RequestActionReturnableLongPolling(_url)
         {
             action = RequestActionType::RAA_GETRENDERERTRANSPORTSTATE;
         }
 
 
-        RequestActionReturnableLongPolling_GetRendererTransportState::RequestActionReturnableLongPolling_GetRendererTransportState(std::string _path, std::string _query) : RequestActionReturnableLongPolling(_path, _query)
+        RequestActionReturnableLongPolling_GetRendererTransportState::RequestActionReturnableLongPolling_GetRendererTransportState(const std::string &_path, const std::string &_query) : RequestActionReturnableLongPolling(_path, _query)
         {
             action = RequestActionType::RAA_GETRENDERERTRANSPORTSTATE;
         }
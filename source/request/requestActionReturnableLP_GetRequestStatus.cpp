@@ -0,0 +1,110 @@
+#include <raumserver/request/requestActionReturnableLP_GetRequestStatus.h>
+#include <raumserver/manager/managerEngineerServer.h>
+
+namespace Raumserver
+{
+    namespace Request
+    {
+
+        RequestActionReturnableLongPolling_GetRequestStatus::RequestActionReturnableLongPolling_GetRequestStatus(const std::string &_url) : RequestActionReturnableLongPolling(_url)
+        {
+            action = RequestActionType::RAA_GETREQUESTSTATUS;
+        }
+
+
+        RequestActionReturnableLongPolling_GetRequestStatus::RequestActionReturnableLongPolling_GetRequestStatus(const std::string &_path, const std::string &_query) : RequestActionReturnableLongPolling(_path, _query)
+        {
+            action = RequestActionType::RAA_GETREQUESTSTATUS;
+        }
+
+
+        RequestActionReturnableLongPolling_GetRequestStatus::~RequestActionReturnableLongPolling_GetRequestStatus()
+        {
+        }
+
+
+        bool RequestActionReturnableLongPolling_GetRequestStatus::isValid()
+        {
+            bool isValid = RequestActionReturnableLongPolling::isValid();
+
+            // examples for valid requests:
+            // raumserver/data/getRequestStatus?requestId=12
+            // raumserver/data/getRequestStatus?requestId=12&updateId=3
+
+            auto requestId = getOptionValue("requestId");
+            if (requestId.empty())
+            {
+                logError("'requestId' option is needed to execute 'getRequestStatus' command!", CURRENT_FUNCTION);
+                isValid = false;
+            }
+
+            return isValid;
+        }
+
+
+        std::string RequestActionReturnableLongPolling_GetRequestStatus::getLastUpdateId()
+        {
+            Manager::RequestActionStatus status;
+            auto requestId = Raumkernel::Tools::CommonUtil::toInt64(getOptionValue("requestId"));
+
+            // the version of the status will change with every state change of the request
+            if (!getManagerEngineerServer()->getRequestActionManager()->getRequestStatus(requestId, status))
+                return "0";
+            return std::to_string(status.version);
+        }
+
+
+        std::string RequestActionReturnableLongPolling_GetRequestStatus::getLongPollingChannel()
+        {
+            // the request action manager will signal the status changes of each request, so the status requests don't have to
+            // be checked each time the kernel has changed something
+            return getRequestStatusChannel(Raumkernel::Tools::CommonUtil::toInt64(getOptionValue("requestId")));
+        }
+
+
+        std::string RequestActionReturnableLongPolling_GetRequestStatus::getRequestStatusChannel(std::uint64_t _requestId)
+        {
+            return "requestStatus:" + std::to_string(_requestId);
+        }
+
+
+        bool RequestActionReturnableLongPolling_GetRequestStatus::executeActionLongPolling()
+        {
+            Manager::RequestActionStatus status;
+            auto requestId = Raumkernel::Tools::CommonUtil::toInt64(getOptionValue("requestId"));
+
+            rapidjson::StringBuffer jsonStringBuffer;
+            rapidjson::Writer<rapidjson::StringBuffer> jsonWriter(jsonStringBuffer);
+
+            jsonWriter.StartObject();
+            jsonWriter.Key("requestId"); jsonWriter.Uint64(requestId);
+
+            // the status of old requests will be overwritten by newer ones, so we may not know the request anymore
+            if (!getManagerEngineerServer()->getRequestActionManager()->getRequestStatus(requestId, status))
+            {
+                jsonWriter.Key("state"); jsonWriter.String(Manager::RequestActionManager::requestActionStateToString(Manager::RequestActionState::RAS_UNKNOWN).c_str());
+            }
+            else
+            {
+                jsonWriter.Key("state"); jsonWriter.String(Manager::RequestActionManager::requestActionStateToString(status.state).c_str());
+                jsonWriter.Key("request"); jsonWriter.String(status.requestInfo.c_str());
+                jsonWriter.Key("error"); jsonWriter.String(status.error.c_str());
+                if (status.mergedIntoRequestId)
+                {
+                    jsonWriter.Key("mergedIntoRequestId"); jsonWriter.Uint64(status.mergedIntoRequestId);
+                }
+                jsonWriter.Key("addTime"); jsonWriter.Uint64(status.addTime);
+                jsonWriter.Key("startTime"); jsonWriter.Uint64(status.startTime);
+                jsonWriter.Key("endTime"); jsonWriter.Uint64(status.endTime);
+                jsonWriter.Key("waitTime"); jsonWriter.Uint64(status.startTime ? status.startTime - status.addTime : 0);
+                jsonWriter.Key("executionTime"); jsonWriter.Uint64(status.startTime && status.endTime ? status.endTime - status.startTime : 0);
+            }
+
+            jsonWriter.EndObject();
+
+            setResponseData(jsonStringBuffer.GetString());
+
+            return true;
+        }
+    }
+}
@@ -1,18 +1,19 @@
 
 #include <raumserver/request/requestActionReturnableLP_GetZoneConfig.h>
+#include <raumserver/manager/managerEngineerServer.h>
 
 namespace Raumserver
 {
     namespace Request
     {
 
-        RequestActionReturnableLongPolling_GetZoneConfig::RequestActionReturnableLongPolling_GetZoneConfig(std::string _url) : RequestActionReturnableLongPolling(_url)
+        RequestActionReturnableLongPolling_GetZoneConfig::RequestActionReturnableLongPolling_GetZoneConfig(const std::string &_url) : RequestActionReturnableLongPolling(_url)
         {
             action = RequestActionType::RAA_GETZONECONFIG;
         }
 
 
-        RequestActionReturnableLongPolling_GetZoneConfig::RequestActionReturnableLongPolling_GetZoneConfig(std::string _path, std::string _query) : RequestActionReturnableLongPolling(_path, _query)
+        RequestActionReturnableLongPolling_GetZoneConfig::RequestActionReturnableLongPolling_GetZoneConfig(const std::string &_path, const std::string &_query) : RequestActionReturnableLongPolling(_path, _query)
         {
             action = RequestActionType::RAA_GETZONECONFIG;
         }
@@ -32,6 +33,10 @@ namespace Raumserver
 
         std::string RequestActionReturnableLongPolling_GetZoneConfig::getLastUpdateId()
         {
+            // the simulation signals its zone changes to the change sequence manager
+            if (isSimulated())
+                return std::to_string(getManagerEngineerServer()->getChangeSequenceManager()->getVersion(Manager::ChangeEntityType::CET_ZONECONFIG));
+
             //getManagerEngineer()->getDeviceManager()->lock();
             //getManagerEngineer()->getZoneManager()->lock();
 
@@ -46,6 +51,8 @@ namespace Raumserver
 
             //getManagerEngineer()->getZoneManager()->unlock();
             //getManagerEngineer()->getDeviceManager()->unlock();
+
+            return "";
         }
 
 
@@ -54,8 +61,13 @@ namespace Raumserver
             std::unordered_map<std::string, Raumkernel::Manager::ZoneInformation> zoneInfoMap;
             std::unordered_map<std::string, Raumkernel::Manager::RoomInformation> roomInfoMap;
 
-            getManagerEngineer()->getDeviceManager()->lock();
-            getManagerEngineer()->getZoneManager()->lock();
+            if (isSimulated())
+            {
+                setResponseData(getManagerEngineerServer()->getSimulationManager()->getZoneConfigJson());
+                return true;
+            }
+
+            ManagerLockGuard managerLockGuard(this);
 
             try
             {
@@ -67,8 +79,7 @@ namespace Raumserver
                 logError("Unknown error", CURRENT_POSITION);
             }                    
 
-            getManagerEngineer()->getZoneManager()->unlock();
-            getManagerEngineer()->getDeviceManager()->unlock(); 
+            managerLockGuard.unlock();
 
             rapidjson::StringBuffer jsonStringBuffer;
             rapidjson::Writer<rapidjson::StringBuffer> jsonWriter(jsonStringBuffer);
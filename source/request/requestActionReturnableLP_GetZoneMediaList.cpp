@@ -1,20 +1,21 @@
 
 #include <raumserver/request/requestActionReturnableLP_GetZoneMediaList.h>
 #include <raumserver/json/mediaItemJsonCreator.h>
+#include <raumserver/manager/managerEngineerServer.h>
 
 namespace Raumserver
 {
     namespace Request
     {
 
-        RequestActionReturnableLongPolling_GetZoneMediaList::RequestActionReturnableLongPolling_GetZoneMediaList(std::string _url) : RequestActionReturnableLongPolling(_url)
+        RequestActionReturnableLongPolling_GetZoneMediaList::RequestActionReturnableLongPolling_GetZoneMediaList(const std::string &_url) : RequestActionReturnableLongPolling(_url)
         {
             action = RequestActionType::RAA_GETZONEMEDIALIST;
             listRetrieved = false;
         }
 
 
-        RequestActionReturnableLongPolling_GetZoneMediaList::RequestActionReturnableLongPolling_GetZoneMediaList(std::string _path, std::string _query) : RequestActionReturnableLongPolling(_path, _query)
+        RequestActionReturnableLongPolling_GetZoneMediaList::RequestActionReturnableLongPolling_GetZoneMediaList(const std::string &_path, const std::string &_query) : RequestActionReturnableLongPolling(_path, _query)
         {
             action = RequestActionType::RAA_GETZONEMEDIALIST;
             listRetrieved = false;
@@ -35,40 +36,24 @@ namespace Raumserver
 
         std::string RequestActionReturnableLongPolling_GetZoneMediaList::getLastUpdateId()
         {
-            std::string lastUpdateIdCur, rendererUDN, lastUpdateIdSum;
-            std::uint64_t lastUpdateSum = 0;
+            auto changeSequenceManager = getManagerEngineerServer()->getChangeSequenceManager();
+
+            // the version of the zone media lists will change on every change of any zone list or of the zone configuration
             auto id = getOptionValue("id");
+            if (id.empty())
+                return std::to_string(changeSequenceManager->getVersion(Manager::ChangeEntityType::CET_ZONEMEDIALIST));
 
-            if (!id.empty())
+            if (isSimulated())
             {
-                auto mediaRenderer = getVirtualMediaRenderer(id);
-                if (!mediaRenderer)
-                    return "";
-
-                std::string zonePlaylistId = Raumkernel::Manager::LISTID_ZONEIDENTIFIER + mediaRenderer->getUDN();
-                lastUpdateIdSum = getManagerEngineer()->getMediaListManager()->getLastUpdateIdForList(zonePlaylistId);
-            }
-            // run through the renderers and get current update id by summing up the values
-            // if the value is other than given in header something has changed.             
-            else
-            {
-                auto zoneInfoMap = getManagerEngineer()->getZoneManager()->getZoneInformationMap();
-                for (auto it : zoneInfoMap)
-                {
-                    auto rendererUDN = getManagerEngineer()->getZoneManager()->getRendererUDNForZoneUDN(it.first);
-                    auto mediaRenderer = getVirtualMediaRendererFromUDN(rendererUDN);
-                    if (mediaRenderer)
-                    {
-                        std::string zonePlaylistId = Raumkernel::Manager::LISTID_ZONEIDENTIFIER + mediaRenderer->getUDN();
-                        lastUpdateIdCur = getManagerEngineer()->getMediaListManager()->getLastUpdateIdForList(zonePlaylistId);                       
-                        if (!lastUpdateIdCur.empty())
-                            lastUpdateSum += std::stoull(lastUpdateIdCur);
-                    }
-                }
-                lastUpdateIdSum = std::to_string(lastUpdateSum);
+                auto rendererUDN = getManagerEngineerServer()->getSimulationManager()->getRendererUDN(id);
+                return rendererUDN.empty() ? "" : std::to_string(changeSequenceManager->getVersion(Manager::ChangeEntityType::CET_ZONEMEDIALIST, rendererUDN));
             }
 
-            return lastUpdateIdSum;
+            auto mediaRenderer = getVirtualMediaRenderer(id);
+            if (!mediaRenderer)
+                return "";
+
+            return std::to_string(changeSequenceManager->getVersion(Manager::ChangeEntityType::CET_ZONEMEDIALIST, mediaRenderer->getUDN()));
         }
 
 
@@ -94,6 +79,15 @@ namespace Raumserver
             auto id = getOptionValue("id");   
             std::vector<std::shared_ptr<Raumkernel::Media::Item::MediaItem>> mediaList;
 
+            if (isSimulated())
+            {
+                std::string json;
+                if (!getManagerEngineerServer()->getSimulationManager()->getZoneMediaListJson(id, json))
+                    return false;
+                setResponseData(json);
+                return true;
+            }
+
             rapidjson::StringBuffer jsonStringBuffer;
             rapidjson::Writer<rapidjson::StringBuffer> jsonWriter(jsonStringBuffer);
 
@@ -7,13 +7,13 @@ namespace Raumserver
     namespace Request
     {
 
-        RequestActionReturnable_GetVersion::RequestActionReturnable_GetVersion(std::string _url) : RequestActionReturnable(_url)
+        RequestActionReturnable_GetVersion::RequestActionReturnable_GetVersion(const std::string &_url) : RequestActionReturnable(_url)
         {
             action = RequestActionType::RAA_GETVERSION;
         }
 
 
-        RequestActionReturnable_GetVersion::RequestActionReturnable_GetVersion(std::string _path, std::string _query) : RequestActionReturnable(_path, _query)
+        RequestActionReturnable_GetVersion::RequestActionReturnable_GetVersion(const std::string &_path, const std::string &_query) : RequestActionReturnable(_path, _query)
         {
             action = RequestActionType::RAA_GETVERSION;
         }
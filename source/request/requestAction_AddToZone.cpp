@@ -5,13 +5,13 @@ namespace Raumserver
 {
     namespace Request
     {
-        RequestAction_AddToZone::RequestAction_AddToZone(std::string _url) : RequestAction(_url)
+        RequestAction_AddToZone::RequestAction_AddToZone(const std::string &_url) : RequestAction(_url)
         {
             action = RequestActionType::RAA_ADDTOZONE;
         }
 
 
-        RequestAction_AddToZone::RequestAction_AddToZone(std::string _path, std::string _query) : RequestAction(_path, _query)
+        RequestAction_AddToZone::RequestAction_AddToZone(const std::string &_path, const std::string &_query) : RequestAction(_path, _query)
         {
             action = RequestActionType::RAA_ADDTOZONE;
         }
@@ -43,6 +43,18 @@ namespace Raumserver
         }
 
        
+        std::string RequestAction_AddToZone::getExecutionLaneId()
+        {
+            return "";
+        }
+
+
+        bool RequestAction_AddToZone::isManagerLockSharable()
+        {
+            return false;
+        }
+
+
         bool RequestAction_AddToZone::executeAction()
         {
             std::uint16_t processTime = 0;
@@ -55,8 +67,7 @@ namespace Raumserver
             if (!id.empty())
             {            
 
-                getManagerEngineer()->getDeviceManager()->lock();
-                getManagerEngineer()->getZoneManager()->lock();
+                ManagerLockGuard managerLockGuard(this);
 
                 try
                 {
@@ -73,8 +84,7 @@ namespace Raumserver
                     logError("Unknown Exception!", CURRENT_POSITION);
                 }
                 
-                getManagerEngineer()->getDeviceManager()->unlock();
-                getManagerEngineer()->getZoneManager()->unlock();
+                managerLockGuard.unlock();
 
                 // no valid request if zone is not found and its defined!
                 if (zoneUDN.empty() && !zoneId.empty())
@@ -94,8 +104,7 @@ namespace Raumserver
                         while (!allRoomsAdded && processTime <= timeout)
                         {     
 
-                            getManagerEngineer()->getDeviceManager()->lock();
-                            getManagerEngineer()->getZoneManager()->lock();
+                            ManagerLockGuard waitLockGuard(this);
 
                             try
                             {
@@ -111,8 +120,7 @@ namespace Raumserver
                                 logError("Unknown Exception!", CURRENT_POSITION);
                             }
 
-                            getManagerEngineer()->getDeviceManager()->unlock();
-                            getManagerEngineer()->getZoneManager()->unlock();
+                            waitLockGuard.unlock();
 
                             std::this_thread::sleep_for(std::chrono::milliseconds(waitTimeForRequestActionKernelResponse));
                             processTime += waitTimeForRequestActionKernelResponse;
@@ -7,13 +7,13 @@ namespace Raumserver
 {
     namespace Request
     {
-        RequestAction_Crash::RequestAction_Crash(std::string _url) : RequestAction(_url)
+        RequestAction_Crash::RequestAction_Crash(const std::string &_url) : RequestAction(_url)
         {
             action = RequestActionType::RAA_CRASH;
         }
 
 
-        RequestAction_Crash::RequestAction_Crash(std::string _path, std::string _query) : RequestAction(_path, _query)
+        RequestAction_Crash::RequestAction_Crash(const std::string &_path, const std::string &_query) : RequestAction(_path, _query)
         {
             action = RequestActionType::RAA_CRASH;
         }
@@ -5,13 +5,13 @@ namespace Raumserver
 {
     namespace Request
     {
-        RequestAction_CreateZone::RequestAction_CreateZone(std::string _url) : RequestAction(_url)
+        RequestAction_CreateZone::RequestAction_CreateZone(const std::string &_url) : RequestAction(_url)
         {
             action = RequestActionType::RAA_CREATEZONE;
         }
 
 
-        RequestAction_CreateZone::RequestAction_CreateZone(std::string _path, std::string _query) : RequestAction(_path, _query)
+        RequestAction_CreateZone::RequestAction_CreateZone(const std::string &_path, const std::string &_query) : RequestAction(_path, _query)
         {
             action = RequestActionType::RAA_CREATEZONE;
         }
@@ -42,6 +42,18 @@ namespace Raumserver
         }
 
        
+        std::string RequestAction_CreateZone::getExecutionLaneId()
+        {
+            return "";
+        }
+
+
+        bool RequestAction_CreateZone::isManagerLockSharable()
+        {
+            return false;
+        }
+
+
         bool RequestAction_CreateZone::executeAction()
         {
             std::uint16_t processTime = 0;
@@ -51,8 +63,7 @@ namespace Raumserver
 
             if (!id.empty())
             {              
-                getManagerEngineer()->getDeviceManager()->lock();
-                getManagerEngineer()->getZoneManager()->lock();
+                ManagerLockGuard managerLockGuard(this);
 
                 try
                 {
@@ -68,8 +79,7 @@ namespace Raumserver
                     logError("Unknown Exception!", CURRENT_POSITION);
                 }
 
-                getManagerEngineer()->getDeviceManager()->unlock();
-                getManagerEngineer()->getZoneManager()->unlock();
+                managerLockGuard.unlock();
 
                 if (!roomUDNs.empty())
                 {
@@ -84,8 +94,7 @@ namespace Raumserver
                         // wait until room is added to a new zoneUDN or a timout happens                              
                         while (!allRoomsAdded && processTime <= timeout)
                         {
-                            getManagerEngineer()->getDeviceManager()->lock();
-                            getManagerEngineer()->getZoneManager()->lock();
+                            ManagerLockGuard waitLockGuard(this);
 
                             try
                             {
@@ -116,8 +125,7 @@ namespace Raumserver
                                 logError("Unknown Exception!", CURRENT_POSITION);
                             }
 
-                            getManagerEngineer()->getDeviceManager()->unlock();
-                            getManagerEngineer()->getZoneManager()->unlock();
+                            waitLockGuard.unlock();
                                 
                             std::this_thread::sleep_for(std::chrono::milliseconds(waitTimeForRequestActionKernelResponse));
                             processTime += waitTimeForRequestActionKernelResponse;
@@ -5,13 +5,13 @@ namespace Raumserver
 {
     namespace Request
     {
-        RequestAction_DropFromZone::RequestAction_DropFromZone(std::string _url) : RequestAction(_url)
+        RequestAction_DropFromZone::RequestAction_DropFromZone(const std::string &_url) : RequestAction(_url)
         {
             action = RequestActionType::RAA_DROPFROMZONE;
         }
 
 
-        RequestAction_DropFromZone::RequestAction_DropFromZone(std::string _path, std::string _query) : RequestAction(_path, _query)
+        RequestAction_DropFromZone::RequestAction_DropFromZone(const std::string &_path, const std::string &_query) : RequestAction(_path, _query)
         {
             action = RequestActionType::RAA_DROPFROMZONE;
         }
@@ -41,6 +41,18 @@ namespace Raumserver
         }
 
        
+        std::string RequestAction_DropFromZone::getExecutionLaneId()
+        {
+            return "";
+        }
+
+
+        bool RequestAction_DropFromZone::isManagerLockSharable()
+        {
+            return false;
+        }
+
+
         bool RequestAction_DropFromZone::executeAction()
         {
             std::uint16_t processTime = 0;
@@ -51,8 +63,7 @@ namespace Raumserver
                 std::string roomUDN;
                 bool roomOk = false;
 
-                getManagerEngineer()->getDeviceManager()->lock();
-                getManagerEngineer()->getZoneManager()->lock();
+                ManagerLockGuard managerLockGuard(this);
 
                 try
                 {
@@ -64,8 +75,7 @@ namespace Raumserver
                     logError("Unknown Exception!", CURRENT_POSITION);
                 }
 
-                getManagerEngineer()->getDeviceManager()->unlock();
-                getManagerEngineer()->getZoneManager()->unlock();
+                managerLockGuard.unlock();
 
                 if (roomOk)
                 {
@@ -77,8 +87,7 @@ namespace Raumserver
                         // INFO: We may register a signal of the zoneManager like "zoneOfRoomChanged" and poll a var which will change on this signal
                         while (!zoneOfroomEmpty && processTime <= timeout)
                         {
-                            getManagerEngineer()->getDeviceManager()->lock();
-                            getManagerEngineer()->getZoneManager()->lock();
+                            ManagerLockGuard waitLockGuard(this);
 
                             try
                             {
@@ -89,8 +98,7 @@ namespace Raumserver
                                 logError("Unknown Exception!", CURRENT_POSITION);
                             }
 
-                            getManagerEngineer()->getDeviceManager()->unlock();
-                            getManagerEngineer()->getZoneManager()->unlock();
+                            waitLockGuard.unlock();
 
 
                             std::this_thread::sleep_for(std::chrono::milliseconds(waitTimeForRequestActionKernelResponse));
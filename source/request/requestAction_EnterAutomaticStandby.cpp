@@ -5,13 +5,13 @@ namespace Raumserver
 {
     namespace Request
     {
-        RequestAction_EnterAutomaticStandby::RequestAction_EnterAutomaticStandby(std::string _url) : RequestAction(_url)
+        RequestAction_EnterAutomaticStandby::RequestAction_EnterAutomaticStandby(const std::string &_url) : RequestAction(_url)
         {
             action = RequestActionType::RAA_ENTERAUTOMATICSTANDBY;
         }
 
 
-        RequestAction_EnterAutomaticStandby::RequestAction_EnterAutomaticStandby(std::string _path, std::string _query) : RequestAction(_path, _query)
+        RequestAction_EnterAutomaticStandby::RequestAction_EnterAutomaticStandby(const std::string &_path, const std::string &_query) : RequestAction(_path, _query)
         {
             action = RequestActionType::RAA_ENTERAUTOMATICSTANDBY;
         }
@@ -39,8 +39,7 @@ namespace Raumserver
         {
             auto id = getOptionValue("id");
 
-            getManagerEngineer()->getDeviceManager()->lock();
-            getManagerEngineer()->getZoneManager()->lock();
+            ManagerLockGuard managerLockGuard(this);
 
             try
             {
@@ -74,8 +73,7 @@ namespace Raumserver
                 logError("Unknown Exception!", CURRENT_POSITION);
             }
 
-            getManagerEngineer()->getDeviceManager()->unlock();
-            getManagerEngineer()->getZoneManager()->unlock();
+            managerLockGuard.unlock();
 
 
             return true;
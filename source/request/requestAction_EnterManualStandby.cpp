@@ -5,13 +5,13 @@ namespace Raumserver
 {
     namespace Request
     {
-        RequestAction_EnterManualStandby::RequestAction_EnterManualStandby(std::string _url) : RequestAction(_url)
+        RequestAction_EnterManualStandby::RequestAction_EnterManualStandby(const std::string &_url) : RequestAction(_url)
         {
             action = RequestActionType::RAA_ENTERMANUALSTANDBY;
         }
 
 
-        RequestAction_EnterManualStandby::RequestAction_EnterManualStandby(std::string _path, std::string _query) : RequestAction(_path, _query)
+        RequestAction_EnterManualStandby::RequestAction_EnterManualStandby(const std::string &_path, const std::string &_query) : RequestAction(_path, _query)
         {
             action = RequestActionType::RAA_ENTERMANUALSTANDBY;
         }
@@ -39,8 +39,7 @@ namespace Raumserver
         {
             auto id = getOptionValue("id");
 
-            getManagerEngineer()->getDeviceManager()->lock();
-            getManagerEngineer()->getZoneManager()->lock();
+            ManagerLockGuard managerLockGuard(this);
 
             try
             {
@@ -73,8 +72,7 @@ namespace Raumserver
                 logError("Unknown Exception!", CURRENT_POSITION);
             }
 
-            getManagerEngineer()->getDeviceManager()->unlock();
-            getManagerEngineer()->getZoneManager()->unlock();
+            managerLockGuard.unlock();
 
             return true;
         }
@@ -5,15 +5,17 @@ namespace Raumserver
 {
     namespace Request
     {
-        RequestAction_FadeToVolume::RequestAction_FadeToVolume(std::string _url) : RequestAction(_url)
+        RequestAction_FadeToVolume::RequestAction_FadeToVolume(const std::string &_url) : RequestAction(_url)
         {
             action = RequestActionType::RAA_FADETOVOLUME;
+            priority = RequestActionPriority::RAP_LOW;
         }
 
 
-        RequestAction_FadeToVolume::RequestAction_FadeToVolume(std::string _path, std::string _query) : RequestAction(_path, _query)
+        RequestAction_FadeToVolume::RequestAction_FadeToVolume(const std::string &_path, const std::string &_query) : RequestAction(_path, _query)
         {
             action = RequestActionType::RAA_FADETOVOLUME;
+            priority = RequestActionPriority::RAP_LOW;
         }
 
 
@@ -32,8 +34,7 @@ namespace Raumserver
             // raumserver/controller/fadeToVolume?id=Schlafzimmer?value=-10&relative=true   
             // raumserver/controller/fadeToVolume?id=uuid:3f68f253-df2a-4474-8640-fd45dd9ebf88?value=60   
 
-            auto relativeValue = getOptionValue("relative");
-            bool relative = (relativeValue == "true" || relativeValue == "1") ? true : false;
+            bool relative = getOptionValueBool("relative");
 
             auto value = getOptionValue("value");
             if (value.empty())
@@ -60,16 +61,14 @@ namespace Raumserver
             auto valueVolume = Raumkernel::Tools::CommonUtil::toInt32(value);
             auto durationString = Raumkernel::Tools::StringUtil::tolower(getOptionValue("duration", "0"));
             auto duration = Raumkernel::Tools::CommonUtil::toInt32(durationString);
-            auto relativeValue = getOptionValue("relative");
-            bool relative = (relativeValue == "true" || relativeValue == "1") ? true : false;
+            bool relative = getOptionValueBool("relative");
             std::int32_t newVolumeValue = 0;            
 
             // set some standard duration if the value is not given!
             if (duration <= 0)
                 duration = 2000;
 
-            getManagerEngineer()->getDeviceManager()->lock();
-            getManagerEngineer()->getZoneManager()->lock();
+            ManagerLockGuard managerLockGuard(this);
 
             try
             {
@@ -120,8 +119,7 @@ namespace Raumserver
                 logError("Unknown Exception!", CURRENT_POSITION);
             }
 
-            getManagerEngineer()->getDeviceManager()->unlock();
-            getManagerEngineer()->getZoneManager()->unlock();
+            managerLockGuard.unlock();
 
             return true;
         }
@@ -6,13 +6,13 @@ namespace Raumserver
 {
     namespace Request
     {
-        RequestAction_KillSession::RequestAction_KillSession(std::string _url) : RequestAction(_url)
+        RequestAction_KillSession::RequestAction_KillSession(const std::string &_url) : RequestAction(_url)
         {
             action = RequestActionType::RAA_KILLSESSION;
         }
 
 
-        RequestAction_KillSession::RequestAction_KillSession(std::string _path, std::string _query) : RequestAction(_path, _query)
+        RequestAction_KillSession::RequestAction_KillSession(const std::string &_path, const std::string &_query) : RequestAction(_path, _query)
         {
             action = RequestActionType::RAA_KILLSESSION;
         }
@@ -5,15 +5,17 @@ namespace Raumserver
 {
     namespace Request
     {
-        RequestAction_LoadContainer::RequestAction_LoadContainer(std::string _url) : RequestAction(_url)
+        RequestAction_LoadContainer::RequestAction_LoadContainer(const std::string &_url) : RequestAction(_url)
         {
             action = RequestActionType::RAA_LOADCONTAINER;
+            priority = RequestActionPriority::RAP_LOW;
         }
 
 
-        RequestAction_LoadContainer::RequestAction_LoadContainer(std::string _path, std::string _query) : RequestAction(_path, _query)
+        RequestAction_LoadContainer::RequestAction_LoadContainer(const std::string &_path, const std::string &_query) : RequestAction(_path, _query)
         {
             action = RequestActionType::RAA_LOADCONTAINER;
+            priority = RequestActionPriority::RAP_LOW;
         }
 
 
@@ -61,8 +63,7 @@ namespace Raumserver
             if (trackIndex < 0)
                 trackIndex = 0;
 
-            getManagerEngineer()->getDeviceManager()->lock();
-            getManagerEngineer()->getZoneManager()->lock();
+            ManagerLockGuard managerLockGuard(this);
 
             try
             {
@@ -85,8 +86,7 @@ namespace Raumserver
                 logError("Unknown Exception!", CURRENT_POSITION);
             }
 
-            getManagerEngineer()->getDeviceManager()->unlock();
-            getManagerEngineer()->getZoneManager()->unlock();
+            managerLockGuard.unlock();
 
             return true;
         }
@@ -5,15 +5,17 @@ namespace Raumserver
 {
     namespace Request
     {
-        RequestAction_LoadPlaylist::RequestAction_LoadPlaylist(std::string _url) : RequestAction(_url)
+        RequestAction_LoadPlaylist::RequestAction_LoadPlaylist(const std::string &_url) : RequestAction(_url)
         {
             action = RequestActionType::RAA_LOADPLAYLIST;
+            priority = RequestActionPriority::RAP_LOW;
         }
 
 
-        RequestAction_LoadPlaylist::RequestAction_LoadPlaylist(std::string _path, std::string _query) : RequestAction(_path, _query)
+        RequestAction_LoadPlaylist::RequestAction_LoadPlaylist(const std::string &_path, const std::string &_query) : RequestAction(_path, _query)
         {
             action = RequestActionType::RAA_LOADPLAYLIST;
+            priority = RequestActionPriority::RAP_LOW;
         }
 
 
@@ -61,8 +63,7 @@ namespace Raumserver
             if (trackIndex < 0)
                 trackIndex = 0;
 
-            getManagerEngineer()->getDeviceManager()->lock();
-            getManagerEngineer()->getZoneManager()->lock();
+            ManagerLockGuard managerLockGuard(this);
 
             try
             {
@@ -83,8 +84,7 @@ namespace Raumserver
                 logError("Unknown Exception!", CURRENT_POSITION);
             }
 
-            getManagerEngineer()->getDeviceManager()->unlock();
-            getManagerEngineer()->getZoneManager()->unlock();
+            managerLockGuard.unlock();
 
             return true;
         }
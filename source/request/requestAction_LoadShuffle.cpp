@@ -5,17 +5,19 @@ namespace Raumserver
 {
     namespace Request
     {
-        RequestAction_LoadShuffle::RequestAction_LoadShuffle(std::string _url) : RequestAction(_url)
+        RequestAction_LoadShuffle::RequestAction_LoadShuffle(const std::string &_url) : RequestAction(_url)
         {
             action = RequestActionType::RAA_LOADSHUFFLE;
+            priority = RequestActionPriority::RAP_LOW;
             listRetrieved = false;
             shuffleContainerId = "";
         }
 
 
-        RequestAction_LoadShuffle::RequestAction_LoadShuffle(std::string _path, std::string _query) : RequestAction(_path, _query)
+        RequestAction_LoadShuffle::RequestAction_LoadShuffle(const std::string &_path, const std::string &_query) : RequestAction(_path, _query)
         {
             action = RequestActionType::RAA_LOADSHUFFLE;
+            priority = RequestActionPriority::RAP_LOW;
             listRetrieved = false;
             shuffleContainerId = "";
         }
@@ -65,8 +67,7 @@ namespace Raumserver
             auto source = Raumkernel::Tools::StringUtil::tolower(getOptionValue("source"));
             auto selection = getOptionValue("selection");
 
-            getManagerEngineer()->getDeviceManager()->lock();
-            getManagerEngineer()->getZoneManager()->lock();
+            ManagerLockGuard managerLockGuard(this);
 
             try
             {
@@ -145,8 +146,7 @@ namespace Raumserver
                 logError("Unknown Exception!", CURRENT_POSITION);
             }
 
-            getManagerEngineer()->getDeviceManager()->unlock();
-            getManagerEngineer()->getZoneManager()->unlock();
+            managerLockGuard.unlock();
 
             return true;
         }
@@ -5,15 +5,17 @@ namespace Raumserver
 {
     namespace Request
     {
-        RequestAction_LoadUri::RequestAction_LoadUri(std::string _url) : RequestAction(_url)
+        RequestAction_LoadUri::RequestAction_LoadUri(const std::string &_url) : RequestAction(_url)
         {
             action = RequestActionType::RAA_LOADURI;
+            priority = RequestActionPriority::RAP_LOW;
         }
 
 
-        RequestAction_LoadUri::RequestAction_LoadUri(std::string _path, std::string _query) : RequestAction(_path, _query)
+        RequestAction_LoadUri::RequestAction_LoadUri(const std::string &_path, const std::string &_query) : RequestAction(_path, _query)
         {
             action = RequestActionType::RAA_LOADURI;
+            priority = RequestActionPriority::RAP_LOW;
         }
 
 
@@ -53,8 +55,7 @@ namespace Raumserver
             auto id = getOptionValue("id");
             auto value = getOptionValue("value");
 
-            getManagerEngineer()->getDeviceManager()->lock();
-            getManagerEngineer()->getZoneManager()->lock();
+            ManagerLockGuard managerLockGuard(this);
 
             try
             {
@@ -75,8 +76,7 @@ namespace Raumserver
                 logError("Unknown Exception!", CURRENT_POSITION);
             }
 
-            getManagerEngineer()->getDeviceManager()->unlock();
-            getManagerEngineer()->getZoneManager()->unlock();
+            managerLockGuard.unlock();
 
             return true;
         }
@@ -5,15 +5,17 @@ namespace Raumserver
 {
     namespace Request
     {
-        RequestAction_Mute::RequestAction_Mute(std::string _url) : RequestAction(_url)
+        RequestAction_Mute::RequestAction_Mute(const std::string &_url) : RequestAction(_url)
         {
             action = RequestActionType::RAA_MUTE;
+            priority = RequestActionPriority::RAP_HIGH;
         }
 
 
-        RequestAction_Mute::RequestAction_Mute(std::string _path, std::string _query) : RequestAction(_path, _query)
+        RequestAction_Mute::RequestAction_Mute(const std::string &_path, const std::string &_query) : RequestAction(_path, _query)
         {
             action = RequestActionType::RAA_MUTE;
+            priority = RequestActionPriority::RAP_HIGH;
         }
 
 
@@ -45,8 +47,7 @@ namespace Raumserver
             auto zoneScope = isZoneScope(scope);
             bool mute = (value == "true" || value == "1" || value.empty()) ? true : false;
 
-            getManagerEngineer()->getDeviceManager()->lock();
-            getManagerEngineer()->getZoneManager()->lock();
+            ManagerLockGuard managerLockGuard(this);
 
             try
             {
@@ -82,8 +83,7 @@ namespace Raumserver
                 logError("Unknown Exception!", CURRENT_POSITION);
             }
 
-            getManagerEngineer()->getDeviceManager()->unlock();
-            getManagerEngineer()->getZoneManager()->unlock();
+            managerLockGuard.unlock();
 
             return true;
         }
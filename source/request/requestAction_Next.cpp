@@ -5,13 +5,13 @@ namespace Raumserver
 {
     namespace Request
     {
-        RequestAction_Next::RequestAction_Next(std::string _url) : RequestAction(_url)
+        RequestAction_Next::RequestAction_Next(const std::string &_url) : RequestAction(_url)
         {
             action = RequestActionType::RAA_NEXT;
         }
 
 
-        RequestAction_Next::RequestAction_Next(std::string _path, std::string _query) : RequestAction(_path, _query)
+        RequestAction_Next::RequestAction_Next(const std::string &_path, const std::string &_query) : RequestAction(_path, _query)
         {
             action = RequestActionType::RAA_NEXT;
         }
@@ -45,8 +45,7 @@ namespace Raumserver
         {
             auto id = getOptionValue("id");
 
-            getManagerEngineer()->getDeviceManager()->lock();
-            getManagerEngineer()->getZoneManager()->lock();
+            ManagerLockGuard managerLockGuard(this);
             
             try
             {
@@ -67,8 +66,7 @@ namespace Raumserver
                 logError("Unknown Exception!", CURRENT_POSITION);
             }
 
-            getManagerEngineer()->getDeviceManager()->unlock();
-            getManagerEngineer()->getZoneManager()->unlock();
+            managerLockGuard.unlock();
            
             return true;
         }
@@ -5,13 +5,13 @@ namespace Raumserver
 {
     namespace Request
     {
-        RequestAction_Prev::RequestAction_Prev(std::string _url) : RequestAction(_url)
+        RequestAction_Prev::RequestAction_Prev(const std::string &_url) : RequestAction(_url)
         {
             action = RequestActionType::RAA_PREV;
         }
 
 
-        RequestAction_Prev::RequestAction_Prev(std::string _path, std::string _query) : RequestAction(_path, _query)
+        RequestAction_Prev::RequestAction_Prev(const std::string &_path, const std::string &_query) : RequestAction(_path, _query)
         {
             action = RequestActionType::RAA_PREV;
         }
@@ -45,8 +45,7 @@ namespace Raumserver
         {
             auto id = getOptionValue("id");
 
-            getManagerEngineer()->getDeviceManager()->lock();
-            getManagerEngineer()->getZoneManager()->lock();
+            ManagerLockGuard managerLockGuard(this);
 
             try
             {
@@ -67,8 +66,7 @@ namespace Raumserver
                 logError("Unknown Exception!", CURRENT_POSITION);
             }
 
-            getManagerEngineer()->getDeviceManager()->unlock();
-            getManagerEngineer()->getZoneManager()->unlock();
+            managerLockGuard.unlock();
 
             return true;
         }
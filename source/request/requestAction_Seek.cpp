@@ -5,13 +5,13 @@ namespace Raumserver
 {
     namespace Request
     {
-        RequestAction_Seek::RequestAction_Seek(std::string _url) : RequestAction(_url)
+        RequestAction_Seek::RequestAction_Seek(const std::string &_url) : RequestAction(_url)
         {
             action = RequestActionType::RAA_SEEK;
         }
 
 
-        RequestAction_Seek::RequestAction_Seek(std::string _path, std::string _query) : RequestAction(_path, _query)
+        RequestAction_Seek::RequestAction_Seek(const std::string &_path, const std::string &_query) : RequestAction(_path, _query)
         {
             action = RequestActionType::RAA_SEEK;
         }
@@ -33,15 +33,12 @@ namespace Raumserver
             // raumserver/controller/seek?id=Schlafzimmer&value=150000
             // raumserver/controller/seek?id=uuid:3f68f253-df2a-4474-8640-fd45dd9ebf88&value=150000
 
-            auto id = getOptionValue("id");
-            auto valueString = getOptionValue("value");
-
-            if (id.empty())
+            if (getOptionValueView("id").empty())
             {
                 logError("'id' option is needed to execute 'seek' command!", CURRENT_FUNCTION);
                 isValid = false;
             }
-            if (valueString.empty())
+            if (getOptionValueView("value").empty())
             {
                 logError("'value' option is needed to execute 'seek' command!", CURRENT_FUNCTION);
                 isValid = false;
@@ -51,14 +48,59 @@ namespace Raumserver
         }
 
 
+        bool RequestAction_Seek::isRelativeSeek()
+        {
+            auto seekType = getOptionValueView("seektype");
+            return seekType.equalsLowerCase("rel") || seekType.equalsLowerCase("relative");
+        }
+
+
+        std::shared_ptr<RequestAction> RequestAction_Seek::createMergedRequestAction(std::shared_ptr<RequestAction> _requestAction)
+        {
+            auto requestActionSeek = std::dynamic_pointer_cast<RequestAction_Seek>(_requestAction);
+            if (!requestActionSeek)
+                return nullptr;
+
+            if (!getOptionValueView("id").equals(requestActionSeek->getOptionValueView("id")) ||
+                !getOptionValueView("sync").equals(requestActionSeek->getOptionValueView("sync")) ||
+                !getOptionValueView("wait").empty() || !requestActionSeek->getOptionValueView("wait").empty())
+                return nullptr;
+
+            // an absolute seek or a seek to a track will override the position we seeked to before
+            if (!requestActionSeek->isRelativeSeek())
+                return requestActionSeek;
+
+            // two relative seeks will be one relative seek with the summed up time
+            if (!isRelativeSeek())
+                return nullptr;
+
+            auto valueMS = getOptionValueView("value").toInt32() + requestActionSeek->getOptionValueView("value").toInt32();
+            std::string mergedQuery = "id=" + Raumkernel::Tools::UriUtil::encodeValue(getOptionValue("id")) + "&value=" + std::to_string(valueMS) + "&seektype=rel";
+            if (!getOptionValue("sync").empty())
+                mergedQuery += "&sync=" + Raumkernel::Tools::UriUtil::encodeValue(getOptionValue("sync"));
+
+            auto mergedRequestAction = createFromPath("/raumserver/controller/seek", mergedQuery);
+            if (!mergedRequestAction)
+                return nullptr;
+
+            mergedRequestAction->setManagerEngineer(getManagerEngineer());
+            mergedRequestAction->setManagerEngineerServer(getManagerEngineerServer());
+            mergedRequestAction->setLogObject(getLogObject());
+            if (!mergedRequestAction->isValid())
+                return nullptr;
+
+            return mergedRequestAction;
+        }
+
+
         bool RequestAction_Seek::executeAction()
         {
-            auto id = getOptionValue("id");
-            auto valueString = getOptionValue("value");
-            auto seekTypeString = getOptionValue("seektype");
+            // the options are only looked up as views, the id is copied once because the kernel needs a string
+            auto id = getOptionValueView("id").toString();
+            auto msOrTrack = getOptionValueView("value").toInt32();
+            auto seekTypeString = getOptionValueView("seektype");
 
-            getManagerEngineer()->getDeviceManager()->lock();
-            getManagerEngineer()->getZoneManager()->lock();
+            ManagerLockGuard managerLockGuard(this);
 
             try
             {
@@ -76,13 +118,10 @@ namespace Raumserver
                     auto seekType = Raumkernel::Devices::MediaRenderer_Seek::MRSEEK_ABS_TIME;
                     if (!seekTypeString.empty())
                     {
-                        if (Raumkernel::Tools::StringUtil::tolower(seekTypeString) == "rel" || Raumkernel::Tools::StringUtil::tolower(seekTypeString) == "relative") seekType = Raumkernel::Devices::MediaRenderer_Seek::MRSEEK_REL_TIME;
-                        if (Raumkernel::Tools::StringUtil::tolower(seekTypeString) == "track") seekType = Raumkernel::Devices::MediaRenderer_Seek::MRSEEK_TRACK_NR;
+                        if (seekTypeString.equalsLowerCase("rel") || seekTypeString.equalsLowerCase("relative")) seekType = Raumkernel::Devices::MediaRenderer_Seek::MRSEEK_REL_TIME;
+                        if (seekTypeString.equalsLowerCase("track")) seekType = Raumkernel::Devices::MediaRenderer_Seek::MRSEEK_TRACK_NR;
                     }
 
-                    // convert the value to an integer
-                    auto msOrTrack = Raumkernel::Tools::CommonUtil::toInt32(valueString);
-
                     // load the current media info from the renderer (we may get it from the subscripted info but to be save we get it directly)
                     auto mediaInfo = mediaRenderer->getMediaInfo(true);
 
@@ -107,8 +146,7 @@ namespace Raumserver
                 logError("Unknown Exception!", CURRENT_POSITION);
             }
 
-            getManagerEngineer()->getDeviceManager()->unlock();
-            getManagerEngineer()->getZoneManager()->unlock();
+            managerLockGuard.unlock();
 
 
             return true;
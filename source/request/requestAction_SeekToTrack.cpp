@@ -5,13 +5,13 @@ namespace Raumserver
 {
     namespace Request
     {
-        RequestAction_SeekToTrack::RequestAction_SeekToTrack(std::string _url) : RequestAction(_url)
+        RequestAction_SeekToTrack::RequestAction_SeekToTrack(const std::string &_url) : RequestAction(_url)
         {
             action = RequestActionType::RAA_SEEKTOTRACK;
         }
 
 
-        RequestAction_SeekToTrack::RequestAction_SeekToTrack(std::string _path, std::string _query) : RequestAction(_path, _query)
+        RequestAction_SeekToTrack::RequestAction_SeekToTrack(const std::string &_path, const std::string &_query) : RequestAction(_path, _query)
         {
             action = RequestActionType::RAA_SEEKTOTRACK;
         }
@@ -56,8 +56,7 @@ namespace Raumserver
             auto trackIndexString = getOptionValue("trackIndex");
             auto trackNumberString = getOptionValue("trackNumber");
 
-            getManagerEngineer()->getDeviceManager()->lock();
-            getManagerEngineer()->getZoneManager()->lock();
+            ManagerLockGuard managerLockGuard(this);
 
             try
             {
@@ -100,8 +99,7 @@ namespace Raumserver
                 logError("Unknown Exception!", CURRENT_POSITION);
             }
 
-            getManagerEngineer()->getDeviceManager()->unlock();
-            getManagerEngineer()->getZoneManager()->unlock();
+            managerLockGuard.unlock();
 
             return true;
         }
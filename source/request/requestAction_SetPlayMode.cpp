@@ -5,13 +5,13 @@ namespace Raumserver
 {
     namespace Request
     {
-        RequestAction_SetPlayMode::RequestAction_SetPlayMode(std::string _url) : RequestAction(_url)
+        RequestAction_SetPlayMode::RequestAction_SetPlayMode(const std::string &_url) : RequestAction(_url)
         {
             action = RequestActionType::RAA_SETPLAYMODE;
         }
 
 
-        RequestAction_SetPlayMode::RequestAction_SetPlayMode(std::string _path, std::string _query) : RequestAction(_path, _query)
+        RequestAction_SetPlayMode::RequestAction_SetPlayMode(const std::string &_path, const std::string &_query) : RequestAction(_path, _query)
         {
             action = RequestActionType::RAA_SETPLAYMODE;
         }
@@ -57,8 +57,7 @@ namespace Raumserver
             auto playModeString = getOptionValue("mode");
             auto playMode = Raumkernel::Devices::ConversionTool::stringToPlayMode(playModeString);
 
-            getManagerEngineer()->getDeviceManager()->lock();
-            getManagerEngineer()->getZoneManager()->lock();
+            ManagerLockGuard managerLockGuard(this);
 
             try
             {
@@ -90,8 +89,7 @@ namespace Raumserver
                 logError("Unknown Exception!", CURRENT_POSITION);
             }
 
-            getManagerEngineer()->getDeviceManager()->unlock();
-            getManagerEngineer()->getZoneManager()->unlock();
+            managerLockGuard.unlock();
 
             return true;
         }
@@ -5,13 +5,13 @@ namespace Raumserver
 {
     namespace Request
     {
-        RequestAction_SetVolume::RequestAction_SetVolume(std::string _url) : RequestAction(_url)
+        RequestAction_SetVolume::RequestAction_SetVolume(const std::string &_url) : RequestAction(_url)
         {
             action = RequestActionType::RAA_SETVOLUME;
         }
 
 
-        RequestAction_SetVolume::RequestAction_SetVolume(std::string _path, std::string _query) : RequestAction(_path, _query)
+        RequestAction_SetVolume::RequestAction_SetVolume(const std::string &_path, const std::string &_query) : RequestAction(_path, _query)
         {
             action = RequestActionType::RAA_SETVOLUME;
         }
@@ -35,17 +35,16 @@ namespace Raumserver
             // raumserver/controller/setVolume?id=uuid:3f68f253-df2a-4474-8640-fd45dd9ebf88&value=25
             // raumserver/controller/setVolume?id=uuid:3f68f253-df2a-4474-8640-fd45dd9ebf88&value=25&scope=zone
 
-            auto relativeValue = getOptionValue("relative");
-            bool relative = (relativeValue == "true" || relativeValue == "1") ? true : false;
+            bool relative = getOptionValueBool("relative");
 
-            auto value = getOptionValue("value");
+            auto value = getOptionValueView("value");
             if (value.empty())
             {
                 logError("'value' option is needed to execute 'setVolume' command!", CURRENT_FUNCTION);
                 isValid = false;
             }
 
-            auto valueChange = Raumkernel::Tools::CommonUtil::toInt32(value);
+            auto valueChange = value.toInt32();
             if ((valueChange < 0 || valueChange > 100) && relative == false)
             {
                 logError("'value' has to be between 0 and 100", CURRENT_FUNCTION);
@@ -56,19 +55,24 @@ namespace Raumserver
         }
 
 
+        bool RequestAction_SetVolume::getVolumeChange(bool &_relative, std::int32_t &_value)
+        {
+            _relative = getOptionValueBool("relative");
+            _value = getOptionValueView("value").toInt32();
+            return true;
+        }
+
+
         bool RequestAction_SetVolume::executeAction()
         {
-            auto id = getOptionValue("id");
-            auto scope = getOptionValue("scope");
-            auto value = Raumkernel::Tools::StringUtil::tolower(getOptionValue("value"));
-            auto valueVolume = Raumkernel::Tools::CommonUtil::toInt32(value);
-            auto relativeValue = getOptionValue("relative");
-            bool relative = (relativeValue == "true" || relativeValue == "1") ? true : false;
-            auto zoneScope = isZoneScope(scope);
+            // the options are only looked up as views, the id is copied once because the kernel needs a string
+            auto id = getOptionValueView("id").toString();
+            auto valueVolume = getOptionValueView("value").toInt32();
+            bool relative = getOptionValueBool("relative");
+            auto zoneScope = isZoneScope(getOptionValueView("scope"));
             std::int32_t newVolumeValue = 0;
 
-            getManagerEngineer()->getDeviceManager()->lock();
-            getManagerEngineer()->getZoneManager()->lock();
+            ManagerLockGuard managerLockGuard(this);
 
             try
             {
@@ -136,8 +140,7 @@ namespace Raumserver
                 logError("Unknown Exception!", CURRENT_POSITION);
             }
 
-            getManagerEngineer()->getDeviceManager()->unlock();
-            getManagerEngineer()->getZoneManager()->unlock();
+            managerLockGuard.unlock();
 
             return true;
         }
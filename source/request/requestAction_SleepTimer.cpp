@@ -5,13 +5,13 @@ namespace Raumserver
 {
     namespace Request
     {
-        RequestAction_SleepTimer::RequestAction_SleepTimer(std::string _url) : RequestAction(_url)
+        RequestAction_SleepTimer::RequestAction_SleepTimer(const std::string &_url) : RequestAction(_url)
         {
             action = RequestActionType::RAA_SLEEPTIMER;
         }
 
 
-        RequestAction_SleepTimer::RequestAction_SleepTimer(std::string _path, std::string _query) : RequestAction(_path, _query)
+        RequestAction_SleepTimer::RequestAction_SleepTimer(const std::string &_path, const std::string &_query) : RequestAction(_path, _query)
         {
             action = RequestActionType::RAA_SLEEPTIMER;
         }
@@ -69,8 +69,7 @@ namespace Raumserver
             auto secondsUntilSleep = Raumkernel::Tools::CommonUtil::toInt32(secondsUntilSleepString);
             auto secondsForVolumeRamp = Raumkernel::Tools::CommonUtil::toInt32(secondsForVolumeRampString);          
          
-            getManagerEngineer()->getDeviceManager()->lock();
-            getManagerEngineer()->getZoneManager()->lock();
+            ManagerLockGuard managerLockGuard(this);
 
             try
             {
@@ -119,8 +118,7 @@ namespace Raumserver
                 logError("Unknown Exception!", CURRENT_POSITION);
             }
 
-            getManagerEngineer()->getDeviceManager()->unlock();
-            getManagerEngineer()->getZoneManager()->unlock();
+            managerLockGuard.unlock();
 
             return true;
         }
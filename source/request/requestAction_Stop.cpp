@@ -5,15 +5,17 @@ namespace Raumserver
 {
     namespace Request
     {
-        RequestAction_Stop::RequestAction_Stop(std::string _url) : RequestAction(_url)
+        RequestAction_Stop::RequestAction_Stop(const std::string &_url) : RequestAction(_url)
         {
             action = RequestActionType::RAA_STOP;
+            priority = RequestActionPriority::RAP_HIGH;
         }
 
 
-        RequestAction_Stop::RequestAction_Stop(std::string _path, std::string _query) : RequestAction(_path, _query)
+        RequestAction_Stop::RequestAction_Stop(const std::string &_path, const std::string &_query) : RequestAction(_path, _query)
         {
             action = RequestActionType::RAA_STOP;
+            priority = RequestActionPriority::RAP_HIGH;
         }
 
 
@@ -39,8 +41,7 @@ namespace Raumserver
         {
             auto id = getOptionValue("id");
             
-            getManagerEngineer()->getDeviceManager()->lock();
-            getManagerEngineer()->getZoneManager()->lock();
+            ManagerLockGuard managerLockGuard(this);
 
             try
             {
@@ -73,8 +74,7 @@ namespace Raumserver
                 logError("Unknown Exception!", CURRENT_POSITION);
             }
 
-            getManagerEngineer()->getDeviceManager()->unlock();
-            getManagerEngineer()->getZoneManager()->unlock();
+            managerLockGuard.unlock();
 
             return true;
         }      
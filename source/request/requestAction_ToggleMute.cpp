@@ -5,15 +5,17 @@ namespace Raumserver
 {
     namespace Request
     {
-        RequestAction_ToggleMute::RequestAction_ToggleMute(std::string _url) : RequestAction(_url)
+        RequestAction_ToggleMute::RequestAction_ToggleMute(const std::string &_url) : RequestAction(_url)
         {
             action = RequestActionType::RAA_TOGGLEMUTE;
+            priority = RequestActionPriority::RAP_HIGH;
         }
 
 
-        RequestAction_ToggleMute::RequestAction_ToggleMute(std::string _path, std::string _query) : RequestAction(_path, _query)
+        RequestAction_ToggleMute::RequestAction_ToggleMute(const std::string &_path, const std::string &_query) : RequestAction(_path, _query)
         {
             action = RequestActionType::RAA_TOGGLEMUTE;
+            priority = RequestActionPriority::RAP_HIGH;
         }
 
 
@@ -44,8 +46,7 @@ namespace Raumserver
             auto zoneScope = isZoneScope(scope);
             bool mute = false;
 
-            getManagerEngineer()->getDeviceManager()->lock();
-            getManagerEngineer()->getZoneManager()->lock();
+            ManagerLockGuard managerLockGuard(this);
 
             try
             {
@@ -90,8 +91,7 @@ namespace Raumserver
                 logError("Unknown Exception!", CURRENT_POSITION);
             }
 
-            getManagerEngineer()->getDeviceManager()->unlock();
-            getManagerEngineer()->getZoneManager()->unlock();
+            managerLockGuard.unlock();
 
             return true;
         }
@@ -5,13 +5,13 @@ namespace Raumserver
 {
     namespace Request
     {
-        RequestAction_VolumeUp::RequestAction_VolumeUp(std::string _url) : RequestAction(_url)
+        RequestAction_VolumeUp::RequestAction_VolumeUp(const std::string &_url) : RequestAction(_url)
         {
             action = RequestActionType::RAA_VOLUMEUP;
         }
 
 
-        RequestAction_VolumeUp::RequestAction_VolumeUp(std::string _path, std::string _query) : RequestAction(_path, _query)
+        RequestAction_VolumeUp::RequestAction_VolumeUp(const std::string &_path, const std::string &_query) : RequestAction(_path, _query)
         {
             action = RequestActionType::RAA_VOLUMEUP;
         }
@@ -33,14 +33,14 @@ namespace Raumserver
             // raumserver/controller/volumeUp?id=uuid:3f68f253-df2a-4474-8640-fd45dd9ebf88&value=1
             // raumserver/controller/volumeUp?id=uuid:3f68f253-df2a-4474-8640-fd45dd9ebf88&value=1&scope=zone
 
-            auto value = getOptionValue("value");
+            auto value = getOptionValueView("value");
             if (value.empty())
             {
                 logError("'value' option is needed to execute 'volumeUp' command!", CURRENT_FUNCTION);
                 isValid = false;
             }
 
-            auto valueChange = Raumkernel::Tools::CommonUtil::toInt32(value);
+            auto valueChange = value.toInt32();
             if (valueChange <= 0)
             {
                 logError("'value' has to be greater than '0'", CURRENT_FUNCTION);
@@ -51,17 +51,23 @@ namespace Raumserver
         }
 
 
+        bool RequestAction_VolumeUp::getVolumeChange(bool &_relative, std::int32_t &_value)
+        {
+            _relative = true;
+            _value = getOptionValueView("value").toInt32();
+            return true;
+        }
+
+
         bool RequestAction_VolumeUp::executeAction()
         {
-            auto id = getOptionValue("id"); 
-            auto scope = getOptionValue("scope");
-            auto value = Raumkernel::Tools::StringUtil::tolower(getOptionValue("value"));
-            auto valueChange = Raumkernel::Tools::CommonUtil::toInt32(value);
-            auto zoneScope = isZoneScope(scope); 
+            // the options are only looked up as views, the id is copied once because the kernel needs a string
+            auto id = getOptionValueView("id").toString();
+            auto valueChange = getOptionValueView("value").toInt32();
+            auto zoneScope = isZoneScope(getOptionValueView("scope"));
             std::int32_t newVolumeValue = 0;
 
-            getManagerEngineer()->getDeviceManager()->lock();
-            getManagerEngineer()->getZoneManager()->lock();
+            ManagerLockGuard managerLockGuard(this);
 
             try
             {
@@ -112,8 +118,7 @@ namespace Raumserver
                 logError("Unknown Exception!", CURRENT_POSITION);
             }
 
-            getManagerEngineer()->getDeviceManager()->unlock();
-            getManagerEngineer()->getZoneManager()->unlock();
+            managerLockGuard.unlock();
 
             return true;
         }
@@ -0,0 +1,903 @@
+
+// Small load generator for the raumserver HTTP interface (linux only)
+// It does not link against the raumserver library, it only talks to a running server or uses header only parts of the library
+//
+// usage:
+//   benchmark longpoll <host> <port> <pollers> <requests> [path]
+//      measures the latency of <requests> sequential requests to [path] before and after <pollers> idle 
+//      long polling requests (getZoneConfig with the current update id) were opened. It prints the parked requests and the busy
+//      webserver threads of the server metrics too, because each parked long poll holds a webserver thread. Long polls beyond the
+//      'LongPollThreads' of the server are answered at once with an error and counted as rejected. Run it against the
+//      raumserver itself, the 'Simulation' settings will provide the zones if there is no Raumfeld system
+//   benchmark queue <actions> [slowActionMS]
+//      in process micro benchmark of the request action queue. It compares the old queue (worker polls every 20ms
+//      and holds the queue lock while executing) with the notifying queue (condition variable, executing unlocked)
+//      while measuring the blocking of the adding thread every 10th action is a slow one (eg. loadPlaylist) 
+//      which takes [slowActionMS] (default 200)
+//   benchmark rps <host> <port> <clients> <seconds> [path]
+//      measures the requests per second of <clients> parallel clients which request [path] for <seconds>, first with a new 
+//      connection for each request and then with kept alive connections (needs 'KeepAlive' enabled on the server)
+//   benchmark dispatch <iterations>
+//      in process micro benchmark of the action dispatch (path to action type and action type to name). It compares the old 
+//      dispatch (split the path, upper case the action and compare it with each name) with the hash table of the request action registry
+//   benchmark options <iterations>
+//      in process micro benchmark of the option parsing of a request (parse the query and look up the options like a SetVolume does).
+//      It compares the old parsing (a map of strings and a lower cased copy of the key for each lookup) with the option table and
+//      counts the heap allocations per request
+//   benchmark requestaction <iterations>
+//      in process micro benchmark of the life of a request action (create, parse and look up the options, destroy). It compares 
+//      the request action created with 'new' and heap strings with the pooled request action which keeps its strings in its arena.
+//      The request actions are stand-ins with the same members, the real 'createFromPath' and 'execute' need the library and the kernel.
+//      A third run adds the option lookups of 'SetVolume::executeAction', which still copies the id (an UDN is longer than the small
+//      string buffer) because the kernel takes a string. So the real request path still allocates: this copy, the queue node, the 
+//      response and the calls into the kernel. Fails only if creating the pooled request action and looking up its options allocates 
+//      after the first request (steady state)
+
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <queue>
+#include <functional>
+
+#include <unistd.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+#include <unordered_map>
+#include <new>
+
+#include <raumserver/request/requestActionNameTable.h>
+#include <raumserver/request/requestOptionTable.h>
+#include <raumserver/request/requestActionArena.h>
+#include <raumserver/request/requestActionPool.h>
+
+
+const std::string DEFAULT_REQUEST_PATH = "/raumserver/controller/getVersion";
+
+
+// counts the allocations of the whole process, used by the options benchmark
+std::atomic<std::uint64_t> allocationCount(0);
+
+void* operator new(std::size_t _size)
+{
+    allocationCount++;
+    void *memory = std::malloc(_size ? _size : 1);
+    if (!memory)
+        throw std::bad_alloc();
+    return memory;
+}
+
+void operator delete(void *_memory) noexcept
+{
+    std::free(_memory);
+}
+
+void operator delete(void *_memory, std::size_t) noexcept
+{
+    std::free(_memory);
+}
+
+
+int connectToServer(const std::string &_host, const std::string &_port)
+{
+    struct addrinfo hints, *result = nullptr;
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+
+    if (getaddrinfo(_host.c_str(), _port.c_str(), &hints, &result) != 0 || !result)
+        return -1;
+
+    int sock = socket(result->ai_family, result->ai_socktype, result->ai_protocol);
+    if (sock >= 0 && connect(sock, result->ai_addr, result->ai_addrlen) != 0)
+    {
+        close(sock);
+        sock = -1;
+    }
+    freeaddrinfo(result);
+
+    if (sock >= 0)
+    {
+        int flag = 1;
+        setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+    }
+    return sock;
+}
+
+
+bool sendRequest(int _sock, const std::string &_host, const std::string &_path)
+{
+    std::string request = "GET " + _path + " HTTP/1.1\r\nHost: " + _host + "\r\nConnection: close\r\n\r\n";
+    return send(_sock, request.c_str(), request.size(), 0) == (ssize_t)request.size();
+}
+
+
+// reads the whole response till the server closes the connection
+std::string readResponse(int _sock)
+{
+    std::string response;
+    char buffer[4096];
+    ssize_t len;
+    while ((len = recv(_sock, buffer, sizeof(buffer), 0)) > 0)
+        response.append(buffer, len);
+    return response;
+}
+
+
+std::string getHeaderValue(const std::string &_response, const std::string &_key)
+{
+    auto headerEnd = _response.find("\r\n\r\n");
+    auto header = _response.substr(0, headerEnd);
+    std::string headerLower = header, keyLower = _key + ":";
+    std::transform(headerLower.begin(), headerLower.end(), headerLower.begin(), ::tolower);
+    std::transform(keyLower.begin(), keyLower.end(), keyLower.begin(), ::tolower);
+
+    auto pos = headerLower.find("\r\n" + keyLower);
+    if (pos == std::string::npos)
+        return "";
+    pos += 2 + keyLower.size();
+    auto end = header.find("\r\n", pos);
+    auto value = header.substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+    value.erase(0, value.find_first_not_of(" "));
+    return value;
+}
+
+
+// reads one response which has to be framed with 'Content-Length' from a kept alive connection
+// data which was received after the response will stay in '_buffer' for the next response
+bool readFramedResponse(int _sock, std::string &_buffer)
+{
+    char buffer[4096];
+    ssize_t len;
+    std::size_t headerEnd;
+
+    while ((headerEnd = _buffer.find("\r\n\r\n")) == std::string::npos)
+    {
+        if ((len = recv(_sock, buffer, sizeof(buffer), 0)) <= 0)
+            return false;
+        _buffer.append(buffer, len);
+    }
+
+    auto contentLength = getHeaderValue(_buffer, "Content-Length");
+    if (contentLength.empty())
+        return false;
+
+    std::size_t responseLength = headerEnd + 4 + std::stoul(contentLength);
+    while (_buffer.size() < responseLength)
+    {
+        if ((len = recv(_sock, buffer, sizeof(buffer), 0)) <= 0)
+            return false;
+        _buffer.append(buffer, len);
+    }
+
+    _buffer.erase(0, responseLength);
+    return true;
+}
+
+
+// does '_count' sequential requests and returns the latency of each request in microseconds
+std::vector<double> measureLatency(const std::string &_host, const std::string &_port, const std::string &_path, std::uint32_t _count)
+{
+    std::vector<double> latencies;
+    for (std::uint32_t i = 0; i < _count; i++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        int sock = connectToServer(_host, _port);
+        if (sock < 0)
+        {
+            std::cerr << "Connect failed!" << std::endl;
+            continue;
+        }
+        if (sendRequest(sock, _host, _path))
+            readResponse(sock);
+        close(sock);
+        auto end = std::chrono::steady_clock::now();
+        latencies.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+    }
+    return latencies;
+}
+
+
+// returns the value of a metric without labels from the '/raumserver/metrics' text of the server or an empty string
+std::string getMetricValue(const std::string &_host, const std::string &_port, const std::string &_name)
+{
+    int sock = connectToServer(_host, _port);
+    if (sock < 0)
+        return "";
+    std::string response;
+    if (sendRequest(sock, _host, "/raumserver/metrics"))
+        response = readResponse(sock);
+    close(sock);
+
+    auto pos = response.find("\n" + _name + " ");
+    if (pos == std::string::npos)
+        return "";
+    pos += 2 + _name.size();
+    return response.substr(pos, response.find("\n", pos) - pos);
+}
+
+
+void printServerThreads(const std::string &_host, const std::string &_port)
+{
+    std::cout << "Server: parked long polls=" << getMetricValue(_host, _port, "raumserver_longpoll_requests")
+        << " busy threads=" << getMetricValue(_host, _port, "raumserver_webserver_threads_busy")
+        << " of " << getMetricValue(_host, _port, "raumserver_webserver_threads") << std::endl;
+}
+
+
+void printLatency(const std::string &_title, std::vector<double> _latencies)
+{
+    if (_latencies.empty())
+    {
+        std::cout << _title << ": no requests succeeded" << std::endl;
+        return;
+    }
+    std::sort(_latencies.begin(), _latencies.end());
+    double sum = 0;
+    for (auto latency : _latencies)
+        sum += latency;
+    std::cout << _title << ": requests=" << _latencies.size()
+        << " avg=" << sum / _latencies.size() << "us"
+        << " p50=" << _latencies[_latencies.size() / 2] << "us"
+        << " p99=" << _latencies[(_latencies.size() * 99) / 100] << "us"
+        << " max=" << _latencies.back() << "us" << std::endl;
+}
+
+
+int benchmarkLongPoll(const std::string &_host, const std::string &_port, std::uint32_t _pollers, std::uint32_t _requests, const std::string &_path)
+{
+    // get the current update id of the zone config so the long polls will stay parked
+    int sock = connectToServer(_host, _port);
+    if (sock < 0 || !sendRequest(sock, _host, "/raumserver/data/getZoneConfig"))
+    {
+        std::cerr << "Can't get update id from server!" << std::endl;
+        return 1;
+    }
+    auto updateId = getHeaderValue(readResponse(sock), "updateId");
+    close(sock);
+    std::cout << "Current zone config update id: " << updateId << std::endl;
+
+    printServerThreads(_host, _port);
+    printLatency("Without long polls", measureLatency(_host, _port, _path, _requests));
+
+    std::vector<int> pollerSockets;
+    for (std::uint32_t i = 0; i < _pollers; i++)
+    {
+        sock = connectToServer(_host, _port);
+        if (sock < 0 || !sendRequest(sock, _host, "/raumserver/data/getZoneConfig?updateId=" + updateId))
+        {
+            std::cerr << "Opening long poll " << i << " failed!" << std::endl;
+            if (sock >= 0)
+                close(sock);
+            continue;
+        }
+        pollerSockets.push_back(sock);
+    }
+    std::cout << "Opened long polls: " << pollerSockets.size() << std::endl;
+
+    // give the server the time to park the requests before we look at its threads
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    printServerThreads(_host, _port);
+
+    // a parked long poll does not answer till the zone config changes, so a poller which already got data was rejected
+    std::uint32_t rejectedCount = 0;
+    for (auto pollerSocket : pollerSockets)
+    {
+        char buffer;
+        if (recv(pollerSocket, &buffer, 1, MSG_DONTWAIT | MSG_PEEK) > 0)
+            rejectedCount++;
+    }
+    std::cout << "Rejected long polls: " << rejectedCount << std::endl;
+
+    printLatency("With long polls", measureLatency(_host, _port, _path, _requests));
+
+    for (auto pollerSocket : pollerSockets)
+        close(pollerSocket);
+
+    return 0;
+}
+
+
+// a simulated action for the queue benchmark. It stores the time it was added to the queue and the time the worker started it
+struct QueueBenchmarkAction
+{
+    std::chrono::steady_clock::time_point enqueueTime;
+    std::chrono::steady_clock::time_point startTime;
+    std::uint32_t durationMS;
+    std::atomic_bool started;
+};
+
+
+// the queue like it was before: the worker wakes every 20ms and holds the queue lock while the action is executed
+class PollingActionQueue
+{
+    public:
+        void start()
+        {
+            stopThread = false;
+            workerThread = std::thread([this]
+            {
+                while (!stopThread)
+                {
+                    mutexQueue.lock();
+                    if (actionQueue.size())
+                    {
+                        auto action = actionQueue.front();
+                        action->startTime = std::chrono::steady_clock::now();
+                        action->started = true;
+                        std::this_thread::sleep_for(std::chrono::milliseconds(action->durationMS));
+                        actionQueue.pop();
+                    }
+                    mutexQueue.unlock();
+                    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                }
+            });
+        }
+
+        void stop()
+        {
+            stopThread = true;
+            workerThread.join();
+        }
+
+        void add(QueueBenchmarkAction *_action)
+        {
+            std::unique_lock<std::mutex> lock(mutexQueue);
+            _action->enqueueTime = std::chrono::steady_clock::now();
+            actionQueue.push(_action);
+        }
+
+    protected:
+        std::thread workerThread;
+        std::atomic_bool stopThread;
+        std::mutex mutexQueue;
+        std::queue<QueueBenchmarkAction*> actionQueue;
+};
+
+
+// the queue like it is now: the worker waits on a condition variable and executes without holding the queue lock
+class NotifyingActionQueue
+{
+    public:
+        void start()
+        {
+            stopThread = false;
+            workerThread = std::thread([this]
+            {
+                while (!stopThread)
+                {
+                    QueueBenchmarkAction *action;
+                    {
+                        std::unique_lock<std::mutex> lock(mutexQueue);
+                        condQueue.wait(lock, [this] { return stopThread || !actionQueue.empty(); });
+                        if (stopThread)
+                            break;
+                        action = actionQueue.front();
+                        actionQueue.pop();
+                    }
+                    action->startTime = std::chrono::steady_clock::now();
+                    action->started = true;
+                    std::this_thread::sleep_for(std::chrono::milliseconds(action->durationMS));
+                }
+            });
+        }
+
+        void stop()
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutexQueue);
+                stopThread = true;
+            }
+            condQueue.notify_all();
+            workerThread.join();
+        }
+
+        void add(QueueBenchmarkAction *_action)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutexQueue);
+                _action->enqueueTime = std::chrono::steady_clock::now();
+                actionQueue.push(_action);
+            }
+            condQueue.notify_one();
+        }
+
+    protected:
+        std::thread workerThread;
+        std::atomic_bool stopThread;
+        std::mutex mutexQueue;
+        std::condition_variable condQueue;
+        std::queue<QueueBenchmarkAction*> actionQueue;
+};
+
+
+// first adds '_count' fast actions one after another to an idle queue and measures the time till the worker started each one.
+// Then it adds '_count' actions while slow actions are running and measures how long the adding thread (the http thread) was blocked
+template <typename QueueType>
+void benchmarkActionQueue(const std::string &_title, std::uint32_t _count, std::uint32_t _slowActionMS)
+{
+    QueueType actionQueue;
+    std::vector<QueueBenchmarkAction> actions(_count * 2);
+    std::vector<double> blockingTimes, startLatencies;
+
+    actionQueue.start();
+    for (std::uint32_t i = 0; i < _count; i++)
+    {
+        actions[i].durationMS = 0;
+        actions[i].started = false;
+        actionQueue.add(&actions[i]);
+        while (!actions[i].started)
+            std::this_thread::yield();
+        startLatencies.push_back(std::chrono::duration<double, std::micro>(actions[i].startTime - actions[i].enqueueTime).count());
+    }
+
+    for (std::uint32_t i = _count; i < _count * 2; i++)
+    {
+        // every 10th action is a slow one
+        actions[i].durationMS = (i % 10 == 0) ? _slowActionMS : 0;
+        actions[i].started = false;
+
+        auto start = std::chrono::steady_clock::now();
+        actionQueue.add(&actions[i]);
+        blockingTimes.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    // wait till all actions are started before we stop the worker
+    for (auto &action : actions)
+    {
+        while (!action.started)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    actionQueue.stop();
+
+    printLatency(_title + " enqueue to start (idle queue)", startLatencies);
+    printLatency(_title + " enqueue blocking (slow actions running)", blockingTimes);
+}
+
+
+int benchmarkQueue(std::uint32_t _count, std::uint32_t _slowActionMS)
+{
+    benchmarkActionQueue<PollingActionQueue>("Polling queue", _count, _slowActionMS);
+    benchmarkActionQueue<NotifyingActionQueue>("Notifying queue", _count, _slowActionMS);
+    return 0;
+}
+
+
+// the names of the actions in the order of the old if-chains
+const std::vector<std::string> ACTION_NAMES = { "NEXT", "PAUSE", "PLAY", "PREV", "SETVOLUME", "STOP", "VOLUMEDOWN", "VOLUMEUP", "VOLUMECHANGE", "CREATEZONE",
+                                                "ADDTOZONE", "DROPFROMZONE", "MUTE", "UNMUTE", "SETPLAYMODE", "LOADPLAYLIST", "LOADCONTAINER", "LOADURI", "SEEK",
+                                                "FADETOVOLUME", "TOGGLEMUTE", "SLEEPTIMER", "SEEKTOTRACK", "LOADSHUFFLE", "ENTERAUTOMATICSTANDBY", "ENTERMANUALSTANDBY",
+                                                "LEAVESTANDBY", "CRASH", "GETVERSION", "GETZONECONFIG", "GETMEDIALIST", "GETZONEMEDIALIST", "GETRENDERERSTATE",
+                                                "GETRENDERERTRANSPORTSTATE", "GETREQUESTSTATUS", "KILLSESSION" };
+
+
+std::vector<std::string> explodePath(const std::string &_path)
+{
+    std::vector<std::string> parts;
+    std::size_t start = 0, pos;
+    while ((pos = _path.find('/', start)) != std::string::npos)
+    {
+        parts.push_back(_path.substr(start, pos - start));
+        start = pos + 1;
+    }
+    parts.push_back(_path.substr(start));
+    return parts;
+}
+
+
+// the old dispatch: split the path, upper case the action and compare it with each name. The name of the type is found the same way
+std::size_t dispatchOld(const std::string &_path, std::string &_name)
+{
+    auto parts = explodePath(_path);
+    if (parts.size() != 4)
+        return 0;
+
+    std::string action = parts[3];
+    std::transform(action.begin(), action.end(), action.begin(), ::toupper);
+
+    std::size_t type = 0;
+    for (std::size_t i = 0; i < ACTION_NAMES.size(); i++)
+    {
+        if (action == ACTION_NAMES[i])
+        {
+            type = i + 1;
+            break;
+        }
+    }
+
+    for (std::size_t i = 0; i < ACTION_NAMES.size(); i++)
+    {
+        if (type == i + 1)
+        {
+            _name = ACTION_NAMES[i];
+            break;
+        }
+    }
+    return type;
+}
+
+
+// the new dispatch: look up the last path segment in the hash table, the name of the type is taken from an array
+std::size_t dispatchTable(const Raumserver::Request::RequestActionNameTable<std::size_t> &_table, const std::string &_path, std::string &_name)
+{
+    std::size_t slashCount = 0, actionPos = 0;
+    for (std::size_t i = 0; i < _path.length(); i++)
+    {
+        if (_path[i] == '/')
+        {
+            slashCount++;
+            actionPos = i + 1;
+        }
+    }
+    if (slashCount != 3 || actionPos >= _path.length())
+        return 0;
+
+    auto type = _table.find(_path.c_str() + actionPos, _path.length() - actionPos);
+    if (!type)
+        return 0;
+    _name = ACTION_NAMES[*type - 1];
+    return *type;
+}
+
+
+int benchmarkDispatch(std::uint32_t _iterations)
+{
+    Raumserver::Request::RequestActionNameTable<std::size_t> table;
+    std::vector<std::string> paths;
+
+    for (std::size_t i = 0; i < ACTION_NAMES.size(); i++)
+    {
+        table.insert(ACTION_NAMES[i], i + 1);
+        // the clients use mixed case names (eg. 'setVolume')
+        std::string name = ACTION_NAMES[i];
+        std::transform(name.begin() + 1, name.end(), name.begin() + 1, ::tolower);
+        paths.push_back("/raumserver/controller/" + name);
+    }
+
+    auto measure = [&](const std::string &_title, std::function<std::size_t(const std::string&, std::string&)> _dispatch)
+    {
+        std::string name;
+        std::size_t checksum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (std::uint32_t i = 0; i < _iterations; i++)
+        {
+            for (auto &path : paths)
+                checksum += _dispatch(path, name) + name.length();
+        }
+        auto durationNS = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        std::cout << _title << ": " << (double)durationNS / ((double)_iterations * paths.size()) << "ns per dispatch (checksum " << checksum << ")" << std::endl;
+    };
+
+    measure("If-chain dispatch", [](const std::string &_path, std::string &_name) { return dispatchOld(_path, _name); });
+    measure("Hash table dispatch", [&table](const std::string &_path, std::string &_name) { return dispatchTable(table, _path, _name); });
+    return 0;
+}
+
+
+// the old option parsing: the query is split into a map of strings and each lookup creates a lower cased copy of the key
+std::string unescapeOld(const std::string &_value)
+{
+    std::string unescaped;
+    for (std::size_t i = 0; i < _value.length(); i++)
+    {
+        if (_value[i] == '%' && i + 2 < _value.length())
+        {
+            unescaped += (char)std::strtol(_value.substr(i + 1, 2).c_str(), nullptr, 16);
+            i += 2;
+        }
+        else
+            unescaped += _value[i];
+    }
+    return unescaped;
+}
+
+
+std::size_t parseOptionsOld(const std::string &_query, const std::vector<std::string> &_keys)
+{
+    std::unordered_map<std::string, std::string> options;
+    std::size_t pos = 0;
+    while (pos < _query.length())
+    {
+        auto end = _query.find('&', pos);
+        if (end == std::string::npos)
+            end = _query.length();
+        auto pair = _query.substr(pos, end - pos);
+        auto separator = pair.find('=');
+        auto key = pair.substr(0, separator);
+        std::transform(key.begin(), key.end(), key.begin(), ::tolower);
+        options[key] = separator == std::string::npos ? "" : unescapeOld(pair.substr(separator + 1));
+        pos = end + 1;
+    }
+
+    std::size_t checksum = 0;
+    for (auto &key : _keys)
+    {
+        std::string keyLower = key;
+        std::transform(keyLower.begin(), keyLower.end(), keyLower.begin(), ::tolower);
+        auto it = options.find(keyLower);
+        std::string value = it != options.end() ? it->second : "";
+        checksum += value.length();
+    }
+    return checksum;
+}
+
+
+// the new option parsing: the option table of the request action is reused, the values are looked up as views
+std::size_t parseOptionsTable(Raumserver::Request::RequestOptionTable &_table, const std::string &_query, const std::vector<std::string> &_keys)
+{
+    _table.clear();
+    _table.parseQuery(_query.c_str(), _query.length());
+
+    std::size_t checksum = 0;
+    Raumserver::Request::RequestOptionValue value;
+    for (auto &key : _keys)
+    {
+        if (_table.find(key.c_str(), key.length(), value))
+            checksum += value.length;
+    }
+    return checksum;
+}
+
+
+int benchmarkOptions(std::uint32_t _iterations)
+{
+    // a typical volume change of a client and the options a SetVolume looks up (including 'sync' and 'relative')
+    const std::string query = "id=uuid%3A3f68f253-df2a-4474-8640-fd45dd9ebf88&value=25&scope=room&relative=false&sync=true";
+    const std::vector<std::string> keys = { "id", "scope", "value", "relative", "sync", "sessionId" };
+    Raumserver::Request::RequestOptionTable table;
+
+    auto measure = [&](const std::string &_title, std::function<std::size_t()> _parse)
+    {
+        std::size_t checksum = 0;
+        auto allocationsBefore = allocationCount.load();
+        auto start = std::chrono::steady_clock::now();
+        for (std::uint32_t i = 0; i < _iterations; i++)
+            checksum += _parse();
+        auto durationNS = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        auto allocations = allocationCount.load() - allocationsBefore;
+        std::cout << _title << ": " << (double)durationNS / _iterations << "ns and " << (double)allocations / _iterations << " allocations per request (checksum " << checksum << ")" << std::endl;
+    };
+
+    measure("Map of strings", [&]() { return parseOptionsOld(query, keys); });
+    measure("Option table", [&]() { return parseOptionsTable(table, query, keys); });
+    return 0;
+}
+
+
+// the request action like it was before: created with 'new', the url, the query and the options are on the heap
+class BenchmarkRequestActionHeap
+{
+    public:
+        BenchmarkRequestActionHeap(std::string _path, std::string _query)
+        {
+            url = _path;
+            query = _query;
+            error = "";
+        }
+        virtual ~BenchmarkRequestActionHeap() {}
+
+        std::string url;
+        std::string query;
+        Raumserver::Request::RequestOptionTable requestOptions;
+        std::unordered_map<std::string, std::string> jsonOptions;
+        std::string error;
+};
+
+
+// the request action like it is now: allocated from the pool, the url, the query and the options are in its arena
+class BenchmarkRequestActionPooled
+{
+    public:
+        BenchmarkRequestActionPooled(const std::string &_path, const std::string &_query) : url(&arena), query(&arena), requestOptions(&arena)
+        {
+            url.assign(_path.c_str(), _path.length());
+            query.assign(_query.c_str(), _query.length());
+            error = "";
+        }
+        virtual ~BenchmarkRequestActionPooled() {}
+
+        Raumserver::Request::RequestActionArena arena;
+        Raumserver::Request::RequestActionArenaString url;
+        Raumserver::Request::RequestActionArenaString query;
+        Raumserver::Request::BasicRequestOptionTable<Raumserver::Request::RequestActionArenaAllocator<char>> requestOptions;
+        std::unordered_map<std::string, std::string> jsonOptions;
+        std::string error;
+};
+
+
+template <typename TRequestAction> std::size_t lookupRequestActionOptions(TRequestAction &_requestAction, const std::vector<std::string> &_keys)
+{
+    _requestAction.requestOptions.parseQuery(_requestAction.query.c_str(), _requestAction.query.length());
+
+    std::size_t checksum = _requestAction.url.length();
+    Raumserver::Request::RequestOptionValue value;
+    for (auto &key : _keys)
+    {
+        if (_requestAction.requestOptions.find(key.c_str(), key.length(), value))
+            checksum += value.length;
+    }
+    return checksum;
+}
+
+
+// does the option lookups of 'SetVolume::executeAction': the options are views, the id is copied once for the kernel
+template <typename TRequestAction> std::size_t executeRequestActionOptions(TRequestAction &_requestAction)
+{
+    Raumserver::Request::RequestOptionValue id, scope, value;
+    _requestAction.requestOptions.find("id", 2, id);
+    _requestAction.requestOptions.find("scope", 5, scope);
+    _requestAction.requestOptions.find("value", 5, value);
+
+    std::string kernelId = id.toString();
+    return kernelId.length() + (scope.equalsLowerCase("zone") ? 1 : 0) + (std::size_t)value.toInt32();
+}
+
+
+int benchmarkRequestAction(std::uint32_t _iterations)
+{
+    // the request of the http connection (civetweb gives the path and the query as c strings)
+    const char* requestUri = "/raumserver/controller/setVolume";
+    const char* queryString = "id=uuid%3A3f68f253-df2a-4474-8640-fd45dd9ebf88&value=25&scope=room&relative=false&sync=true";
+    const std::vector<std::string> keys = { "id", "scope", "value", "relative", "sync", "sessionId" };
+    std::string requestPath, requestQuery;
+    std::uint64_t pooledAllocations = 0, executeAllocations = 0;
+
+    auto measure = [&](const std::string &_title, std::function<std::size_t()> _request)
+    {
+        // the first request fills the pool and the buffers of the thread, after that the server is in its steady state
+        std::size_t checksum = _request();
+        auto allocationsBefore = allocationCount.load();
+        auto start = std::chrono::steady_clock::now();
+        for (std::uint32_t i = 0; i < _iterations; i++)
+            checksum += _request();
+        auto durationNS = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        auto allocations = allocationCount.load() - allocationsBefore;
+        std::cout << _title << ": " << (double)durationNS / _iterations << "ns and " << (double)allocations / _iterations << " allocations per request (checksum " << checksum << ")" << std::endl;
+        return allocations;
+    };
+
+    measure("Heap request action", [&]()
+    {
+        auto requestAction = std::shared_ptr<BenchmarkRequestActionHeap>(new BenchmarkRequestActionHeap(requestUri, queryString));
+        return lookupRequestActionOptions(*requestAction, keys);
+    });
+
+    pooledAllocations = measure("Pooled request action", [&]()
+    {
+        requestPath.assign(requestUri);
+        requestQuery.assign(queryString);
+        auto requestAction = std::allocate_shared<BenchmarkRequestActionPooled>(Raumserver::Request::RequestActionPoolAllocator<BenchmarkRequestActionPooled>(), requestPath, requestQuery);
+        return lookupRequestActionOptions(*requestAction, keys);
+    });
+
+    executeAllocations = measure("Pooled request action with execution", [&]()
+    {
+        requestPath.assign(requestUri);
+        requestQuery.assign(queryString);
+        auto requestAction = std::allocate_shared<BenchmarkRequestActionPooled>(Raumserver::Request::RequestActionPoolAllocator<BenchmarkRequestActionPooled>(), requestPath, requestQuery);
+        return lookupRequestActionOptions(*requestAction, keys) + executeRequestActionOptions(*requestAction);
+    });
+
+    std::cout << "Pool: allocated blocks=" << Raumserver::Request::RequestActionPool::getInstance().getAllocationCount() << " reused blocks=" << Raumserver::Request::RequestActionPool::getInstance().getReuseCount() << std::endl;
+
+    if (executeAllocations > pooledAllocations)
+        std::cout << "The execution still does " << (double)(executeAllocations - pooledAllocations) / _iterations << " allocations per request (the id for the kernel). Not measured: the queue, the response and the kernel" << std::endl;
+
+    if (pooledAllocations)
+    {
+        std::cout << "FAILED: the pooled request action allocates in the steady state" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+
+// runs '_clients' threads which do requests for '_seconds' and returns the count of successful requests
+std::uint64_t runRequestsPerSecond(const std::string &_host, const std::string &_port, std::uint32_t _clients, std::uint32_t _seconds, const std::string &_path, bool _keepAlive)
+{
+    std::atomic<std::uint64_t> requestCount(0);
+    std::vector<std::thread> clients;
+    auto endTime = std::chrono::steady_clock::now() + std::chrono::seconds(_seconds);
+
+    for (std::uint32_t i = 0; i < _clients; i++)
+    {
+        clients.push_back(std::thread([&]
+        {
+            int sock = -1;
+            std::string buffer;
+            std::string keepAliveRequest = "GET " + _path + " HTTP/1.1\r\nHost: " + _host + "\r\nConnection: keep-alive\r\n\r\n";
+
+            while (std::chrono::steady_clock::now() < endTime)
+            {
+                if (!_keepAlive)
+                {
+                    sock = connectToServer(_host, _port);
+                    if (sock < 0)
+                        continue;
+                    if (sendRequest(sock, _host, _path) && !readResponse(sock).empty())
+                        requestCount++;
+                    close(sock);
+                    continue;
+                }
+
+                if (sock < 0)
+                {
+                    sock = connectToServer(_host, _port);
+                    buffer.clear();
+                    if (sock < 0)
+                        continue;
+                }
+                if (send(sock, keepAliveRequest.c_str(), keepAliveRequest.size(), 0) == (ssize_t)keepAliveRequest.size() && readFramedResponse(sock, buffer))
+                {
+                    requestCount++;
+                }
+                else
+                {
+                    close(sock);
+                    sock = -1;
+                }
+            }
+
+            if (sock >= 0)
+                close(sock);
+        }));
+    }
+
+    for (auto &client : clients)
+        client.join();
+
+    return requestCount;
+}
+
+
+int benchmarkRequestsPerSecond(const std::string &_host, const std::string &_port, std::uint32_t _clients, std::uint32_t _seconds, const std::string &_path)
+{
+    auto closeCount = runRequestsPerSecond(_host, _port, _clients, _seconds, _path, false);
+    std::cout << "New connection for each request: requests=" << closeCount << " rps=" << closeCount / std::max(_seconds, 1u) << std::endl;
+
+    auto keepAliveCount = runRequestsPerSecond(_host, _port, _clients, _seconds, _path, true);
+    std::cout << "Kept alive connections: requests=" << keepAliveCount << " rps=" << keepAliveCount / std::max(_seconds, 1u) << std::endl;
+
+    return 0;
+}
+
+
+int main(int argc, char *argv[])
+{
+    std::string mode = argc > 1 ? argv[1] : "";
+
+    if (mode == "longpoll" && argc >= 6)
+        return benchmarkLongPoll(argv[2], argv[3], std::atoi(argv[4]), std::atoi(argv[5]), argc > 6 ? argv[6] : DEFAULT_REQUEST_PATH);
+    if (mode == "queue" && argc >= 3)
+        return benchmarkQueue(std::atoi(argv[2]), argc > 3 ? std::atoi(argv[3]) : 200);
+    if (mode == "rps" && argc >= 6)
+        return benchmarkRequestsPerSecond(argv[2], argv[3], std::atoi(argv[4]), std::atoi(argv[5]), argc > 6 ? argv[6] : DEFAULT_REQUEST_PATH);
+    if (mode == "dispatch" && argc >= 3)
+        return benchmarkDispatch(std::atoi(argv[2]));
+    if (mode == "options" && argc >= 3)
+        return benchmarkOptions(std::atoi(argv[2]));
+    if (mode == "requestaction" && argc >= 3)
+        return benchmarkRequestAction(std::atoi(argv[2]));
+
+    std::cout << "usage:" << std::endl;
+    std::cout << "  benchmark longpoll <host> <port> <pollers> <requests> [path]" << std::endl;
+    std::cout << "  benchmark queue <actions> [slowActionMS]" << std::endl;
+    std::cout << "  benchmark rps <host> <port> <clients> <seconds> [path]" << std::endl;
+    std::cout << "  benchmark dispatch <iterations>" << std::endl;
+    std::cout << "  benchmark options <iterations>" << std::endl;
+    std::cout << "  benchmark requestaction <iterations>" << std::endl;
+    return 1;
+}
@@ -0,0 +1,158 @@
+#include <raumserver/webserver/responseCompression.h>
+
+namespace Raumserver
+{
+    namespace Server
+    {
+
+        ContentEncoding ResponseCompression::getAcceptedEncoding(const char* _acceptEncoding)
+        {
+            ContentEncoding encoding = ContentEncoding::CE_NONE;
+
+            #ifdef USE_ZLIB
+                if (!_acceptEncoding)
+                    return encoding;
+
+                // the header contains a list of encodings with an optional quality value (eg. 'gzip;q=1.0, deflate, identity;q=0')
+                // encodings with a quality of 0 are not accepted. We prefer gzip because some clients can't handle deflate
+                auto encodings = Raumkernel::Tools::StringUtil::explodeString(Raumkernel::Tools::StringUtil::tolower(_acceptEncoding), ",");
+                for (auto encodingValue : encodings)
+                {
+                    std::string quality = "";
+                    auto qualityPos = encodingValue.find(";");
+                    if (qualityPos != std::string::npos)
+                    {
+                        auto qPos = encodingValue.find("q=", qualityPos);
+                        if (qPos != std::string::npos)
+                            quality = encodingValue.substr(qPos + 2);
+                        encodingValue = encodingValue.substr(0, qualityPos);
+                    }
+                    encodingValue.erase(0, encodingValue.find_first_not_of(" \t"));
+                    encodingValue.erase(encodingValue.find_last_not_of(" \t") + 1);
+
+                    if (!quality.empty() && std::atof(quality.c_str()) <= 0)
+                        continue;
+
+                    if (encodingValue == "gzip")
+                        return ContentEncoding::CE_GZIP;
+                    if (encodingValue == "deflate")
+                        encoding = ContentEncoding::CE_DEFLATE;
+                }
+            #endif
+
+            return encoding;
+        }
+
+
+        std::string ResponseCompression::contentEncodingToString(ContentEncoding _encoding)
+        {
+            switch (_encoding)
+            {
+                case ContentEncoding::CE_GZIP: return "gzip";
+                case ContentEncoding::CE_DEFLATE: return "deflate";
+                default: return "";
+            }
+        }
+
+
+        bool ResponseCompression::compress(const std::string &_data, ContentEncoding _encoding, int _level, std::string &_compressedData)
+        {
+            bool ret = true;
+            _compressedData.clear();
+            _compressedData.reserve(_data.length() / 4);
+
+            ResponseCompressionStream compressionStream(_encoding, _level, [&_compressedData](const char* _compressed, std::size_t _length)
+            {
+                _compressedData.append(_compressed, _length);
+                return true;
+            });
+
+            ret = compressionStream.write(_data.c_str(), _data.length());
+            return compressionStream.finish() && ret;
+        }
+
+
+        ResponseCompressionStream::ResponseCompressionStream(ContentEncoding _encoding, int _level, JsonOutputStreamSink _sink, std::size_t _bufferSize)
+        {
+            sink = _sink;
+            buffer.resize(_bufferSize ? _bufferSize : 1);
+            initialized = false;
+            failed = false;
+
+            #ifdef USE_ZLIB
+                // the window bits tell zlib which header to write. 16 + 15 is a gzip header, 15 is a zlib header which is used for 'deflate'
+                std::memset(&stream, 0, sizeof(stream));
+                int windowBits = _encoding == ContentEncoding::CE_GZIP ? 16 + MAX_WBITS : MAX_WBITS;
+                initialized = deflateInit2(&stream, _level, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY) == Z_OK;
+            #endif
+
+            if (!initialized || _encoding == ContentEncoding::CE_NONE)
+                failed = true;
+        }
+
+
+        ResponseCompressionStream::~ResponseCompressionStream()
+        {
+            #ifdef USE_ZLIB
+                if (initialized)
+                    deflateEnd(&stream);
+            #endif
+        }
+
+
+        bool ResponseCompressionStream::write(const char* _data, std::size_t _length)
+        {
+            if (failed)
+                return false;
+
+            #ifdef USE_ZLIB
+                stream.next_in = (Bytef*)_data;
+                stream.avail_in = (uInt)_length;
+                failed = !deflateData(Z_NO_FLUSH);
+            #endif
+
+            return !failed;
+        }
+
+
+        bool ResponseCompressionStream::finish()
+        {
+            if (failed)
+                return false;
+
+            #ifdef USE_ZLIB
+                stream.next_in = nullptr;
+                stream.avail_in = 0;
+                failed = !deflateData(Z_FINISH);
+            #endif
+
+            return !failed;
+        }
+
+
+        #ifdef USE_ZLIB
+        bool ResponseCompressionStream::deflateData(int _flush)
+        {
+            int result;
+            do
+            {
+                stream.next_out = (Bytef*)buffer.data();
+                stream.avail_out = (uInt)buffer.size();
+
+                result = deflate(&stream, _flush);
+                if (result == Z_STREAM_ERROR)
+                    return false;
+
+                std::size_t compressedLength = buffer.size() - stream.avail_out;
+                if (compressedLength && !sink(buffer.data(), compressedLength))
+                    return false;
+            }
+            // if the output buffer was filled completely there may be more data left in zlib
+            while (stream.avail_out == 0 || (_flush == Z_FINISH && result != Z_STREAM_END));
+
+            return true;
+        }
+        #endif
+
+    }
+}
@@ -11,6 +11,11 @@ namespace Raumserver
             serverObject = nullptr;
             isStarted = false;
             docroot = DOCUMENT_ROOT;
+            threadCount = 50;
+            longPollThreadCount = 0;
+            keepAlive = true;
+            compressionLevel = 6;
+            compressionMinSize = 1024;
         }
 
 
@@ -20,11 +25,58 @@ namespace Raumserver
         }
 
 
+        std::atomic<Manager::MetricsManager*> Webserver::callbackMetricsManager(nullptr);
+
+
+        int Webserver::onBeginRequest(struct mg_connection *_conn)
+        {
+            auto metricsManager = callbackMetricsManager.load();
+            if (metricsManager)
+                metricsManager->beginHttpRequest();
+            // 0 lets the webserver process the request
+            return 0;
+        }
+
+
+        void Webserver::onEndRequest(const struct mg_connection *_conn, int _replyStatusCode)
+        {
+            auto metricsManager = callbackMetricsManager.load();
+            if (metricsManager)
+                metricsManager->endHttpRequest();
+        }
+
+
         void Webserver::setDocumentRoot(std::string _docroot)
         {
             docroot = _docroot;
         }
 
+
+
+        void Webserver::setThreadCount(std::uint32_t _threadCount)
+        {
+            threadCount = _threadCount;
+        }
+
+
+        void Webserver::setLongPollThreadCount(std::uint32_t _threadCount)
+        {
+            longPollThreadCount = _threadCount;
+        }
+
+
+        void Webserver::setKeepAlive(bool _keepAlive)
+        {
+            keepAlive = _keepAlive;
+        }
+
+
+        void Webserver::setCompression(std::int32_t _level, std::uint32_t _minSize)
+        {
+            compressionLevel = _level;
+            compressionMinSize = _minSize;
+        }
+
      
         void Webserver::start(std::uint32_t _port)
         {
@@ -46,13 +98,33 @@ namespace Raumserver
                 serverOptions.push_back("error_log_file");
                 serverOptions.push_back("error.log");
 
-                serverObject = std::shared_ptr<CivetServer>(new CivetServer(serverOptions));              
+                serverOptions.push_back("num_threads");
+                serverOptions.push_back(std::to_string(threadCount + longPollThreadCount));
+
+                serverOptions.push_back("enable_keep_alive");
+                serverOptions.push_back(keepAlive ? "yes" : "no");
+
+                // the header and the body of a response are written separately, without 'nodelay' the body would wait for the ack 
+                // of the header which would slow down each request on a kept alive connection by the delayed ack time of the client
+                serverOptions.push_back("tcp_nodelay");
+                serverOptions.push_back("1");
+
+                // the webserver threads are counted for the metrics. The callbacks are set for all requests, also for the files of the docroot
+                callbackMetricsManager = getManagerEngineerServer() ? getManagerEngineerServer()->getMetricsManager().get() : nullptr;
+                struct mg_callbacks serverCallbacks;
+                std::memset(&serverCallbacks, 0, sizeof(serverCallbacks));
+                serverCallbacks.begin_request = &Webserver::onBeginRequest;
+                serverCallbacks.end_request = &Webserver::onEndRequest;
+
+                serverObject = std::shared_ptr<CivetServer>(new CivetServer(serverOptions, &serverCallbacks));              
 
                 // add a general handler for the raumserver room and zone action handlings (like removing from zone or add to zone or room volumes, room mutes, aso...)
                 serverRequestHandlerController = std::shared_ptr<RequestHandlerController>(new RequestHandlerController());
                 serverRequestHandlerController->setManagerEngineerServer(getManagerEngineerServer());
                 serverRequestHandlerController->setManagerEngineerKernel(getManagerEngineer());
                 serverRequestHandlerController->setLogObject(getLogObject());
+                serverRequestHandlerController->setKeepAlive(keepAlive);
+                serverRequestHandlerController->setCompression(compressionLevel, compressionMinSize);
                 serverObject->addHandler("/raumserver/controller", serverRequestHandlerController.get());                
 
                 // add a general handler for fetching data 
@@ -60,8 +132,63 @@ namespace Raumserver
                 serverRequestHandlerData->setManagerEngineerServer(getManagerEngineerServer());
                 serverRequestHandlerData->setManagerEngineerKernel(getManagerEngineer());
                 serverRequestHandlerData->setLogObject(getLogObject());
+                serverRequestHandlerData->setKeepAlive(keepAlive);
+                serverRequestHandlerData->setCompression(compressionLevel, compressionMinSize);
                 serverObject->addHandler("/raumserver/data", serverRequestHandlerData.get());
 
+                // add a handler for executing several controller actions in one request
+                serverRequestHandlerBatch = std::shared_ptr<RequestHandlerBatch>(new RequestHandlerBatch());
+                serverRequestHandlerBatch->setManagerEngineerServer(getManagerEngineerServer());
+                serverRequestHandlerBatch->setManagerEngineerKernel(getManagerEngineer());
+                serverRequestHandlerBatch->setLogObject(getLogObject());
+                serverRequestHandlerBatch->setKeepAlive(keepAlive);
+                serverRequestHandlerBatch->setCompression(compressionLevel, compressionMinSize);
+                serverObject->addHandler("/raumserver/batch", serverRequestHandlerBatch.get());
+
+                // add a websocket handler where the clients can subscribe to data changes instead of long polling
+                serverRequestHandlerWebSocket = std::shared_ptr<RequestHandlerWebSocket>(new RequestHandlerWebSocket());
+                serverRequestHandlerWebSocket->setManagerEngineerServer(getManagerEngineerServer());
+                serverRequestHandlerWebSocket->setManagerEngineerKernel(getManagerEngineer());
+                serverRequestHandlerWebSocket->setLogObject(getLogObject());
+                serverRequestHandlerWebSocket->setKeepAlive(keepAlive);
+                serverRequestHandlerWebSocket->setCompression(compressionLevel, compressionMinSize);
+                serverObject->addWebSocketHandler("/raumserver/ws", serverRequestHandlerWebSocket.get());
+
+                // add a handler for the server sent events. The exact path will be taken before the '/raumserver/data' handler
+                serverRequestHandlerEvents = std::shared_ptr<RequestHandlerEvents>(new RequestHandlerEvents());
+                serverRequestHandlerEvents->setManagerEngineerServer(getManagerEngineerServer());
+                serverRequestHandlerEvents->setManagerEngineerKernel(getManagerEngineer());
+                serverRequestHandlerEvents->setLogObject(getLogObject());
+                serverRequestHandlerEvents->setKeepAlive(keepAlive);
+                serverRequestHandlerEvents->setCompression(compressionLevel, compressionMinSize);
+                serverObject->addHandler("/raumserver/data/events", serverRequestHandlerEvents.get());
+
+                // add a handler for the export of the recorded spans. The exact path will be taken before the '/raumserver/data' handler
+                serverRequestHandlerTrace = std::shared_ptr<RequestHandlerTrace>(new RequestHandlerTrace());
+                serverRequestHandlerTrace->setManagerEngineerServer(getManagerEngineerServer());
+                serverRequestHandlerTrace->setManagerEngineerKernel(getManagerEngineer());
+                serverRequestHandlerTrace->setLogObject(getLogObject());
+                serverRequestHandlerTrace->setKeepAlive(keepAlive);
+                serverRequestHandlerTrace->setCompression(compressionLevel, compressionMinSize);
+                serverObject->addHandler("/raumserver/data/trace", serverRequestHandlerTrace.get());
+
+                // add a handler for the statistics of the device and zone manager locks. The exact path will be taken before the '/raumserver/data' handler
+                serverRequestHandlerLockStatistics = std::shared_ptr<RequestHandlerLockStatistics>(new RequestHandlerLockStatistics());
+                serverRequestHandlerLockStatistics->setManagerEngineerServer(getManagerEngineerServer());
+                serverRequestHandlerLockStatistics->setManagerEngineerKernel(getManagerEngineer());
+                serverRequestHandlerLockStatistics->setLogObject(getLogObject());
+                serverRequestHandlerLockStatistics->setKeepAlive(keepAlive);
+                serverRequestHandlerLockStatistics->setCompression(compressionLevel, compressionMinSize);
+                serverObject->addHandler("/raumserver/data/lockStatistics", serverRequestHandlerLockStatistics.get());
+
+                // add a handler which provides the metrics of the server in the Prometheus text format
+                serverRequestHandlerMetrics = std::shared_ptr<RequestHandlerMetrics>(new RequestHandlerMetrics());
+                serverRequestHandlerMetrics->setManagerEngineerServer(getManagerEngineerServer());
+                serverRequestHandlerMetrics->setManagerEngineerKernel(getManagerEngineer());
+                serverRequestHandlerMetrics->setLogObject(getLogObject());
+                serverRequestHandlerMetrics->setKeepAlive(keepAlive);
+                serverRequestHandlerMetrics->setCompression(compressionLevel, compressionMinSize);
+                serverObject->addHandler("/raumserver/metrics", serverRequestHandlerMetrics.get());
                                                          
                 logInfo("Webserver for requests started (Port: " + std::to_string(_port) + ")", CURRENT_POSITION);
                 isStarted = true;
@@ -97,8 +224,15 @@ namespace Raumserver
 
         void Webserver::stop()
         {            
+            // the event streams are blocking webserver threads, so we have to end them before closing the server
+            if (serverRequestHandlerEvents)
+                serverRequestHandlerEvents->stop();
             if (serverObject && isStarted)
                 serverObject->close();
+            callbackMetricsManager = nullptr;
+            // the long poll manager must not call the websocket handler anymore
+            if (serverRequestHandlerWebSocket)
+                serverRequestHandlerWebSocket->unsubscribeAll();
         }
 
    
@@ -123,6 +257,27 @@ namespace Raumserver
             return managerEngineerKernel;
         }
 
+        RequestHandlerBase::RequestHandlerBase() : CivetHandler()
+        {
+            keepAlive = false;
+            compressionLevel = 0;
+            compressionMinSize = 0;
+        }
+
+
+        void RequestHandlerBase::setKeepAlive(bool _keepAlive)
+        {
+            keepAlive = _keepAlive;
+        }
+
+
+        void RequestHandlerBase::setCompression(std::int32_t _level, std::uint32_t _minSize)
+        {
+            compressionLevel = std::min(_level, 9);
+            compressionMinSize = _minSize;
+        }
+
+
         void RequestHandlerBase::setLogObject(std::shared_ptr<Raumkernel::Log::Log> _logObject)
         {
             logObject = _logObject;
@@ -137,8 +292,8 @@ namespace Raumserver
         std::string RequestHandlerBase::buildCorsHeader(std::map<std::string, std::string>* _headerVars)
         {
             std::string corsHeader = "Access-Control-Allow-Origin: *";  
-            std::string headerVarListInp = "sessionId,updateId";
-            std::string headerVarListExp = "sessionId,updateId";
+            std::string headerVarListInp = "sessionId,updateId,If-None-Match,Content-Type";
+            std::string headerVarListExp = "sessionId,updateId,ETag";
 
             if (_headerVars && _headerVars->size())
             {                
@@ -146,9 +301,9 @@ namespace Raumserver
                 //for (auto pair : *_headerVars)
                 {
                     headerVarListInp += "," +  it->first;
+                    headerVarListExp += "," + it->first;
                 }
                 //headerVarListInp.pop_back();
-                headerVarListExp = headerVarListInp;
             }
             else
             {
@@ -201,17 +356,102 @@ namespace Raumserver
             {
                 jsonWriter.Key("action");  jsonWriter.String("");
             }
+            // queued requests will return their id, so the client can get the status with 'getRequestStatus'
+            if (_reqAction != nullptr && _reqAction->getRequestId())
+            {
+                jsonWriter.Key("requestId");  jsonWriter.Uint64(_reqAction->getRequestId());
+            }
             jsonWriter.Key("msg");          jsonWriter.String(_string.c_str());
             jsonWriter.Key("error");        jsonWriter.Bool(_error);
             jsonWriter.EndObject();
 
             std::string reqReturn = jsonStringBuffer.GetString();
-            mg_printf(_conn, reqReturn.c_str());                        
+            sendHttpResponse(_conn, "200 OK", "Content-Type: text/html\r\n" + buildCorsHeader() + "\r\n", reqReturn);
+
+            if (_error)
+                addErrorMetrics();
+        }
+
+
+        void RequestHandlerBase::addErrorMetrics()
+        {
+            if (getManagerEngineerServer() && getManagerEngineerServer()->getMetricsManager())
+                getManagerEngineerServer()->getMetricsManager()->addHttpRequestError();
         }
 
 
-        void RequestHandlerBase::sendDataResponse(struct mg_connection *_conn, std::string _string, std::map<std::string, std::string> _headerVars, bool _error, Request::RequestAction * _reqAction)
+        void RequestHandlerBase::sendDataResponse(struct mg_connection *_conn, const std::string &_string, std::map<std::string, std::string> _headerVars, bool _error, Request::RequestAction * _reqAction, const std::string &_contentEncoding)
         {       
+            sendHttpResponse(_conn, "200 OK", buildDataResponseHeader(_headerVars, _error, _contentEncoding), _string);
+
+            if (_error)
+                addErrorMetrics();
+        }
+
+
+        void RequestHandlerBase::sendReturnableDataResponse(struct mg_connection *_conn, std::shared_ptr<Request::RequestActionReturnable> _requestAction, ContentEncoding _encoding)
+        {
+            auto data = _requestAction->getResponseDataBuffer();
+            std::string contentEncoding = "";
+
+            // small responses are not worth the compression
+            if (_encoding != ContentEncoding::CE_NONE && data->length() >= compressionMinSize)
+            {
+                auto encodedData = getEncodedResponseData(_requestAction, data, _encoding);
+                if (encodedData)
+                {
+                    data = encodedData;
+                    contentEncoding = ResponseCompression::contentEncodingToString(_encoding);
+                }
+            }
+
+            sendDataResponse(_conn, *data, _requestAction->getResponseHeader(), false, _requestAction.get(), contentEncoding);
+        }
+
+
+        ContentEncoding RequestHandlerBase::getResponseEncoding(struct mg_connection *_conn)
+        {
+            if (compressionLevel <= 0)
+                return ContentEncoding::CE_NONE;
+            return ResponseCompression::getAcceptedEncoding(mg_get_header(_conn, "Accept-Encoding"));
+        }
+
+
+        std::shared_ptr<const std::string> RequestHandlerBase::getEncodedResponseData(std::shared_ptr<Request::RequestActionReturnable> _requestAction, std::shared_ptr<const std::string> _data, ContentEncoding _encoding)
+        {
+            std::shared_ptr<const std::string> encodedData = nullptr;
+            std::string compressedData;
+            std::string cacheKey = "";
+            auto encoding = ResponseCompression::contentEncodingToString(_encoding);
+            auto responseCacheManager = getManagerEngineerServer()->getResponseCacheManager();
+
+            // the data of long polling requests may be shared with other requests by the response cache, so the compressed data will be shared too
+            auto requestActionLongPolling = std::dynamic_pointer_cast<Request::RequestActionReturnableLongPolling>(_requestAction);
+            if (requestActionLongPolling)
+                cacheKey = requestActionLongPolling->getResponseCacheKey();
+
+            if (!cacheKey.empty() && !responseCacheManager->acquireEncodedResponse(cacheKey, _data, encoding, encodedData))
+                return encodedData;
+
+            bool compressed = false;
+            {
+                Manager::TraceSpan traceSpan("compress", "response", _requestAction->getRequestId(), _requestAction->getActionType());
+                compressed = ResponseCompression::compress(*_data, _encoding, compressionLevel, compressedData);
+            }
+            if (compressed)
+                encodedData = std::make_shared<const std::string>(std::move(compressedData));
+            else
+                getLogObject()->error("Compression of response failed!", CURRENT_POSITION);
+
+            if (!cacheKey.empty())
+                responseCacheManager->releaseEncodedResponse(cacheKey, _data, encoding, encodedData);
+
+            return encodedData;
+        }
+
+
+        std::string RequestHandlerBase::buildDataResponseHeader(std::map<std::string, std::string> &_headerVars, bool _error, const std::string &_contentEncoding)
+        {
             // create header string
             std::string headers = "";
             for (auto pair : _headerVars)
@@ -219,12 +459,221 @@ namespace Raumserver
                 headers += pair.first + ":" + pair.second + "\r\n";
             }
 
-            mg_printf(_conn, std::string("HTTP/1.1 200 OK\r\nContent-Type: text/html\r\n" + buildCorsHeader(&_headerVars) + "\r\n" + headers + "Connection: close\r\n\r\n").c_str());
-            mg_printf(_conn, _string.c_str());         
+            // the update id of the data is the ETag, so clients which do not use long polling can revalidate their data
+            // with 'If-None-Match' and will get a '304 Not Modified' if nothing has changed
+            auto updateIdIt = _headerVars.find("updateId");
+            if (!_error && updateIdIt != _headerVars.end() && !updateIdIt->second.empty())
+                headers += "ETag: " + buildETag(updateIdIt->second) + "\r\n";
+            headers += "Cache-Control: no-cache\r\n";
+
+            // the data may be sent compressed or not, depending on the 'Accept-Encoding' header of the request
+            if (!_contentEncoding.empty())
+                headers += "Content-Encoding: " + _contentEncoding + "\r\n";
+            if (compressionLevel > 0)
+                headers += "Vary: Accept-Encoding\r\n";
+
+            return "Content-Type: text/html\r\n" + buildCorsHeader(&_headerVars) + "\r\n" + headers;
+        }
+
+
+        bool RequestHandlerBase::isChunkedResponseAllowed(struct mg_connection *_conn)
+        {
+            const struct mg_request_info *request_info = mg_get_request_info(_conn);
+            return request_info->http_version && std::string(request_info->http_version) == "1.1";
+        }
+
+
+        void RequestHandlerBase::sendChunkedResponseBegin(struct mg_connection *_conn, std::map<std::string, std::string> _headerVars, const std::string &_contentEncoding)
+        {
+            std::string header = "HTTP/1.1 200 OK\r\n" + buildDataResponseHeader(_headerVars, false, _contentEncoding) + "Transfer-Encoding: chunked\r\n";
+            header += isKeepAliveConnection(_conn) ? "Connection: keep-alive\r\n\r\n" : "Connection: close\r\n\r\n";
+            mg_write(_conn, header.c_str(), header.length());
+        }
+
+
+        bool RequestHandlerBase::sendChunk(struct mg_connection *_conn, const char* _data, std::size_t _length)
+        {
+            // a chunk with a length of 0 would end the response
+            if (!_length)
+                return true;
+
+            char chunkHeader[32];
+            int chunkHeaderLength = snprintf(chunkHeader, sizeof(chunkHeader), "%lx\r\n", (unsigned long)_length);
+            if (mg_write(_conn, chunkHeader, chunkHeaderLength) <= 0)
+                return false;
+            if (mg_write(_conn, _data, _length) <= 0)
+                return false;
+            return mg_write(_conn, "\r\n", 2) > 0;
+        }
+
+
+        void RequestHandlerBase::sendChunkedResponseEnd(struct mg_connection *_conn)
+        {
+            mg_write(_conn, "0\r\n\r\n", 5);
+        }
+
+
+        bool RequestHandlerBase::isKeepAliveConnection(struct mg_connection *_conn)
+        {
+            if (!keepAlive)
+                return false;
+
+            // this is the same check the webserver does before it waits for the next request on the connection
+            const struct mg_request_info *request_info = mg_get_request_info(_conn);
+            // a request body without 'Content-Length' (eg. a chunked POST) can't be skipped, so the webserver will close the connection
+            if (request_info->content_length < 0 && request_info->request_method)
+            {
+                std::string method = request_info->request_method;
+                if (method == "POST" || method == "PUT" || mg_get_header(_conn, "Transfer-Encoding"))
+                    return false;
+            }
+            const char* connectionHeader = mg_get_header(_conn, "Connection");
+            if (connectionHeader)
+                return Raumkernel::Tools::StringUtil::tolower(connectionHeader) == "keep-alive";
+            return request_info->http_version && std::string(request_info->http_version) == "1.1";
+        }
+
+
+        void RequestHandlerBase::sendPreflightResponse(struct mg_connection *_conn)
+        {
+            sendHttpResponse(_conn, "200 OK", buildCorsHeader() + "\r\nAccess-Control-Allow-Methods: GET, POST, OPTIONS\r\n", "");
+        }
+
+
+        bool RequestHandlerBase::readRequestBody(struct mg_connection *_conn, std::string &_body, std::size_t _maxSize)
+        {
+            const struct mg_request_info *request_info = mg_get_request_info(_conn);
+            char buffer[4096];
+            int readLength;
+
+            if (request_info->content_length > 0 && (std::uint64_t)request_info->content_length > _maxSize)
+                return false;
+            if (request_info->content_length > 0)
+                _body.reserve((std::size_t)request_info->content_length);
+
+            // without a content length (eg. chunked requests) the body will be read till the end of the data
+            while ((readLength = mg_read(_conn, buffer, sizeof(buffer))) > 0)
+            {
+                if (_body.length() + readLength > _maxSize)
+                    return false;
+                _body.append(buffer, readLength);
+            }
+
+            return readLength == 0;
+        }
+
+
+        void RequestHandlerBase::sendHttpResponse(struct mg_connection *_conn, const std::string &_status, const std::string &_headers, const std::string &_body)
+        {
+            std::string header = "HTTP/1.1 " + _status + "\r\n" + _headers;
+            header += "Content-Length: " + std::to_string(_body.length()) + "\r\n";
+            header += isKeepAliveConnection(_conn) ? "Connection: keep-alive\r\n\r\n" : "Connection: close\r\n\r\n";
+
+            // the body is written directly from the buffer of the response, so it does not have to be copied or formatted
+            Manager::TraceSpan traceSpan("write", "response");
+            mg_write(_conn, header.c_str(), header.length());
+            if (!_body.empty())
+                mg_write(_conn, _body.c_str(), _body.length());
+        }
+
+
+        void RequestHandlerBase::sendNotModifiedResponse(struct mg_connection *_conn, const std::string &_eTag)
+        {
+            std::string header = "HTTP/1.1 304 Not Modified\r\nETag: " + _eTag + "\r\nCache-Control: no-cache\r\n" + buildCorsHeader() + "\r\n";
+            header += isKeepAliveConnection(_conn) ? "Connection: keep-alive\r\n\r\n" : "Connection: close\r\n\r\n";
+            mg_write(_conn, header.c_str(), header.length());
+        }
+
+
+        std::string RequestHandlerBase::buildETag(const std::string &_updateId)
+        {
+            return "\"" + _updateId + "\"";
+        }
+
+
+        bool RequestHandlerBase::isETagMatching(struct mg_connection *_conn, const std::string &_eTag)
+        {
+            const char* ifNoneMatch = mg_get_header(_conn, "If-None-Match");
+            if (!ifNoneMatch)
+                return false;
+
+            // the header may contain a list of ETags which may be weak ones (W/"...")
+            auto eTags = Raumkernel::Tools::StringUtil::explodeString(ifNoneMatch, ",");
+            for (auto eTag : eTags)
+            {
+                auto start = eTag.find_first_not_of(" \t");
+                auto end = eTag.find_last_not_of(" \t");
+                eTag = start == std::string::npos ? "" : eTag.substr(start, end - start + 1);
+                if (eTag.compare(0, 2, "W/") == 0)
+                    eTag = eTag.substr(2);
+                if (eTag == _eTag || eTag == "*")
+                    return true;
+            }
+            return false;
+        }
+
+
+        std::shared_ptr<Request::RequestActionReturnableLongPolling> RequestHandlerBase::createRequestActionForTopic(const std::string &_topic)
+        {
+            std::string actionName = _topic, id = "", query = "";
+
+            // the id of the topic may contain ':' too (eg. zone UDN's), so we only split on the first one
+            auto pos = _topic.find(":");
+            if (pos != std::string::npos)
+            {
+                actionName = _topic.substr(0, pos);
+                id = _topic.substr(pos + 1);
+            }
+            actionName = Raumkernel::Tools::StringUtil::tolower(actionName);
+
+            if (!id.empty())
+                query = "id=" + Raumkernel::Tools::UriUtil::encodeValue(id);
+
+            std::shared_ptr<Request::RequestAction> requestAction;
+            if (actionName == "rendererstate")
+                requestAction = Request::RequestAction::createFromPath("/raumserver/data/getRendererState", query);
+            else if (actionName == "zoneconfig")
+                requestAction = Request::RequestAction::createFromPath("/raumserver/data/getZoneConfig", query);
+            else if (actionName == "zonemedialist")
+                requestAction = Request::RequestAction::createFromPath("/raumserver/data/getZoneMediaList", query);
+
+            auto requestActionLongPolling = std::dynamic_pointer_cast<Request::RequestActionReturnableLongPolling>(requestAction);
+            if (!requestActionLongPolling)
+                return nullptr;
+
+            requestActionLongPolling->setManagerEngineer(getManagerEngineerKernel());
+            requestActionLongPolling->setManagerEngineerServer(getManagerEngineerServer());
+            requestActionLongPolling->setLogObject(getLogObject());
+
+            // validating will parse the query options into the option map of the request
+            if (!requestActionLongPolling->isValid())
+                return nullptr;
+
+            return requestActionLongPolling;
         }
 
 
         bool RequestHandlerController::handleGet(CivetServer *_server, struct mg_connection *_conn)
+        {
+            return handleRequest(_server, _conn, "");
+        }
+
+
+        bool RequestHandlerController::handlePost(CivetServer *_server, struct mg_connection *_conn)
+        {
+            std::string body;
+
+            if (!readRequestBody(_conn, body))
+            {
+                sendResponse(_conn, "Request body could not be read or is too big!", true);
+                return true;
+            }
+
+            return handleRequest(_server, _conn, std::move(body));
+        }
+
+
+        bool RequestHandlerController::handleRequest(CivetServer *_server, struct mg_connection *_conn, std::string _jsonOptions)
         {
             // Check if system is online, otherwise don't execute!
             if (!getManagerEngineerServer() || !getManagerEngineerServer()->isSystemReady())
@@ -235,8 +684,14 @@ namespace Raumserver
 
             const struct mg_request_info *request_info = mg_get_request_info(_conn);   
 
+            // the path and the query are copied to buffers of the http thread which keep their capacity, the request action 
+            // copies them into its own arena, so there is no allocation for them after the first requests of the thread
+            static thread_local std::string requestPath, requestQuery;
+            requestPath.assign(request_info->request_uri);
+            requestQuery.assign(request_info->query_string == nullptr ? "" : request_info->query_string);
+
             // create request action object from url given from the connection
-            std::shared_ptr<Request::RequestAction> requestAction = Request::RequestAction::createFromPath(request_info->request_uri, request_info->query_string == nullptr ? "" : request_info->query_string);
+            std::shared_ptr<Request::RequestAction> requestAction = Request::RequestAction::createFromPath(requestPath, requestQuery);
 
             // if there is no reuquest action the path is wrong or not existent!
             if (!requestAction)
@@ -249,11 +704,24 @@ namespace Raumserver
             requestAction->setManagerEngineerServer(getManagerEngineerServer());
             requestAction->setLogObject(getLogObject());
 
+            // the options may be posted as json object instead of the query, so long values (eg. the uri for 'loadUri') or multiple rooms
+            // do not have to be escaped. An empty body will be handled like a request without a body
+            if (!_jsonOptions.empty() && !requestAction->setOptionsFromJson(std::move(_jsonOptions)))
+            {
+                sendResponse(_conn, "Invalid json options! Please post a json object like {\"id\":\"Kitchen\",\"value\":30}", true, requestAction.get());
+                return true;
+            }
+
             // if we should stack the request we have to add it to the request manager and return the error values of the validate if there are some
             // the Reuest-Manager will take care of the Request from now on
             if (requestAction->isStackable())
             {
-                if (requestAction->isValid())
+                bool isValid = false;
+                {
+                    Manager::TraceSpan traceSpan("validate", "request", 0, requestAction->getActionType());
+                    isValid = requestAction->isValid();
+                }
+                if (isValid)
                 {
                     getManagerEngineerServer()->getRequestActionManager()->addRequestAction(requestAction);                    
                     sendResponse(_conn, "Request '" + std::string(request_info->request_uri) + "' was added to queue!", false, requestAction.get());
@@ -270,10 +738,66 @@ namespace Raumserver
                 // a returnable request ist always a sync and non stackable request
                 if (std::dynamic_pointer_cast<Request::RequestActionReturnable>(requestAction))
                 {
-                    if (requestAction->execute())
+                    // clients which do not use long polling may already have the data of the current update id. They will get a
+                    // '304 Not Modified' and we don't have to build the data at all
+                    auto requestActionLongPolling = std::dynamic_pointer_cast<Request::RequestActionReturnableLongPolling>(requestAction);
+                    if (requestActionLongPolling && mg_get_header(_conn, "If-None-Match") && requestActionLongPolling->isValid() && !requestActionLongPolling->isLongPolling())
+                    {
+                        auto lastUpdateId = requestActionLongPolling->getLastUpdateId();
+                        if (!lastUpdateId.empty() && isETagMatching(_conn, buildETag(lastUpdateId)))
+                        {
+                            sendNotModifiedResponse(_conn, buildETag(lastUpdateId));
+                            return true;
+                        }
+                    }
+
+                    auto requestActionReturnable = std::dynamic_pointer_cast<Request::RequestActionReturnable>(requestAction);
+
+                    // big responses (eg. media lists) will be written in chunks while they are built, so they are never in memory as a whole
+                    // the header will be sent with the first chunk, till then the request may fail and we can send an error response
+                    // if the client accepts it the chunks will be compressed while they are written
+                    auto contentEncoding = getResponseEncoding(_conn);
+                    std::shared_ptr<ResponseCompressionStream> compressionStream = nullptr;
+                    bool chunkedResponseStarted = false;
+                    if (requestActionReturnable->isResponseStreamable() && isChunkedResponseAllowed(_conn))
+                    {
+                        auto requestActionReturnablePtr = requestActionReturnable.get();
+                        JsonOutputStreamSink chunkSink = [this, _conn, requestActionReturnablePtr, contentEncoding, &chunkedResponseStarted](const char* _data, std::size_t _length)
+                        {
+                            if (!chunkedResponseStarted)
+                            {
+                                sendChunkedResponseBegin(_conn, requestActionReturnablePtr->getResponseHeader(), ResponseCompression::contentEncodingToString(contentEncoding));
+                                chunkedResponseStarted = true;
+                            }
+                            return sendChunk(_conn, _data, _length);
+                        };
+
+                        if (contentEncoding != ContentEncoding::CE_NONE)
+                        {
+                            compressionStream = std::shared_ptr<ResponseCompressionStream>(new ResponseCompressionStream(contentEncoding, compressionLevel, chunkSink));
+                            requestActionReturnable->setResponseStreamSink([compressionStream](const char* _data, std::size_t _length) { return compressionStream->write(_data, _length); });
+                        }
+                        else
+                        {
+                            requestActionReturnable->setResponseStreamSink(chunkSink);
+                        }
+                    }
+
+                    bool executed = requestAction->execute();
+                    requestActionReturnable->setResponseStreamSink(nullptr);
+
+                    // the compression stream may still hold data (or all of it if the response was small)
+                    if (compressionStream && requestActionReturnable->isResponseStreamed() && (executed || chunkedResponseStarted))
+                        compressionStream->finish();
+
+                    // if the response was already started we can't send an error anymore. The client will get an incomplete json in this case
+                    if (chunkedResponseStarted)
                     {
-                        auto requestActionReturnable = std::dynamic_pointer_cast<Request::RequestActionReturnable>(requestAction);
-                        sendDataResponse(_conn, requestActionReturnable->getResponseData(), requestActionReturnable->getResponseHeader(), false, requestAction.get());
+                        sendChunkedResponseEnd(_conn);
+                    }
+                    else if (executed)
+                    {
+                        sendReturnableDataResponse(_conn, requestActionReturnable, contentEncoding);
                     }
                     else
                     {
@@ -295,6 +819,12 @@ namespace Raumserver
 
         bool RequestHandlerController::handleOptions(CivetServer *_server, struct mg_connection *_conn)
         {
+            // browsers will ask before they post json options. This must not execute the request
+            if (mg_get_header(_conn, "Access-Control-Request-Method"))
+            {
+                sendPreflightResponse(_conn);
+                return true;
+            }
             return handleGet(_server, _conn);
         }
 
@@ -305,10 +835,902 @@ namespace Raumserver
         }
 
 
+        bool RequestHandlerData::handlePost(CivetServer *_server, struct mg_connection *_conn)
+        {
+            return RequestHandlerController::handlePost(_server, _conn);
+        }
+
+
         bool RequestHandlerData::handleOptions(CivetServer *_server, struct mg_connection *_conn)
         {
             return RequestHandlerController::handleOptions(_server, _conn);
         }
-   
+
+
+        bool RequestHandlerBatch::handlePost(CivetServer *_server, struct mg_connection *_conn)
+        {
+            // Check if system is online, otherwise don't execute!
+            if (!getManagerEngineerServer() || !getManagerEngineerServer()->isSystemReady())
+            {
+                sendResponse(_conn, "Raumfeld System is not ready to receive requests!", true);
+                return true;
+            }
+
+            const struct mg_request_info *request_info = mg_get_request_info(_conn);
+            std::string body;
+
+            if (!readRequestBody(_conn, body))
+            {
+                sendResponse(_conn, "Request body could not be read or is too big!", true);
+                return true;
+            }
+
+            auto queryOptions = Raumkernel::Tools::UriUtil::parseQueryString(request_info->query_string == nullptr ? "" : request_info->query_string);
+            auto stopOnError = Raumkernel::Tools::StringUtil::tolower(queryOptions["stoponerror"]);
+
+            Request::RequestActionBatch batch;
+            batch.setManagerEngineer(getManagerEngineerKernel());
+            batch.setManagerEngineerServer(getManagerEngineerServer());
+            batch.setLogObject(getLogObject());
+            batch.setMode(Request::RequestActionBatch::stringToMode(queryOptions["mode"]));
+            batch.setStopOnError(stopOnError == "true" || stopOnError == "1");
+
+            if (!batch.addItemsFromJson(body))
+            {
+                sendResponse(_conn, "Invalid batch! Please post a json array like [{\"action\":\"play\",\"options\":{\"id\":\"Kitchen\"}}]", true);
+                return true;
+            }
+
+            bool success = batch.execute();
+            sendDataResponse(_conn, batch.getResultJson(), std::map<std::string, std::string>(), !success);
+
+            return true;
+        }
+
+
+        bool RequestHandlerBatch::handleOptions(CivetServer *_server, struct mg_connection *_conn)
+        {
+            // browsers will ask if they may post the json before they do it
+            sendPreflightResponse(_conn);
+            return true;
+        }
+
+
+        bool RequestHandlerMetrics::handleGet(CivetServer *_server, struct mg_connection *_conn)
+        {
+            if (!getManagerEngineerServer() || !getManagerEngineerServer()->getMetricsManager())
+            {
+                sendResponse(_conn, "Metrics are not available!", true);
+                return true;
+            }
+
+            // the metrics do not need the Raumfeld system, so they can be scraped while the system is not ready
+            sendHttpResponse(_conn, "200 OK", "Content-Type: text/plain; version=0.0.4\r\nCache-Control: no-cache\r\n", getManagerEngineerServer()->getMetricsManager()->getMetricsText());
+            return true;
+        }
+
+
+        bool RequestHandlerTrace::handleGet(CivetServer *_server, struct mg_connection *_conn)
+        {
+            if (!Manager::TraceManager::isEnabled() || !getManagerEngineerServer() || !getManagerEngineerServer()->getTraceManager())
+            {
+                sendResponse(_conn, "Tracing is disabled! Please enable it with 'Tracing' in the settings", true);
+                return true;
+            }
+
+            // the spans of the last 'seconds' (default 10) will be returned. The json can be opened with Perfetto or chrome://tracing
+            const struct mg_request_info *request_info = mg_get_request_info(_conn);
+            auto queryOptions = Raumkernel::Tools::UriUtil::parseQueryString(request_info->query_string == nullptr ? "" : request_info->query_string);
+            std::uint32_t seconds = queryOptions["seconds"].empty() ? 10 : (std::uint32_t)std::strtoul(queryOptions["seconds"].c_str(), nullptr, 10);
+
+            std::map<std::string, std::string> headerVars;
+            headerVars["Content-Disposition"] = "inline; filename=\"raumserver-trace.json\"";
+            sendDataResponse(_conn, getManagerEngineerServer()->getTraceManager()->getTraceJson(seconds), headerVars);
+            return true;
+        }
+
+
+        bool RequestHandlerLockStatistics::handleGet(CivetServer *_server, struct mg_connection *_conn)
+        {
+            if (!getManagerEngineerServer() || !getManagerEngineerServer()->getLockStatisticsManager())
+            {
+                sendResponse(_conn, "Lock statistics are not available!", true);
+                return true;
+            }
+
+            // the statistics will be returned before they are reset, so a client can take the values of an interval with 'reset=true'
+            const struct mg_request_info *request_info = mg_get_request_info(_conn);
+            auto queryOptions = Raumkernel::Tools::UriUtil::parseQueryString(request_info->query_string == nullptr ? "" : request_info->query_string);
+            auto lockStatisticsManager = getManagerEngineerServer()->getLockStatisticsManager();
+            auto json = lockStatisticsManager->getStatisticsJson();
+            if (queryOptions["reset"] == "true" || queryOptions["reset"] == "1")
+                lockStatisticsManager->reset();
+
+            sendDataResponse(_conn, json);
+            return true;
+        }
+
+
+        WebSocketSender::WebSocketSender(struct mg_connection *_conn, WebSocketSenderPool *_senderPool)
+        {
+            conn = _conn;
+            senderPool = _senderPool;
+            stopSender = false;
+            scheduled = false;
+            writing = false;
+        }
+
+
+        WebSocketSender::~WebSocketSender()
+        {
+            stop();
+        }
+
+
+        const struct mg_connection* WebSocketSender::getConnection()
+        {
+            return conn;
+        }
+
+
+        void WebSocketSender::queueFrame(const std::string &_topic, std::shared_ptr<const std::string> _frame)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutexFrames);
+                if (stopSender)
+                    return;
+
+                // a client which is slower than the changes only needs the newest data of a topic
+                if (!_topic.empty())
+                {
+                    for (auto &frame : frames)
+                    {
+                        if (frame.first == _topic)
+                        {
+                            frame.second = _frame;
+                            return;
+                        }
+                    }
+                }
+
+                frames.push_back(std::make_pair(_topic, _frame));
+                // a sender which is already scheduled will write the frame when it's its turn again
+                if (scheduled)
+                    return;
+                scheduled = true;
+            }
+
+            senderPool->schedule(shared_from_this());
+        }
+
+
+        void WebSocketSender::stop()
+        {
+            std::unique_lock<std::mutex> lock(mutexFrames);
+            stopSender = true;
+            frames.clear();
+            condFrames.wait(lock, [this] { return !writing; });
+        }
+
+
+        bool WebSocketSender::writeNextFrame()
+        {
+            std::unique_lock<std::mutex> lock(mutexFrames);
+            if (stopSender || frames.empty())
+            {
+                scheduled = false;
+                return false;
+            }
+
+            auto frame = frames.front().second;
+            frames.pop_front();
+            writing = true;
+
+            // the frame is written without holding the lock, so the long poll manager can queue new frames while the client is slow
+            lock.unlock();
+            mg_websocket_write(conn, WEBSOCKET_OPCODE_TEXT, frame->c_str(), frame->length());
+            lock.lock();
+
+            writing = false;
+            condFrames.notify_all();
+            if (stopSender || frames.empty())
+            {
+                scheduled = false;
+                return false;
+            }
+            return true;
+        }
+
+
+        WebSocketSenderPool::WebSocketSenderPool()
+        {
+            stopThreads = false;
+        }
+
+
+        WebSocketSenderPool::~WebSocketSenderPool()
+        {
+            stop();
+        }
+
+
+        void WebSocketSenderPool::start(std::uint32_t _threadCount)
+        {
+            std::unique_lock<std::mutex> lock(mutexSenders);
+            if (!senderThreadObjects.empty())
+                return;
+            stopThreads = false;
+            for (std::uint32_t i = 0; i < _threadCount; i++)
+                senderThreadObjects.push_back(std::thread(&WebSocketSenderPool::senderThread, this));
+        }
+
+
+        void WebSocketSenderPool::stop()
+        {
+            std::vector<std::thread> threadObjects;
+            {
+                std::unique_lock<std::mutex> lock(mutexSenders);
+                stopThreads = true;
+                threadObjects.swap(senderThreadObjects);
+            }
+            condSenders.notify_all();
+
+            for (auto &threadObject : threadObjects)
+            {
+                if (threadObject.joinable())
+                    threadObject.join();
+            }
+
+            std::unique_lock<std::mutex> lock(mutexSenders);
+            scheduledSenders.clear();
+        }
+
+
+        void WebSocketSenderPool::schedule(std::shared_ptr<WebSocketSender> _sender)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutexSenders);
+                if (stopThreads)
+                    return;
+                scheduledSenders.push_back(_sender);
+            }
+            condSenders.notify_one();
+        }
+
+
+        void WebSocketSenderPool::senderThread()
+        {
+            std::unique_lock<std::mutex> lock(mutexSenders);
+            while (true)
+            {
+                condSenders.wait(lock, [this] { return stopThreads || !scheduledSenders.empty(); });
+                if (stopThreads)
+                    break;
+
+                auto sender = scheduledSenders.front();
+                scheduledSenders.pop_front();
+
+                lock.unlock();
+                bool moreFrames = sender->writeNextFrame();
+                lock.lock();
+
+                // the sender goes to the end of the queue, so each client gets its turn
+                if (moreFrames && !stopThreads)
+                    scheduledSenders.push_back(sender);
+            }
+        }
+
+
+        RequestHandlerWebSocket::RequestHandlerWebSocket() : RequestHandlerBase(), CivetWebSocketHandler()
+        {
+            senderPool.start(WEBSOCKET_SENDER_THREADS);
+        }
+
+
+        bool RequestHandlerWebSocket::handleConnection(CivetServer *_server, const struct mg_connection *_conn)
+        {
+            return true;
+        }
+
+
+        void RequestHandlerWebSocket::handleReadyState(CivetServer *_server, struct mg_connection *_conn)
+        {
+            getSender(_conn);
+        }
+
+
+        bool RequestHandlerWebSocket::handleData(CivetServer *_server, struct mg_connection *_conn, int _bits, char *_data, size_t _dataLen)
+        {
+            auto opCode = _bits & 0x0f;
+
+            if (opCode == WEBSOCKET_OPCODE_CONNECTION_CLOSE)
+                return false;
+            if (opCode != WEBSOCKET_OPCODE_TEXT)
+                return true;
+
+            // the clients will send json objects like {"subscribe":["rendererState:Wohnzimmer","zoneConfig"]} or {"unsubscribe":["zoneConfig"]}
+            rapidjson::Document document;
+            document.Parse(_data, _dataLen);
+
+            if (document.HasParseError() || !document.IsObject())
+            {
+                sendError(_conn, "Invalid message! Please send a json object with 'subscribe' or 'unsubscribe' topics");
+                return true;
+            }
+
+            if (!getManagerEngineerServer() || !getManagerEngineerServer()->isSystemReady())
+            {
+                sendError(_conn, "Raumfeld System is not ready to receive requests!");
+                return true;
+            }
+
+            if (document.HasMember("subscribe") && document["subscribe"].IsArray())
+            {
+                for (auto it = document["subscribe"].Begin(); it != document["subscribe"].End(); it++)
+                {
+                    if (it->IsString())
+                        subscribeTopic(_conn, it->GetString());
+                }
+            }
+
+            if (document.HasMember("unsubscribe") && document["unsubscribe"].IsArray())
+            {
+                for (auto it = document["unsubscribe"].Begin(); it != document["unsubscribe"].End(); it++)
+                {
+                    if (it->IsString())
+                        unsubscribeTopic(_conn, it->GetString());
+                }
+            }
+
+            return true;
+        }
+
+
+        void RequestHandlerWebSocket::handleClose(CivetServer *_server, const struct mg_connection *_conn)
+        {
+            std::vector<std::string> subscribedTopics;
+            std::shared_ptr<WebSocketSender> sender;
+            
+            {
+                std::unique_lock<std::mutex> lock(mutexTopics);
+                for (auto &pair : topics)
+                {
+                    for (auto &topicSender : pair.second.senders)
+                    {
+                        if (topicSender->getConnection() == _conn)
+                            subscribedTopics.push_back(pair.first);
+                    }
+                }
+
+                auto it = senders.find(_conn);
+                if (it != senders.end())
+                {
+                    sender = it->second;
+                    senders.erase(it);
+                }
+            }
+
+            for (auto topic : subscribedTopics)
+                unsubscribeTopic(_conn, topic);
+
+            // the connection will be reused by the webserver after we return, so the sender must not write to it anymore
+            if (sender)
+                sender->stop();
+        }
+
+
+        void RequestHandlerWebSocket::unsubscribeAll()
+        {
+            std::vector<std::uint64_t> subscriptionIds;
+            std::vector<std::shared_ptr<WebSocketSender>> allSenders;
+
+            {
+                std::unique_lock<std::mutex> lock(mutexTopics);
+                for (auto &pair : topics)
+                    subscriptionIds.push_back(pair.second.subscriptionId);
+                topics.clear();
+                for (auto &pair : senders)
+                    allSenders.push_back(pair.second);
+                senders.clear();
+            }
+
+            for (auto subscriptionId : subscriptionIds)
+                getManagerEngineerServer()->getLongPollManager()->unsubscribe(subscriptionId);
+
+            for (auto sender : allSenders)
+                sender->stop();
+
+            senderPool.stop();
+        }
+
+
+        std::shared_ptr<WebSocketSender> RequestHandlerWebSocket::getSender(struct mg_connection *_conn)
+        {
+            std::unique_lock<std::mutex> lock(mutexTopics);
+            auto it = senders.find(_conn);
+            if (it != senders.end())
+                return it->second;
+
+            auto sender = std::make_shared<WebSocketSender>(_conn, &senderPool);
+            senders.insert(std::make_pair(_conn, sender));
+            return sender;
+        }
+
+
+        void RequestHandlerWebSocket::subscribeTopic(struct mg_connection *_conn, const std::string &_topic)
+        {
+            auto sender = getSender(_conn);
+            std::shared_ptr<const std::string> frame;
+
+            {
+                std::unique_lock<std::mutex> lock(mutexTopics);
+
+                auto it = topics.find(_topic);
+                if (it != topics.end())
+                {
+                    if (std::find(it->second.senders.begin(), it->second.senders.end(), sender) == it->second.senders.end())
+                        it->second.senders.push_back(sender);
+                    sender->queueFrame(_topic, it->second.lastFrame);
+                    return;
+                }
+            }
+
+            auto requestAction = createRequestActionForTopic(_topic);
+            if (!requestAction)
+            {
+                sendError(_conn, "Topic '" + _topic + "' is not valid!");
+                return;
+            }
+
+            // the first data is created without holding the topic lock because the request action will lock the device and zone manager
+            auto lastUpdateId = requestAction->getLastUpdateId();
+            if (!requestAction->executeActionLongPolling())
+            {
+                sendError(_conn, "Error while subscribing to topic '" + _topic + "': " + requestAction->getErrors());
+                return;
+            }
+            frame = buildTopicFrame(_topic, lastUpdateId, requestAction->getResponseData());
+
+            std::unique_lock<std::mutex> lock(mutexTopics);
+
+            // another client may have subscribed to the topic in the meantime, then we will use its topic and drop our request action
+            auto it = topics.find(_topic);
+            if (it != topics.end())
+            {
+                if (std::find(it->second.senders.begin(), it->second.senders.end(), sender) == it->second.senders.end())
+                    it->second.senders.push_back(sender);
+                sender->queueFrame(_topic, it->second.lastFrame);
+                return;
+            }
+
+            WebSocketTopic topic;
+            topic.requestAction = requestAction;
+            topic.lastFrame = frame;
+            topic.senders.push_back(sender);
+            // the long poll manager does not call the callback while subscribing, so we can do this while holding the topic lock
+            topic.subscriptionId = getManagerEngineerServer()->getLongPollManager()->subscribe(requestAction, lastUpdateId, std::bind(&RequestHandlerWebSocket::onTopicChanged, this, _topic, std::placeholders::_1));
+            topics.insert(std::make_pair(_topic, topic));
+
+            sender->queueFrame(_topic, frame);
+        }
+
+
+        void RequestHandlerWebSocket::unsubscribeTopic(const struct mg_connection *_conn, const std::string &_topic)
+        {
+            std::uint64_t subscriptionId = 0;
+
+            {
+                std::unique_lock<std::mutex> lock(mutexTopics);
+
+                auto it = topics.find(_topic);
+                if (it == topics.end())
+                    return;
+
+                auto &topicSenders = it->second.senders;
+                topicSenders.erase(std::remove_if(topicSenders.begin(), topicSenders.end(), [_conn](std::shared_ptr<WebSocketSender> _sender) { return _sender->getConnection() == _conn; }), topicSenders.end());
+
+                // if there is no client left for the topic we can remove the topic and its subscription
+                if (topicSenders.empty())
+                {
+                    subscriptionId = it->second.subscriptionId;
+                    topics.erase(it);
+                }
+            }
+
+            // the long poll manager may be calling 'onTopicChanged' right now, so we have to unsubscribe without holding the topic lock
+            if (subscriptionId)
+                getManagerEngineerServer()->getLongPollManager()->unsubscribe(subscriptionId);
+        }
+
+
+        void RequestHandlerWebSocket::onTopicChanged(const std::string &_topic, const std::string &_lastUpdateId)
+        {
+            std::shared_ptr<Request::RequestActionReturnableLongPolling> requestAction;
+            std::vector<std::shared_ptr<WebSocketSender>> topicSenders;
+
+            {
+                std::unique_lock<std::mutex> lock(mutexTopics);
+                auto it = topics.find(_topic);
+                if (it == topics.end())
+                    return;
+                requestAction = it->second.requestAction;
+            }
+
+            // the data will be created only once for all the clients which are subscribed to the topic. Only the watcher thread of the 
+            // long poll manager executes the request action of a subscribed topic, so we don't need the topic lock for this
+            if (!requestAction->executeActionLongPolling())
+            {
+                if (getLogObject())
+                    getLogObject()->error("Error while creating data for topic '" + _topic + "': " + requestAction->getErrors(), CURRENT_POSITION);
+                return;
+            }
+            auto frame = buildTopicFrame(_topic, _lastUpdateId, requestAction->getResponseData());
+
+            {
+                std::unique_lock<std::mutex> lock(mutexTopics);
+                auto it = topics.find(_topic);
+                if (it == topics.end() || it->second.requestAction != requestAction)
+                    return;
+                it->second.lastFrame = frame;
+                topicSenders = it->second.senders;
+            }
+
+            // the frame is written by the sender pool, so a slow client can't block the watcher
+            for (auto sender : topicSenders)
+            {
+                sender->queueFrame(_topic, frame);
+            }
+        }
+
+
+        std::shared_ptr<const std::string> RequestHandlerWebSocket::buildTopicFrame(const std::string &_topic, const std::string &_updateId, const std::string &_data)
+        {
+            rapidjson::StringBuffer jsonStringBuffer;
+            rapidjson::Writer<rapidjson::StringBuffer> jsonWriter(jsonStringBuffer);
+
+            jsonWriter.StartObject();
+            jsonWriter.Key("topic"); jsonWriter.String(_topic.c_str());
+            jsonWriter.Key("updateId"); jsonWriter.String(_updateId.c_str());
+            // the data is already json, so we add it as it is
+            jsonWriter.Key("data"); jsonWriter.RawValue(_data.c_str(), _data.length(), rapidjson::kArrayType);
+            jsonWriter.EndObject();
+
+            return std::make_shared<const std::string>(jsonStringBuffer.GetString());
+        }
+
+
+        void RequestHandlerWebSocket::sendError(struct mg_connection *_conn, const std::string &_error)
+        {
+            rapidjson::StringBuffer jsonStringBuffer;
+            rapidjson::Writer<rapidjson::StringBuffer> jsonWriter(jsonStringBuffer);
+
+            jsonWriter.StartObject();
+            jsonWriter.Key("msg"); jsonWriter.String(_error.c_str());
+            jsonWriter.Key("error"); jsonWriter.Bool(true);
+            jsonWriter.EndObject();
+
+            // errors are written by the sender too, so they will not be interleaved with the frames of the topics
+            getSender(_conn)->queueFrame("", std::make_shared<const std::string>(jsonStringBuffer.GetString()));
+        }
+
+
+        RequestHandlerEvents::RequestHandlerEvents() : RequestHandlerBase()
+        {
+            stopStreams = false;
+            runningStreams = 0;
+        }
+
+
+        bool RequestHandlerEvents::handleGet(CivetServer *_server, struct mg_connection *_conn)
+        {
+            if (!getManagerEngineerServer() || !getManagerEngineerServer()->isSystemReady())
+            {
+                sendResponse(_conn, "Raumfeld System is not ready to receive requests!", true);
+                return true;
+            }
+
+            const struct mg_request_info *request_info = mg_get_request_info(_conn);
+            auto queryOptions = Raumkernel::Tools::UriUtil::parseQueryString(request_info->query_string == nullptr ? "" : request_info->query_string);
+
+            // the topics are given as comma separated list (eg. topics=rendererState:Wohnzimmer,zoneConfig). if there are none we stream all data
+            std::string topicList = "rendererState,zoneConfig,zoneMediaList";
+            for (auto pair : queryOptions)
+            {
+                if (Raumkernel::Tools::StringUtil::tolower(pair.first) == "topics" && !pair.second.empty())
+                    topicList = pair.second;
+            }
+
+            // a client which reconnects will send the id of the last event it got. The id contains the update ids of all topics 
+            // the client got, so topics which still have this update id will not be sent again
+            auto lastEventIdHeader = mg_get_header(_conn, "Last-Event-ID");
+            auto sentUpdateIds = parseEventId(lastEventIdHeader == nullptr ? "" : lastEventIdHeader);
+
+            std::unique_lock<std::mutex> lock(mutexEvents);
+            if (stopStreams)
+                return false;
+            // the stream is registered before the topics are acquired, so stopping the handler can't remove the topics while we are using them
+            runningStreams++;
+            lock.unlock();
+
+            std::vector<std::string> streamTopics;
+            for (auto topic : Raumkernel::Tools::StringUtil::explodeString(topicList, ","))
+            {
+                if (topic.empty() || std::find(streamTopics.begin(), streamTopics.end(), topic) != streamTopics.end())
+                    continue;
+                // line breaks are not allowed because the topic will be written to the 'event:' line of the stream
+                if (topic.find_first_of("\r\n") != std::string::npos || !acquireTopic(topic))
+                {
+                    for (auto acquiredTopic : streamTopics)
+                        releaseTopic(acquiredTopic);
+                    lock.lock();
+                    runningStreams--;
+                    lock.unlock();
+                    condEvents.notify_all();
+                    sendResponse(_conn, "Topic '" + topic + "' is not valid!", true);
+                    return true;
+                }
+                streamTopics.push_back(topic);
+            }
+
+            mg_printf(_conn, "%s", std::string("HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\nCache-Control: no-cache\r\n" + buildCorsHeader() + "\r\nConnection: close\r\n\r\n").c_str());
+
+            // the counters of the events which were written to this stream
+            std::unordered_map<std::string, std::uint64_t> streamCounters;
+            // the topic, the update id and the text of the events which have to be written
+            std::vector<std::tuple<std::string, std::string, std::shared_ptr<const std::string>>> events;
+            bool streamOpen = true;
+
+            lock.lock();
+            for (auto topic : streamTopics)
+            {
+                auto &eventTopic = topics[topic];
+                streamCounters[topic] = eventTopic.eventCounter;
+                auto sentUpdateId = sentUpdateIds.find(topic);
+                if (sentUpdateId == sentUpdateIds.end() || sentUpdateId->second != eventTopic.lastUpdateId)
+                    events.push_back(std::make_tuple(topic, eventTopic.lastUpdateId, eventTopic.lastEvent));
+            }
+            // update ids of topics which are not in this stream are not part of the ids we send
+            for (auto it = sentUpdateIds.begin(); it != sentUpdateIds.end();)
+            {
+                if (std::find(streamTopics.begin(), streamTopics.end(), it->first) == streamTopics.end())
+                    it = sentUpdateIds.erase(it);
+                else
+                    it++;
+            }
+
+            while (streamOpen && !stopStreams)
+            {
+                // write the events without holding the lock so other streams and the topic updates are not blocked by a slow client
+                lock.unlock();
+                for (auto &event : events)
+                {
+                    if (!std::get<2>(event))
+                        continue;
+                    // the id is written after the data of each event, so it contains the update ids of all the data the client has got
+                    sentUpdateIds[std::get<0>(event)] = std::get<1>(event);
+                    if (!writeStream(_conn, *std::get<2>(event)) || !writeStream(_conn, "id: " + buildEventId(sentUpdateIds) + "\n\n"))
+                    {
+                        streamOpen = false;
+                        break;
+                    }
+                }
+                events.clear();
+                lock.lock();
+
+                if (!streamOpen)
+                    break;
+
+                auto hasNewEvents = [&]
+                {
+                    for (auto &pair : streamCounters)
+                    {
+                        if (topics[pair.first].eventCounter != pair.second)
+                            return true;
+                    }
+                    return false;
+                };
+
+                // if there was no event for some time we write a comment to keep proxies from closing the stream
+                // and to get noticed if the client has gone
+                if (!condEvents.wait_for(lock, std::chrono::seconds(15), [&] { return stopStreams || hasNewEvents(); }))
+                {
+                    lock.unlock();
+                    streamOpen = writeStream(_conn, ":\n\n");
+                    lock.lock();
+                    continue;
+                }
+
+                for (auto &pair : streamCounters)
+                {
+                    auto &eventTopic = topics[pair.first];
+                    if (eventTopic.eventCounter != pair.second)
+                    {
+                        pair.second = eventTopic.eventCounter;
+                        events.push_back(std::make_tuple(pair.first, eventTopic.lastUpdateId, eventTopic.lastEvent));
+                    }
+                }
+            }
+
+            lock.unlock();
+
+            for (auto topic : streamTopics)
+                releaseTopic(topic);
+
+            lock.lock();
+            runningStreams--;
+            lock.unlock();
+            condEvents.notify_all();
+
+            return true;
+        }
+
+
+        void RequestHandlerEvents::stop()
+        {
+            std::vector<std::uint64_t> subscriptionIds;
+
+            std::unique_lock<std::mutex> lock(mutexEvents);
+            stopStreams = true;
+            condEvents.notify_all();
+            condEvents.wait(lock, [this] { return runningStreams == 0; });
+
+            for (auto &pair : topics)
+                subscriptionIds.push_back(pair.second.subscriptionId);
+            topics.clear();
+            lock.unlock();
+
+            for (auto subscriptionId : subscriptionIds)
+                getManagerEngineerServer()->getLongPollManager()->unsubscribe(subscriptionId);
+        }
+
+
+        bool RequestHandlerEvents::acquireTopic(const std::string &_topic)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutexEvents);
+                auto it = topics.find(_topic);
+                if (it != topics.end())
+                {
+                    it->second.streamCount++;
+                    return true;
+                }
+            }
+
+            auto requestAction = createRequestActionForTopic(_topic);
+            if (!requestAction)
+                return false;
+
+            // the first data is created without holding the lock because the request action will lock the device and zone manager
+            // and the other streams would have to wait for it
+            EventStreamTopic eventTopic;
+            eventTopic.requestAction = requestAction;
+            eventTopic.lastUpdateId = requestAction->getLastUpdateId();
+            if (!requestAction->executeActionLongPolling())
+                return false;
+            eventTopic.lastEvent = buildEvent(_topic, requestAction->getResponseData());
+
+            std::unique_lock<std::mutex> lock(mutexEvents);
+
+            // another stream may have acquired the topic in the meantime, then we will use its topic and drop our request action
+            auto it = topics.find(_topic);
+            if (it != topics.end())
+            {
+                it->second.streamCount++;
+                return true;
+            }
+
+            eventTopic.eventCounter = 1;
+            eventTopic.streamCount = 1;
+            eventTopic.subscriptionId = getManagerEngineerServer()->getLongPollManager()->subscribe(requestAction, eventTopic.lastUpdateId, std::bind(&RequestHandlerEvents::onTopicChanged, this, _topic, std::placeholders::_1));
+            topics.insert(std::make_pair(_topic, eventTopic));
+
+            return true;
+        }
+
+
+        void RequestHandlerEvents::releaseTopic(const std::string &_topic)
+        {
+            std::uint64_t subscriptionId = 0;
+
+            {
+                std::unique_lock<std::mutex> lock(mutexEvents);
+
+                auto it = topics.find(_topic);
+                if (it == topics.end())
+                    return;
+
+                it->second.streamCount--;
+                if (!it->second.streamCount)
+                {
+                    subscriptionId = it->second.subscriptionId;
+                    topics.erase(it);
+                }
+            }
+
+            // the long poll manager may be calling 'onTopicChanged' right now, so we have to unsubscribe without holding the lock
+            if (subscriptionId)
+                getManagerEngineerServer()->getLongPollManager()->unsubscribe(subscriptionId);
+        }
+
+
+        void RequestHandlerEvents::onTopicChanged(const std::string &_topic, const std::string &_lastUpdateId)
+        {
+            std::shared_ptr<Request::RequestActionReturnableLongPolling> requestAction;
+
+            {
+                std::unique_lock<std::mutex> lock(mutexEvents);
+                auto it = topics.find(_topic);
+                if (it == topics.end())
+                    return;
+                requestAction = it->second.requestAction;
+            }
+
+            // the data will be created only once for all the streams of the topic. 
+            // The streams have to wait on the lock while doing this, so we create it unlocked
+            if (!requestAction->executeActionLongPolling())
+            {
+                if (getLogObject())
+                    getLogObject()->error("Error while creating data for topic '" + _topic + "': " + requestAction->getErrors(), CURRENT_POSITION);
+                return;
+            }
+            auto event = buildEvent(_topic, requestAction->getResponseData());
+
+            {
+                std::unique_lock<std::mutex> lock(mutexEvents);
+                auto it = topics.find(_topic);
+                if (it == topics.end() || it->second.requestAction != requestAction)
+                    return;
+                it->second.lastUpdateId = _lastUpdateId;
+                it->second.lastEvent = event;
+                it->second.eventCounter++;
+            }
+
+            condEvents.notify_all();
+        }
+
+
+        std::shared_ptr<const std::string> RequestHandlerEvents::buildEvent(const std::string &_topic, const std::string &_data)
+        {
+            // the json data does not contain any line breaks so we can put it into one data line. The event will be ended by the 
+            // id line of the stream
+            return std::shared_ptr<const std::string>(new std::string("event: " + _topic + "\ndata: " + _data + "\n"));
+        }
+
+
+        std::string RequestHandlerEvents::buildEventId(const std::map<std::string, std::string> &_updateIds)
+        {
+            std::string eventId;
+            for (auto &pair : _updateIds)
+            {
+                if (pair.second.empty())
+                    continue;
+                if (!eventId.empty())
+                    eventId += ",";
+                eventId += pair.first + "=" + pair.second;
+            }
+            return eventId;
+        }
+
+
+        std::map<std::string, std::string> RequestHandlerEvents::parseEventId(const std::string &_eventId)
+        {
+            std::map<std::string, std::string> updateIds;
+            for (auto part : Raumkernel::Tools::StringUtil::explodeString(_eventId, ","))
+            {
+                // the topics may contain a '=' (eg. in the name of a zone) but the update ids don't
+                auto pos = part.rfind('=');
+                if (pos == std::string::npos || pos == 0)
+                    continue;
+                updateIds[part.substr(0, pos)] = part.substr(pos + 1);
+            }
+            return updateIds;
+        }
+
+
+        bool RequestHandlerEvents::writeStream(struct mg_connection *_conn, const std::string &_data)
+        {
+            return mg_write(_conn, _data.c_str(), _data.length()) > 0;
+        }
+
     }
-}
\ No newline at end of file
+}